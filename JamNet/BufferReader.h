@@ -69,7 +69,7 @@ namespace jam::net
 		uint32	m_pos = 0;
 	};
 
-	// --- Endian ȯ Լ (Big Endian ) ---
+	// --- Endian 변환 함수 (Big Endian 기준) ---
 	inline uint16 FromBigEndian(uint16 v)
 	{
 		return (v >> 8) | (v << 8);
@@ -98,7 +98,7 @@ namespace jam::net
 	template<typename T>
 	inline T FromBigEndian(const T& v)
 	{
-		// ⺻ ܿ ״ ȯ
+		// 기본형 외에는 그대로 반환
 		return v;
 	}
 }
@@ -23,7 +23,7 @@ namespace jam::net
 			if (FreeSize() < sizeof(T))
 				return false;
 
-			T temp = ToBigEndian(value); // endian ȯ
+			T temp = ToBigEndian(value); // endian 변환
 			std::memcpy(&m_buffer[m_pos], &temp, sizeof(T));
 			m_pos += sizeof(T);
 			return true;
@@ -63,7 +63,7 @@ namespace jam::net
 		uint32		m_pos = 0;
 	};
 
-	// ⺻ Endian ȯ Լ (big endian )
+	// 기본 Endian 변환 함수 (big endian 사용)
 	inline uint16_t ToBigEndian(uint16_t v)
 	{
 		return (v >> 8) | (v << 8);
@@ -89,7 +89,7 @@ namespace jam::net
 			((v & 0xFF00000000000000ULL) >> 56);
 	}
 
-	// ⺻ ܿ ״ ȯ
+	// 기본형 외에는 그대로 반환
 	template<typename T>
 	inline T ToBigEndian(const T& v)
 	{
@@ -53,14 +53,14 @@ namespace jam::net
 //		uint16 currentSeq = analysis.GetSequence();
 //		uint16& latestSeq = m_channelLatestSequences[E2U(channel)];
 //
-//		//  ȣ   
+//		// 시퀀스 번호 래핑 고려한 비교
 //		if (bool isNewer = static_cast<int16>(currentSeq - latestSeq) > 0)
 //		{
 //			latestSeq = currentSeq;
 //			return true;
 //		}
 //
-//		return false; //  Ŷ
+//		return false; // 오래된 패킷
 //	}
 //
 //	bool ChannelManager::ProcessOrderedChannel(const PacketAnalysis& analysis, BYTE* payload, uint32 payloadSize)
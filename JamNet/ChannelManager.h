@@ -52,11 +52,11 @@ namespace jam::net
 	//private:
 	//	UdpSession* m_owner = nullptr;
 
-	//	// äκ  
-	//	std::array<uint16, 4> m_channelLatestSequences{ 0 };     //  äο
-	//	std::array<uint16, 4> m_channelExpectedSequences{ 1 };   //   äο
+	//	// 채널별 상태 관리
+	//	std::array<uint16, 4> m_channelLatestSequences{ 0 };     // 시퀀스드 채널용
+	//	std::array<uint16, 4> m_channelExpectedSequences{ 1 };   // 순서 보장 채널용
 
-	//	//    
+	//	// 순서 보장을 위한 버퍼
 	//	std::array<std::map<uint16, std::pair<std::vector<BYTE>, PacketAnalysis>>, 4> m_orderingBuffers;
 
 	//	static constexpr uint64 ORDERED_BUFFER_TIMEOUT = 100;
@@ -1,11 +1,12 @@
 #pragma once
 #include "pch.h"
 #include "EcsHandle.h"
+#include "EcsEventBus.hpp"
 
 
 namespace jam::net::ecs
 {
-    //   ä ( 4 )
+    // 구성 가능한 채널 수(고정 4 가정)
     constexpr uint32 CHANNEL_COUNT = 4;
 
     //static constexpr uint64 ORDERED_BUFFER_TIMEOUT = 100;
@@ -29,8 +30,8 @@ namespace jam::net::ecs
 
     struct CompChannel
     {
-        std::array<uint16, CHANNEL_COUNT> latestSeqs{ 0 };   // Sequenced ֽ  seq
-        std::array<uint16, CHANNEL_COUNT> expectedSeqs{ 1 }; // Ordered   seq
+        std::array<uint16, CHANNEL_COUNT> latestSeqs{ 0 };   // Sequenced 최신 수신 seq
+        std::array<uint16, CHANNEL_COUNT> expectedSeqs{ 1 }; // Ordered 다음 기대 seq
         EcsHandle                         hStore = EcsHandle::invalid();
     };
 
@@ -45,7 +46,7 @@ namespace jam::net::ecs
     {
         std::array<std::map<uint16, OrderedBufferedPacket>, CHANNEL_COUNT> buffers;
 
-        // ŸӾƿ (: 30ms)  䱸 ° 
+        // 타임아웃 (예: 30ms) 실제 요구에 맞게 조정
         static constexpr uint64 ORDERED_BUFFER_TIMEOUT_NS = 3'000'000_ns;
         static constexpr int16  MAX_SEQUENCE_GAP = 100;
     };
@@ -76,7 +77,7 @@ namespace jam::net::ecs
             const eChannelType ch  = ev.analysis.GetChannel();
             const uint32 idx       = E2U(ch);
 
-            // Sequenced: ֽŰ ϰ  Ŷ 
+            // Sequenced: 최신값만 갱신하고 과거 패킷 폐기
             if (IsSequenced(ch))
             {
                 uint16 cur    = ev.analysis.GetSequence();
@@ -84,34 +85,34 @@ namespace jam::net::ecs
                 if (static_cast<int16>(cur - latest) > 0)
                     latest = cur;
                 else
-                    return; // /ߺ  
+                    return; // 과거/중복 → 폐기
             }
 
-            // Ordered ƴ     (ʿ  ⼭ ٷ ǿ )
+            // Ordered 아닌 경우 즉시 상위 전달 (필요 시 여기서 바로 세션에 전달)
             if (!IsOrdered(ch))
             {
                 // ep.owner->ProcessBufferedPacket(ev.analysis, ev.payload, ev.payloadSize);
                 return;
             }
 
-            // Ordered ó
+            // Ordered 처리
             uint16 cur = ev.analysis.GetSequence();
             uint16& expected = cc.expectedSeqs[idx];
 
             if (cur == expected)
             {
                 ++expected;
-                // ̾ ӵ  ó
+                // 뒤이어 연속된 버퍼 처리
                 ProcessBuffered(cc, *store, ep.owner, ch);
             }
             else if (static_cast<int16>(cur - expected) > 0)
             {
-                // ̷ seq  ۸
+                // 미래 seq → 버퍼링
                 BufferOrdered(*store, ev.analysis, ev.payload, ev.payloadSize);
             }
             else
             {
-                //   
+                // 과거 → 폐기
             }
         }
 
@@ -128,7 +129,7 @@ namespace jam::net::ecs
             const uint32 maxBuf = CHANNEL_CONFIGS[idx].maxQueueSize;
             if (st.buffers[idx].size() > maxBuf)
             {
-                //     (map ù )
+                // 가장 오래된 것 제거 (map 첫 요소)
                 st.buffers[idx].erase(st.buffers[idx].begin());
             }
         }
@@ -152,22 +153,23 @@ namespace jam::net::ecs
         }
     };
 
+    constexpr auto EventRoute(std::type_identity<EvChRecv>) { return &ChannelHandlers::OnRecv; }
+
     struct ChannelSinks
     {
         bool                    wired = false;
-        entt::scoped_connection onRecv;
         ChannelHandlers         handlers;
     };
 
     inline void ChannelWiringSystem(utils::exec::ShardLocal& L, uint64, uint64)
     {
         auto& R = L.world;
-    	auto& D = L.events;
+    	auto& D = NetEvents(L);
         auto& sinks = R.ctx().emplace<ChannelSinks>();
         if (sinks.wired) return;
         sinks.handlers.R = &R;
 
-        sinks.onRecv = D.sink<EvChRecv>().connect<&ChannelHandlers::OnRecv>(&sinks.handlers);
+        D.Bind<EvChRecv>(&sinks.handlers);
 
     	sinks.wired = true;
     }
@@ -191,14 +193,14 @@ namespace jam::net::ecs
                 auto& buf = st->buffers[i];
                 if (buf.empty()) continue;
 
-                // ŸӾƿ ˻(   ð )
+                // 타임아웃 검사(가장 오래된 도착 시간 사용)
                 auto oldestIt = buf.begin();
                 uint64 arrival_ns = oldestIt->second.arrival_ns;
                 uint64 elapsed = now_ns - arrival_ns;
 
                 if (elapsed >= ChannelStore::ORDERED_BUFFER_TIMEOUT_NS)
                 {
-                    //   ó
+                    // 강제 전진 처리
                     uint64 processed = 0;
                     const uint64 MAX_PROCESS_ON_TIMEOUT = 10;
                     auto& expected = cc.expectedSeqs[i];
@@ -208,7 +210,7 @@ namespace jam::net::ecs
                         auto next = buf.begin();
                         uint16 seq = next->first;
 
-                        // gap ʹ ũ expected ̵(ǳʶٱ)
+                        // gap 너무 크면 expected 이동(건너뛰기)
                         if (static_cast<int16>(seq - expected) > ChannelStore::MAX_SEQUENCE_GAP)
                         {
                             expected = static_cast<uint16>(seq + 1);
@@ -16,12 +16,18 @@ namespace jam::net::ecs
 
 	struct MailboxRef
 	{
-		std::shared_ptr<utils::exec::Mailbox> norm;
-		std::shared_ptr<utils::exec::Mailbox> ctrl;
+		std::shared_ptr<utils::exec::Mailbox> mailbox;		// CTRL + NORMAL lanes
 	};
 
 	struct CompEndpoint
 	{
 		UdpSession* owner;
 	};
+
+	// the key the application named the session with (Session::RebindRouteKey, after auth).
+	// Routing stays on the key the mailbox was created with; this one outlives the process in snapshots.
+	struct SessionKey
+	{
+		uint64 value = 0;
+	};
 }
@@ -1,5 +1,6 @@
 ﻿#pragma once
 #include "pch.h"
+#include "EcsEventBus.hpp"
 
 namespace jam::net::ecs
 {
@@ -75,27 +76,28 @@ namespace jam::net::ecs
         }
     };
 
+    constexpr auto EventRoute(std::type_identity<EvCCRecvAck>)     { return &CongestionHandlers::OnRecvAck; }
+    constexpr auto EventRoute(std::type_identity<EvCCPacketLoss>)  { return &CongestionHandlers::OnPacketLoss; }
+    constexpr auto EventRoute(std::type_identity<EvCCNewAck>)      { return &CongestionHandlers::OnNewAck; }
+    constexpr auto EventRoute(std::type_identity<EvCCFastRTX>)     { return &CongestionHandlers::OnFastRTX; }
+
     struct CongestionSinks
     {
         bool                    wired = false;
-        entt::scoped_connection onRecvAck;
-        entt::scoped_connection onPktLoss;
-        entt::scoped_connection onFastRTX;
-        entt::scoped_connection onNewACK;
         CongestionHandlers      handlers;
     };
 
     inline void CongestionControlWiringSystem(utils::exec::ShardLocal& L, uint64, uint64)
     {
-        auto& R = L.world; auto& D = L.events;
+        auto& R = L.world; auto& D = NetEvents(L);
         auto& s = R.ctx().emplace<CongestionSinks>();
         if (s.wired) return;
         s.handlers.R = &R;
 
-        s.onRecvAck = D.sink<EvCCRecvAck>().connect<&CongestionHandlers::OnRecvAck>(&s.handlers);
-        s.onPktLoss = D.sink<EvCCPacketLoss>().connect<&CongestionHandlers::OnPacketLoss>(&s.handlers);
-        s.onNewACK  = D.sink<EvCCNewAck>().connect<&CongestionHandlers::OnNewAck>(&s.handlers);
-        s.onFastRTX = D.sink<EvCCFastRTX>().connect<&CongestionHandlers::OnFastRTX>(&s.handlers);
+        D.Bind<EvCCRecvAck>(&s.handlers);
+        D.Bind<EvCCPacketLoss>(&s.handlers);
+        D.Bind<EvCCNewAck>(&s.handlers);
+        D.Bind<EvCCFastRTX>(&s.handlers);
 
         s.wired = true;
     }
@@ -0,0 +1,76 @@
+#pragma once
+#include "pch.h"
+
+namespace jam::net::ecs
+{
+    // fwd : defined by their modules, each of which also declares EventRoute() for its events
+
+    struct EvHsConnect;
+    struct EvHsDisconnect;
+    struct EvHsRecv;
+
+    struct EvChRecv;
+
+    struct EvFgFragmentize;
+    struct EvFgReassemble;
+
+    struct EvReSendR;
+    struct EvReRecvR;
+    struct EvReRecvACK;
+    struct EvReRecvNACK;
+
+    struct EvTxEnqueue;
+    struct EvTxFlush;
+
+    struct EvGpJoin;
+    struct EvGpLeave;
+    struct EvGpPostSend;
+    struct EvGpPostSendLocal;
+
+    struct EvCCRecvAck;
+    struct EvCCPacketLoss;
+    struct EvCCNewAck;
+    struct EvCCFastRTX;
+
+    struct EvNsOnSend;
+    struct EvNsOnRecv;
+    struct EvNsOnSendR;
+    struct EvNsOnRecvR;
+    struct EvNsOnPacketLoss;
+    struct EvNsOnPiggyAck;
+    struct EvNsOnImmAck;
+    struct EvNsOnDelayedAck;
+    struct EvNsOnRTO;
+    struct EvNsOnFastRTX;
+    struct EvNsChOnSend;
+    struct EvNsChOnRecv;
+    struct EvNsChOnDrop;
+    struct EvNsChOnLoss;
+    struct EvNsChOnBuffered;
+    struct EvNsChOnReordered;
+
+    // Drain order = list order: a stage sees what earlier stages posted in the same pass
+    // (handshake/channel -> fragment -> reliability -> transport), stats are folded last.
+    using NetEventBus = utils::exec::EventBus<
+        EvHsConnect, EvHsDisconnect, EvHsRecv,
+        EvChRecv,
+        EvFgReassemble, EvFgFragmentize,
+        EvReRecvR, EvReRecvACK, EvReRecvNACK, EvReSendR,
+        EvGpJoin, EvGpLeave, EvGpPostSend, EvGpPostSendLocal,
+        EvTxEnqueue, EvTxFlush,
+        EvCCRecvAck, EvCCNewAck, EvCCPacketLoss, EvCCFastRTX,
+        EvNsOnSend, EvNsOnRecv, EvNsOnSendR, EvNsOnRecvR, EvNsOnPacketLoss,
+        EvNsOnPiggyAck, EvNsOnImmAck, EvNsOnDelayedAck, EvNsOnRTO, EvNsOnFastRTX,
+        EvNsChOnSend, EvNsChOnRecv, EvNsChOnDrop, EvNsChOnLoss, EvNsChOnBuffered, EvNsChOnReordered>;
+
+    // installed by RegisterNetEcs
+    inline NetEventBus& NetEvents(utils::exec::ShardLocal& L)
+    {
+        return L.events.Get<NetEventBus>();
+    }
+
+    inline NetEventBus& NetEvents(entt::registry& R)
+    {
+        return *R.ctx().get<NetEventBus*>();
+    }
+}
@@ -3,6 +3,7 @@
 #include "pch.h"
 
 #include "EcsHandle.h"
+#include "EcsEventBus.hpp"
 #include "EcsReliability.hpp"
 //#include "EcsTransport.hpp"
 #include "FragmentManager.h"
@@ -32,7 +33,7 @@ namespace jam::net::ecs
 	struct EvFgFragmentize
 	{
         entt::entity        e{ entt::null };
-        Sptr<SendBuffer>    buf;
+        SendBufferRef       buf;
         PacketAnalysis      analysis;
 	};
 
@@ -54,7 +55,7 @@ namespace jam::net::ecs
             auto& R = L.world;
 
 
-            xvector<Sptr<SendBuffer>> fragments;
+            xvector<SendBufferRef> fragments;
 
             if (!ev.buf || ev.analysis.payloadSize == 0) 
                 return;
@@ -89,10 +90,8 @@ namespace jam::net::ecs
 
             for (auto& frag : fragments) 
             {
-                auto& R = SHARD_LOCAL_CHECKED();
-                auto& D = R.events;
-
-                D.enqueue<EvTxEnqueue>(EvTxEnqueue{ ev.e, frag, eTxReason::NORMAL, frag->WriteSize() });
+                auto& L = SHARD_LOCAL_CHECKED();
+                NetEvents(L).Post(EvTxEnqueue{ ev.e, frag, eTxReason::NORMAL, frag->WriteSize() });
             }
         }
 
@@ -118,7 +117,7 @@ namespace jam::net::ecs
             uint32 psize = an.payloadSize;
 
             // lazy
-            uint64 now = utils::Clock::Instance().NowNs();
+            uint64 now = utils::Clock::Instance().LoopNowNs();
             {
                 xvector<uint16> stale;
                 for (auto& [k, re] : st->reassemblies)
@@ -167,29 +166,28 @@ namespace jam::net::ecs
         }
     };
 
+    constexpr auto EventRoute(std::type_identity<EvFgFragmentize>) { return &FragmentHandlers::Fragmentize; }
+    constexpr auto EventRoute(std::type_identity<EvFgReassemble>)  { return &FragmentHandlers::Reassemble; }
+
     // Sinks
 
     struct FragmentSinks
 	{
         bool                        wired = false;
-
-    	entt::scoped_connection     onFragmentize;
-        entt::scoped_connection     onReassemble;
-
         FragmentHandlers            handlers;
     };
 
 	// Systems
-    // todo:  ڿ ShardLocal  ֵ ǳ?
+    // todo: 여기 인자에서도 ShardLocal 을 없애도 되나?
     inline void FragmentWiringSystem(utils::exec::ShardLocal& L, uint64, uint64)
 	{
         auto& R = L.world;
-    	auto& D = L.events;
+    	auto& D = NetEvents(L);
         auto& sinks = R.ctx().emplace<FragmentSinks>();
     	if (sinks.wired) return;
 
-        sinks.onFragmentize     = D.sink<EvFgFragmentize>().connect<&FragmentHandlers::Fragmentize>(&sinks.handlers);
-        sinks.onReassemble      = D.sink<EvFgReassemble>().connect<&FragmentHandlers::Reassemble>(&sinks.handlers);
+        D.Bind<EvFgFragmentize>(&sinks.handlers);
+        D.Bind<EvFgReassemble>(&sinks.handlers);
 
         sinks.wired = true;
     }
@@ -4,6 +4,8 @@
 #include "EcsTransportAPI.hpp"   
 #include "RoutingPolicy.h"
 #include "PacketBuilder.h"       
+#include "ShardTLS.h"
+#include "EcsEventBus.hpp"
 
 namespace jam::net::ecs
 {
@@ -12,7 +14,7 @@ namespace jam::net::ecs
         jam::utils::exec::RoutingPolicy* routing = nullptr;
     };
 
-    //   ׷ ε
+    // 샤드 로컬 그룹 인덱스
     struct GroupIndex
     {
         std::unordered_map<uint64, xvector<entt::entity>> members;
@@ -35,28 +37,28 @@ namespace jam::net::ecs
         uint64          groupId{};
     };
 
-    // ƼĳƮ û(ȣ 忡 )
+    // 멀티캐스트 요청(호출자 샤드에서 실행)
     struct EvGpPostSend
     {
         entt::entity     e{ entt::null };
         uint64           groupId{};
-        Sptr<SendBuffer> buf;
+        SendBufferRef buf;
         eTxReason        reason{ eTxReason::NORMAL };
     };
 
-    //   ƼĳƮ ó ̺Ʈ( 忡 )
+    // 샤드 로컬 멀티캐스트 처리 이벤트(각 샤드에서 수신)
     struct EvGpPostSendLocal
     {
         uint64           groupId{};
-        Sptr<SendBuffer> buf;     //  ø( ڸ )
+        SendBufferRef buf;     // 원본 템플릿(각 수신자마다 복제)
         eTxReason        reason{ eTxReason::NORMAL };
     };
 
-    inline Sptr<SendBuffer> CloneSendBuffer(const Sptr<SendBuffer>& src)
+    inline SendBufferRef CloneSendBuffer(const SendBufferRef& src)
     {
         if (!src || !src->Buffer()) return {};
         const uint32 sz = src->WriteSize();
-        auto dup = jam::utils::memory::MakeShared<SendBuffer>(sz);
+        SendBufferRef dup = SendBufferManager::Instance().Open(sz);
         ::memcpy(dup->Buffer(), src->Buffer(), sz);
         dup->Close(sz);
         return dup;
@@ -106,23 +108,24 @@ namespace jam::net::ecs
             }
         }
 
-        //  忡 ȣ  ׷Ȩ Ͽ   
+        // 원본 샤드에서 호출 → 그룹홈 경유하여 각 샤드로 전파
         void OnPostSend(const EvGpPostSend& ev)
         {
             auto& ep = R->get<CompEndpoint>(ev.e);
             if (!ep.owner || !ev.buf || !ev.buf->Buffer()) return;
             const auto gk = HomeKey(ev.groupId);
 
-            //   Mailbox  Job: Local ̺Ʈ enqueue
+            // 각 샤드 Mailbox에서 실행될 Job: Local 이벤트 enqueue
             auto buf = ev.buf;
             auto reason = ev.reason;
             auto gid = ev.groupId;
-            ep.owner->PostGroup(gid, gk, jam::utils::job::Job([&reg = *R, gid, buf, reason]() mutable {
-                reg.ctx().get<entt::dispatcher>().enqueue<EvGpPostSendLocal>(EvGpPostSendLocal{ gid, buf, reason });
+            ep.owner->PostGroup(gid, gk, jam::utils::job::Job([gid, buf, reason]() mutable {
+                // runs on the member's shard: post to that shard's bus
+                NetEvents(utils::exec::ShardTLS::GetCurrentChecked()).Post(EvGpPostSendLocal{ gid, buf, reason });
             }));
         }
 
-        //  :   ƼƼ ȸ  EnqueueSend
+        // 샤드 로컬: 실제 멤버 엔티티 순회 → EnqueueSend
         void OnPostSendLocal(const EvGpPostSendLocal& ev)
         {
             if (auto* gi = R->ctx().find<GroupIndex>())
@@ -134,7 +137,7 @@ namespace jam::net::ecs
 
                 for (auto target : it->second)
                 {
-                    auto dup = CloneSendBuffer(ev.buf); //  󸶴 
+                    auto dup = CloneSendBuffer(ev.buf); // 각 대상마다 복제
                     if (!dup) continue;
                     EnqueueSend(*R, target, dup, ev.reason);
                 }
@@ -142,30 +145,31 @@ namespace jam::net::ecs
         }
     };
 
+    constexpr auto EventRoute(std::type_identity<EvGpJoin>)            { return &GroupHandlers::OnJoin; }
+    constexpr auto EventRoute(std::type_identity<EvGpLeave>)           { return &GroupHandlers::OnLeave; }
+    constexpr auto EventRoute(std::type_identity<EvGpPostSend>)        { return &GroupHandlers::OnPostSend; }
+    constexpr auto EventRoute(std::type_identity<EvGpPostSendLocal>)   { return &GroupHandlers::OnPostSendLocal; }
+
     struct GroupSinks
     {
         bool                    wired = false;
-        entt::scoped_connection onJoin;
-        entt::scoped_connection onLeave;
-        entt::scoped_connection onPostSend;
-        entt::scoped_connection onPostSendLocal;
         GroupHandlers           handlers;
     };
 
     inline void GroupWiringSystem(jam::utils::exec::ShardLocal& L, uint64, uint64)
     {
         auto& R = L.world;
-    	auto& D = L.events;
+    	auto& D = NetEvents(L);
         auto& s = R.ctx().emplace<GroupSinks>();
         if (s.wired) return;
         s.handlers.R = &R;
 
-    	R.ctx().emplace<GroupIndex>();  // todo: ⼭ R.ctx  ϴ° ´°?
+    	R.ctx().emplace<GroupIndex>();  // todo: 여기서 R.ctx 에 주입하는게 맞는가?
 
-        s.onJoin            = D.sink<EvGpJoin>().connect<&GroupHandlers::OnJoin>(&s.handlers);
-        s.onLeave           = D.sink<EvGpLeave>().connect<&GroupHandlers::OnLeave>(&s.handlers);
-        s.onPostSend        = D.sink<EvGpPostSend>().connect<&GroupHandlers::OnPostSend>(&s.handlers);
-        s.onPostSendLocal   = D.sink<EvGpPostSendLocal>().connect<&GroupHandlers::OnPostSendLocal>(&s.handlers);
+        D.Bind<EvGpJoin>(&s.handlers);
+        D.Bind<EvGpLeave>(&s.handlers);
+        D.Bind<EvGpPostSend>(&s.handlers);
+        D.Bind<EvGpPostSendLocal>(&s.handlers);
 
         s.wired = true;
     }
@@ -50,7 +50,7 @@ namespace jam::net::ecs
 			sl.gen++;
 			sl.nextFree = m_freeHead;
 			m_freeHead = h.idx;
-			sl.val = T{}; // ʿ 
+			sl.val = T{}; // 필요시 정리
 		}
 
 		bool isAlive(EcsHandle h) const
@@ -3,6 +3,7 @@
 #include "pch.h"
 
 #include "EcsTransportAPI.hpp"
+#include "EcsEventBus.hpp"
 
 
 namespace jam::net::ecs
@@ -10,13 +11,13 @@ namespace jam::net::ecs
     // fwd
 	struct CompEndpoint;
 
-    //	 (ɵ ) :
+    //	정상 종료(능동 종료측) :
     //	CONNECTED->FIN_SENT->FINACK_RECEIVED->TIME_WAIT->DISCONNECTED
     
-    //	 ( ) :
+    //	정상 종료(수동 종료측) :
     //	CONNECTED->FIN_RECEIVED->FINACK_SENT->DISCONNECTED
     
-    //	  :
+    //	동시 종료 :
     //	CONNECTED->FIN_SENT->CLOSING->TIME_WAIT->DISCONNECTED
 
 
@@ -104,7 +105,7 @@ namespace jam::net::ecs
             if (hs.state == eHandshakeState::DISCONNECTED) 
                 hs.state = eHandshakeState::CONNECT_SYN_SENT;
 
-            hs.lastHsTime_ns = utils::Clock::Instance().NowNs();
+            hs.lastHsTime_ns = utils::Clock::Instance().LoopNowNs();
         }
 
         void OnRecv(const EvHsRecv& ev)
@@ -117,15 +118,15 @@ namespace jam::net::ecs
                 hs.state = eHandshakeState::CONNECT_SYN_RECEIVED;
                 Send(ev.e, eSystemPacketId::CONNECT_SYNACK);
                 hs.state = eHandshakeState::CONNECT_SYNACK_SENT;
-                hs.lastHsTime_ns = utils::Clock::Instance().NowNs();
+                hs.lastHsTime_ns = utils::Clock::Instance().LoopNowNs();
                 break;
             case eSystemPacketId::CONNECT_SYNACK:
                 if (hs.state != eHandshakeState::CONNECT_SYN_SENT) return;
                 hs.state = eHandshakeState::CONNECT_SYNACK_RECEIVED;
                 Send(ev.e, eSystemPacketId::CONNECT_ACK);
                 hs.state = eHandshakeState::CONNECTED;
-                hs.lastHsTime_ns = utils::Clock::Instance().NowNs();
-                // ep.owner->OnLinkEstablished(); // ʿ  ̺Ʈ/ݹ  //todo
+                hs.lastHsTime_ns = utils::Clock::Instance().LoopNowNs();
+                // ep.owner->OnLinkEstablished(); // 필요 시 이벤트/콜백으로  //todo
                 break;
             case eSystemPacketId::CONNECT_ACK:
                 if (hs.state != eHandshakeState::CONNECT_SYNACK_SENT) return;
@@ -151,7 +152,7 @@ namespace jam::net::ecs
                     break;
                 default: break;
                 }
-                hs.lastHsTime_ns = utils::Clock::Instance().NowNs();
+                hs.lastHsTime_ns = utils::Clock::Instance().LoopNowNs();
             } break;
 
             case eSystemPacketId::DISCONNECT_FINACK:
@@ -162,16 +163,16 @@ namespace jam::net::ecs
                     hs.state = eHandshakeState::DISCONNECT_FINACK_RECEIVED;
                     Send(ev.e, eSystemPacketId::DISCONNECT_ACK);
                     hs.state = eHandshakeState::TIME_WAIT;
-                    hs.timeWaitStart_ns = utils::Clock::Instance().NowNs();
+                    hs.timeWaitStart_ns = utils::Clock::Instance().LoopNowNs();
                     break;
                 case eHandshakeState::CLOSING:
                     Send(ev.e, eSystemPacketId::DISCONNECT_ACK);
                     hs.state = eHandshakeState::TIME_WAIT;
-                    hs.timeWaitStart_ns = utils::Clock::Instance().NowNs();
+                    hs.timeWaitStart_ns = utils::Clock::Instance().LoopNowNs();
                     break;
                 default: break;
                 }
-                hs.lastHsTime_ns = utils::Clock::Instance().NowNs();
+                hs.lastHsTime_ns = utils::Clock::Instance().LoopNowNs();
             } break;
 
             case eSystemPacketId::DISCONNECT_ACK:
@@ -182,7 +183,7 @@ namespace jam::net::ecs
                 }
                 else if (hs.state == eHandshakeState::TIME_WAIT) 
                 {
-                    // ߺ ACK 
+                    // 중복 ACK 무시
                 }
                 break;
 
@@ -201,19 +202,21 @@ namespace jam::net::ecs
             if (hs.state == eHandshakeState::CONNECTED) 
                 hs.state = eHandshakeState::DISCONNECT_FIN_SENT;
 
-            hs.lastHsTime_ns = utils::Clock::Instance().NowNs();
+            hs.lastHsTime_ns = utils::Clock::Instance().LoopNowNs();
         }
     };
 
 
+    constexpr auto EventRoute(std::type_identity<EvHsConnect>)     { return &HandshakeHandlers::OnConnect; }
+    constexpr auto EventRoute(std::type_identity<EvHsDisconnect>)  { return &HandshakeHandlers::OnDisconnect; }
+    constexpr auto EventRoute(std::type_identity<EvHsRecv>)        { return &HandshakeHandlers::OnRecv; }
+
+
 	// Sinks
 
     struct HandshakeSinks
 	{
         bool                        wired = false;
-        entt::scoped_connection     onConnect;
-        entt::scoped_connection     onDisonnect;
-        entt::scoped_connection     onRecv;
         HandshakeHandlers           handlers;
     };
 
@@ -222,14 +225,14 @@ namespace jam::net::ecs
 
     inline void HandshakeWiringSystem(utils::exec::ShardLocal& L, uint64, uint64)
 	{
-        auto& R = L.world; auto& D = L.events;
+        auto& R = L.world; auto& D = NetEvents(L);
         auto& sinks = R.ctx().emplace<HandshakeSinks>();
     	if (sinks.wired) return;
     	sinks.handlers.R = &R;
 
-        sinks.onConnect        = D.sink<EvHsConnect>().connect<&HandshakeHandlers::OnConnect>(&sinks.handlers);
-        sinks.onDisonnect      = D.sink<EvHsDisconnect>().connect<&HandshakeHandlers::OnDisconnect>(&sinks.handlers);
-    	sinks.onRecv           = D.sink<EvHsRecv>().connect<&HandshakeHandlers::OnRecv>(&sinks.handlers);
+        D.Bind<EvHsConnect>(&sinks.handlers);
+        D.Bind<EvHsDisconnect>(&sinks.handlers);
+        D.Bind<EvHsRecv>(&sinks.handlers);
 
         sinks.wired = true;
     }
@@ -237,7 +240,7 @@ namespace jam::net::ecs
     inline void HandshakeTickSystem(utils::exec::ShardLocal& L, uint64, uint64)
 	{
         auto& R = L.world;
-        uint64 now_ns = utils::Clock::Instance().NowNs();
+        uint64 now_ns = utils::Clock::Instance().LoopNowNs();
         auto view = R.view<CompHandshake, CompEndpoint>();
         for (auto e : view) {
             auto& hs = view.get<CompHandshake>(e);
@@ -263,7 +266,7 @@ namespace jam::net::ecs
                     else 
                     {
                         ++hs.retryCount;
-                        //  ¿ ´ 
+                        // 현재 상태에 맞는 재전송
                         if (hs.state == eHandshakeState::CONNECT_SYN_SENT)       HandshakeHandlers{ &R }.Send(e, eSystemPacketId::CONNECT_SYN);
                         else if (hs.state == eHandshakeState::CONNECT_SYNACK_SENT)HandshakeHandlers{ &R }.Send(e, eSystemPacketId::CONNECT_SYNACK);
                         else if (hs.state == eHandshakeState::DISCONNECT_FIN_SENT)HandshakeHandlers{ &R }.Send(e, eSystemPacketId::DISCONNECT_FIN);
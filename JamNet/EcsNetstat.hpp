@@ -1,37 +1,39 @@
 #pragma once
 #include "pch.h"
+#include "EcsEventBus.hpp"
 
 namespace jam::net::ecs
 {
-	// ä  (Channel / Packet ǿ ġϵ )
+	// 채널 개수 (Channel / Packet 정의와 일치하도록 유지)
 	constexpr uint32 NET_MAX_CHANNELS = 4;
+	constexpr size_t NETSTAT_TICK_CHUNK = 1024;		// entities per parallel chunk
 
-	// ä ( ChannelStat  : NetStatManager )
+	// 채널 통계(기존 ChannelStat 재정의 : NetStatManager 제거)
 	struct ChannelStat
 	{
 		uint64 totalSent = 0;
 		uint64 totalRecv = 0;
 		uint64 totalLost = 0;        // reliable
-		uint64 totalDropped = 0;     // sequenced  Ŷ 
-		uint64 totalBuffered = 0;    // ordered  
-		uint64 totalReordered = 0;   // ordered  flush ó 
+		uint64 totalDropped = 0;     // sequenced 오래된 패킷 폐기
+		uint64 totalBuffered = 0;    // ordered 버퍼 적재
+		uint64 totalReordered = 0;   // ordered 버퍼 flush 처리된 개수
 		uint64 averageBufferDelay_ns = 0;
-		float  utilization = 0.0f;   // (ä ۽ 뿪 / ü ۽ 뿪)
+		float  utilization = 0.0f;   // (채널 송신 대역폭 / 전체 송신 대역폭)
 	};
 
 	struct ChannelRuntime
 	{
 		ChannelStat stat;
-		uint64 bwSendAccum = 0;          // ƽ  ۽ bytes
-		uint64 bwRecvAccum = 0;          // ƽ   bytes
+		uint64 bwSendAccum = 0;          // 틱 동안 송신 bytes
+		uint64 bwRecvAccum = 0;          // 틱 동안 수신 bytes
 		uint64 bufferDelayAccum_ns = 0;
 		uint64 bufferedPackets = 0;
 	};
 
-	//   Ʈũ  Ʈ ( )
+	// 세션 단위 네트워크 통계 컴포넌트 (단일 권위)
 	struct CompNetstat
 	{
-		// ----- ⺻  -----
+		// ----- 기본 누적 -----
 		uint64 totalSent = 0;
 		uint64 totalRecv = 0;
 		uint64 totalLost = 0;
@@ -43,19 +45,19 @@ namespace jam::net::ecs
 		uint64 immAcks = 0;
 		uint64 delayedAcks = 0;
 
-		// 
+		// 재전송
 		uint64 timeoutRetransmits = 0;
-		uint64 fastRetransmits = 0;      // fast + nack 
+		uint64 fastRetransmits = 0;      // fast + nack 통합
 		uint64 totalRetransmits = 0;
 
-		// RTT /  (ns )
+		// RTT / 지터 (ns 단위)
 		uint64 rtt_ns = 0;
 		uint64 jitter_ns = 0;
 		uint64 rttVariance = 0;
 		uint64 prevRtt_ns = 0;
-		uint64 rttProbeSend_ns = 0;      // RTT  ۽ ð
+		uint64 rttProbeSend_ns = 0;      // RTT 샘플 송신 시각
 
-		// Ļ 
+		// 파생 값
 		float  bandwidthSend_Bps = 0.f;
 		float  bandwidthRecv_Bps = 0.f;
 		float  packetLossSend_pct = 0.f;
@@ -63,47 +65,92 @@ namespace jam::net::ecs
 		float  ackEfficiency = 0.f;
 		float  fastRetransmitRatio = 0.f;
 
-		// ս 
+		// 손실 추정
 		uint64 expectedRecv = 0;
 		uint64 highestSeqSeen = 0;
 		uint64 lastAckedSeq = 0;
 
-		// ƽ  (뿪/ACK ũ)
+		// 틱 누적 (대역폭/ACK 크기)
 		uint64 accSendBytes = 0;
 		uint64 accRecvBytes = 0;
 		uint64 accAckBytes = 0;
 
-		// ä
+		// 채널
 		std::array<ChannelRuntime, NET_MAX_CHANNELS> channels{};
 	};
 
-	// ----- ̺Ʈ (ܺ  ڵ  ּȭ    ) -----
-	struct EvNsOnSend { entt::entity e{ entt::null }; uint32 size; };
-	struct EvNsOnRecv { entt::entity e{ entt::null }; uint32 size; };
-	struct EvNsOnSendR { entt::entity e{ entt::null }; };          // RTT probe ۽
-	struct EvNsOnRecvR { entt::entity e{ entt::null }; uint16 seq; }; // RTT probe ACK 
-	struct EvNsOnPacketLoss { entt::entity e{ entt::null }; uint32 count; };
-	struct EvNsOnPiggyAck { entt::entity e{ entt::null }; };
-	struct EvNsOnImmAck { entt::entity e{ entt::null }; };
-	struct EvNsOnDelayedAck { entt::entity e{ entt::null }; };
-	struct EvNsOnRTO { entt::entity e{ entt::null }; };
-	struct EvNsOnFastRTX { entt::entity e{ entt::null }; }; // fast + nack RTX 
-	// (EvNsOnNackRTX )
-
-	// ä ̺Ʈ
-	struct EvNsChOnSend { entt::entity e{ entt::null }; uint8 ch; uint32 size; };
-	struct EvNsChOnRecv { entt::entity e{ entt::null }; uint8 ch; uint32 size; };
-	struct EvNsChOnDrop { entt::entity e{ entt::null }; uint8 ch; uint32 count; };
-	struct EvNsChOnLoss { entt::entity e{ entt::null }; uint8 ch; uint32 count; };
-	struct EvNsChOnBuffered { entt::entity e{ entt::null }; uint8 ch; uint64 delay_ns; };
-	struct EvNsChOnReordered { entt::entity e{ entt::null }; uint8 ch; uint32 count; };
-
-	// ----- ڵ鷯 -----
+	// ----- 이벤트 (외부 기존 코드 영향 최소화 위해 기존 명명 유지) -----
+	// Merge(): back-to-back events of one entity (and channel) are folded into one by the EventBus
+	struct EvNsOnSend
+	{
+		entt::entity e{ entt::null }; uint32 size = 0; uint32 count = 1;
+		bool Merge(const EvNsOnSend& o) { if (o.e != e) return false; size += o.size; count += o.count; return true; }
+	};
+	struct EvNsOnRecv
+	{
+		entt::entity e{ entt::null }; uint32 size = 0; uint32 count = 1;
+		bool Merge(const EvNsOnRecv& o) { if (o.e != e) return false; size += o.size; count += o.count; return true; }
+	};
+	struct EvNsOnSendR { entt::entity e{ entt::null }; };          // RTT probe 송신
+	struct EvNsOnRecvR { entt::entity e{ entt::null }; uint16 seq; }; // RTT probe ACK 수신
+	struct EvNsOnPacketLoss
+	{
+		entt::entity e{ entt::null }; uint32 count = 1;
+		bool Merge(const EvNsOnPacketLoss& o) { if (o.e != e) return false; count += o.count; return true; }
+	};
+
+	// 단순 카운터 이벤트
+	template<typename Tag>
+	struct EvNsCounter
+	{
+		entt::entity e{ entt::null }; uint32 count = 1;
+		bool Merge(const EvNsCounter& o) { if (o.e != e) return false; count += o.count; return true; }
+	};
+	struct EvNsOnPiggyAck : EvNsCounter<EvNsOnPiggyAck> {};
+	struct EvNsOnImmAck : EvNsCounter<EvNsOnImmAck> {};
+	struct EvNsOnDelayedAck : EvNsCounter<EvNsOnDelayedAck> {};
+	struct EvNsOnRTO : EvNsCounter<EvNsOnRTO> {};
+	struct EvNsOnFastRTX : EvNsCounter<EvNsOnFastRTX> {}; // fast + nack RTX 통합
+	// (EvNsOnNackRTX 제거)
+
+	// 채널 이벤트
+	struct EvNsChOnSend
+	{
+		entt::entity e{ entt::null }; uint8 ch; uint32 size = 0; uint32 count = 1;
+		bool Merge(const EvNsChOnSend& o) { if (o.e != e || o.ch != ch) return false; size += o.size; count += o.count; return true; }
+	};
+	struct EvNsChOnRecv
+	{
+		entt::entity e{ entt::null }; uint8 ch; uint32 size = 0; uint32 count = 1;
+		bool Merge(const EvNsChOnRecv& o) { if (o.e != e || o.ch != ch) return false; size += o.size; count += o.count; return true; }
+	};
+	struct EvNsChOnDrop
+	{
+		entt::entity e{ entt::null }; uint8 ch; uint32 count = 1;
+		bool Merge(const EvNsChOnDrop& o) { if (o.e != e || o.ch != ch) return false; count += o.count; return true; }
+	};
+	struct EvNsChOnLoss
+	{
+		entt::entity e{ entt::null }; uint8 ch; uint32 count = 1;
+		bool Merge(const EvNsChOnLoss& o) { if (o.e != e || o.ch != ch) return false; count += o.count; return true; }
+	};
+	struct EvNsChOnBuffered
+	{
+		entt::entity e{ entt::null }; uint8 ch; uint64 delay_ns = 0; uint32 count = 1;
+		bool Merge(const EvNsChOnBuffered& o) { if (o.e != e || o.ch != ch) return false; delay_ns += o.delay_ns; count += o.count; return true; }
+	};
+	struct EvNsChOnReordered
+	{
+		entt::entity e{ entt::null }; uint8 ch; uint32 count = 1;
+		bool Merge(const EvNsChOnReordered& o) { if (o.e != e || o.ch != ch) return false; count += o.count; return true; }
+	};
+
+	// ----- 핸들러 -----
 	struct NetstatHandlers
 	{
 		entt::registry* R{};
 
-		//   EWMA ( = 1/10)
+		// 작은 정수 EWMA (α = 1/10)
 		static inline uint64 IIR(uint64 prev, uint64 sample, uint32 num = 1, uint32 den = 10)
 		{
 			return (prev == 0) ? sample : ((prev * (den - num) + sample * num) / den);
@@ -112,13 +159,13 @@ namespace jam::net::ecs
 		void OnSend(const EvNsOnSend& ev)
 		{
 			auto& s = R->get<CompNetstat>(ev.e);
-			s.totalSent++;
+			s.totalSent += ev.count;
 			s.accSendBytes += ev.size;
 		}
 		void OnRecv(const EvNsOnRecv& ev)
 		{
 			auto& s = R->get<CompNetstat>(ev.e);
-			s.totalRecv++;
+			s.totalRecv += ev.count;
 			s.accRecvBytes += ev.size;
 		}
 		void OnSendR(const EvNsOnSendR& ev)
@@ -140,7 +187,7 @@ namespace jam::net::ecs
 			s.rttVariance = IIR(s.rttVariance, rttDiff * rttDiff);
 			s.prevRtt_ns = s.rtt_ns;
 
-			// /ս 
+			// 수신/손실 기대
 			s.lastAckedSeq = ev.seq;
 			if (ev.seq > s.highestSeqSeen) 
 			{
@@ -156,41 +203,41 @@ namespace jam::net::ecs
 		void OnPiggy(const EvNsOnPiggyAck& ev)
 		{
 			auto& s = R->get<CompNetstat>(ev.e);
-			s.piggyAcks++;
-			s.totalAcksSend++;
-			s.accAckBytes += sizeof(AckHeader);
+			s.piggyAcks += ev.count;
+			s.totalAcksSend += ev.count;
+			s.accAckBytes += ev.count * sizeof(AckHeader);
 		}
 		void OnImm(const EvNsOnImmAck& ev) {
 			auto& s = R->get<CompNetstat>(ev.e);
-			s.immAcks++;
-			s.totalAcksSend++;
-			s.accAckBytes += sizeof(PacketHeader) + sizeof(AckHeader);
+			s.immAcks += ev.count;
+			s.totalAcksSend += ev.count;
+			s.accAckBytes += ev.count * (sizeof(PacketHeader) + sizeof(AckHeader));
 		}
 		void OnDelayed(const EvNsOnDelayedAck& ev) {
-			R->get<CompNetstat>(ev.e).delayedAcks++;
+			R->get<CompNetstat>(ev.e).delayedAcks += ev.count;
 		}
 		void OnRTO(const EvNsOnRTO& ev) {
 			auto& s = R->get<CompNetstat>(ev.e);
-			s.timeoutRetransmits++;
-			s.totalRetransmits++;
+			s.timeoutRetransmits += ev.count;
+			s.totalRetransmits += ev.count;
 		}
 		void OnFast(const EvNsOnFastRTX& ev) {
 			auto& s = R->get<CompNetstat>(ev.e);
-			s.fastRetransmits++;
-			s.totalRetransmits++;
+			s.fastRetransmits += ev.count;
+			s.totalRetransmits += ev.count;
 		}
 
-		// ä
+		// 채널
 		void ChSend(const EvNsChOnSend& ev) {
 			if (ev.ch >= NET_MAX_CHANNELS) return;
 			auto& rt = R->get<CompNetstat>(ev.e).channels[ev.ch];
-			rt.stat.totalSent++;
+			rt.stat.totalSent += ev.count;
 			rt.bwSendAccum += ev.size;
 		}
 		void ChRecv(const EvNsChOnRecv& ev) {
 			if (ev.ch >= NET_MAX_CHANNELS) return;
 			auto& rt = R->get<CompNetstat>(ev.e).channels[ev.ch];
-			rt.stat.totalRecv++;
+			rt.stat.totalRecv += ev.count;
 			rt.bwRecvAccum += ev.size;
 		}
 		void ChDrop(const EvNsChOnDrop& ev) {
@@ -204,9 +251,9 @@ namespace jam::net::ecs
 		void ChBuffered(const EvNsChOnBuffered& ev) {
 			if (ev.ch >= NET_MAX_CHANNELS) return;
 			auto& rt = R->get<CompNetstat>(ev.e).channels[ev.ch];
-			rt.stat.totalBuffered++;
+			rt.stat.totalBuffered += ev.count;
 			rt.bufferDelayAccum_ns += ev.delay_ns;
-			rt.bufferedPackets++;
+			rt.bufferedPackets += ev.count;
 		}
 		void ChReordered(const EvNsChOnReordered& ev) {
 			if (ev.ch >= NET_MAX_CHANNELS) return;
@@ -214,134 +261,159 @@ namespace jam::net::ecs
 		}
 	};
 
-	// ----- (̾) -----
+	constexpr auto EventRoute(std::type_identity<EvNsOnSend>)			{ return &NetstatHandlers::OnSend; }
+	constexpr auto EventRoute(std::type_identity<EvNsOnRecv>)			{ return &NetstatHandlers::OnRecv; }
+	constexpr auto EventRoute(std::type_identity<EvNsOnSendR>)			{ return &NetstatHandlers::OnSendR; }
+	constexpr auto EventRoute(std::type_identity<EvNsOnRecvR>)			{ return &NetstatHandlers::OnRecvAck; }
+	constexpr auto EventRoute(std::type_identity<EvNsOnPacketLoss>)		{ return &NetstatHandlers::OnPacketLoss; }
+	constexpr auto EventRoute(std::type_identity<EvNsOnPiggyAck>)		{ return &NetstatHandlers::OnPiggy; }
+	constexpr auto EventRoute(std::type_identity<EvNsOnImmAck>)			{ return &NetstatHandlers::OnImm; }
+	constexpr auto EventRoute(std::type_identity<EvNsOnDelayedAck>)		{ return &NetstatHandlers::OnDelayed; }
+	constexpr auto EventRoute(std::type_identity<EvNsOnRTO>)			{ return &NetstatHandlers::OnRTO; }
+	constexpr auto EventRoute(std::type_identity<EvNsOnFastRTX>)		{ return &NetstatHandlers::OnFast; }
+	constexpr auto EventRoute(std::type_identity<EvNsChOnSend>)			{ return &NetstatHandlers::ChSend; }
+	constexpr auto EventRoute(std::type_identity<EvNsChOnRecv>)			{ return &NetstatHandlers::ChRecv; }
+	constexpr auto EventRoute(std::type_identity<EvNsChOnDrop>)			{ return &NetstatHandlers::ChDrop; }
+	constexpr auto EventRoute(std::type_identity<EvNsChOnLoss>)			{ return &NetstatHandlers::ChLoss; }
+	constexpr auto EventRoute(std::type_identity<EvNsChOnBuffered>)		{ return &NetstatHandlers::ChBuffered; }
+	constexpr auto EventRoute(std::type_identity<EvNsChOnReordered>)	{ return &NetstatHandlers::ChReordered; }
+
+	// ----- 연결(와이어링) -----
 	struct NetstatSinks
 	{
 		bool wired = false;
-
-		entt::scoped_connection onSend;
-		entt::scoped_connection onRecv;
-		entt::scoped_connection onSendR;
-		entt::scoped_connection onRecvR;
-		entt::scoped_connection onPacketLoss;
-		entt::scoped_connection onPiggy;
-		entt::scoped_connection onImm;
-		entt::scoped_connection onDelayed;
-		entt::scoped_connection onRTO;
-		entt::scoped_connection onFast; // NACK 
-
-		// ä
-		entt::scoped_connection chSend;
-		entt::scoped_connection chRecv;
-		entt::scoped_connection chDrop;
-		entt::scoped_connection chLoss;
-		entt::scoped_connection chBuffered;
-		entt::scoped_connection chReordered;
-
 		NetstatHandlers handlers;
 	};
 
 	inline void NetstatWiringSystem(utils::exec::ShardLocal& L, uint64, uint64)
 	{
 		auto& R = L.world;
-		auto& D = L.events;
+		auto& D = NetEvents(L);
 		auto& sinks = R.ctx().emplace<NetstatSinks>();
 		if (sinks.wired) return;
 		sinks.handlers.R = &R;
 
-		sinks.onSend = D.sink<EvNsOnSend>().connect<&NetstatHandlers::OnSend>(&sinks.handlers);
-		sinks.onRecv = D.sink<EvNsOnRecv>().connect<&NetstatHandlers::OnRecv>(&sinks.handlers);
-		sinks.onSendR = D.sink<EvNsOnSendR>().connect<&NetstatHandlers::OnSendR>(&sinks.handlers);
-		sinks.onRecvR = D.sink<EvNsOnRecvR>().connect<&NetstatHandlers::OnRecvAck>(&sinks.handlers);
-		sinks.onPacketLoss = D.sink<EvNsOnPacketLoss>().connect<&NetstatHandlers::OnPacketLoss>(&sinks.handlers);
-		sinks.onPiggy = D.sink<EvNsOnPiggyAck>().connect<&NetstatHandlers::OnPiggy>(&sinks.handlers);
-		sinks.onImm = D.sink<EvNsOnImmAck>().connect<&NetstatHandlers::OnImm>(&sinks.handlers);
-		sinks.onDelayed = D.sink<EvNsOnDelayedAck>().connect<&NetstatHandlers::OnDelayed>(&sinks.handlers);
-		sinks.onRTO = D.sink<EvNsOnRTO>().connect<&NetstatHandlers::OnRTO>(&sinks.handlers);
-		sinks.onFast = D.sink<EvNsOnFastRTX>().connect<&NetstatHandlers::OnFast>(&sinks.handlers);
-		// NACK ̺Ʈ 
-
-		// ä
-		sinks.chSend = D.sink<EvNsChOnSend>().connect<&NetstatHandlers::ChSend>(&sinks.handlers);
-		sinks.chRecv = D.sink<EvNsChOnRecv>().connect<&NetstatHandlers::ChRecv>(&sinks.handlers);
-		sinks.chDrop = D.sink<EvNsChOnDrop>().connect<&NetstatHandlers::ChDrop>(&sinks.handlers);
-		sinks.chLoss = D.sink<EvNsChOnLoss>().connect<&NetstatHandlers::ChLoss>(&sinks.handlers);
-		sinks.chBuffered = D.sink<EvNsChOnBuffered>().connect<&NetstatHandlers::ChBuffered>(&sinks.handlers);
-		sinks.chReordered = D.sink<EvNsChOnReordered>().connect<&NetstatHandlers::ChReordered>(&sinks.handlers);
+		D.Bind<EvNsOnSend>(&sinks.handlers);
+		D.Bind<EvNsOnRecv>(&sinks.handlers);
+		D.Bind<EvNsOnSendR>(&sinks.handlers);
+		D.Bind<EvNsOnRecvR>(&sinks.handlers);
+		D.Bind<EvNsOnPacketLoss>(&sinks.handlers);
+		D.Bind<EvNsOnPiggyAck>(&sinks.handlers);
+		D.Bind<EvNsOnImmAck>(&sinks.handlers);
+		D.Bind<EvNsOnDelayedAck>(&sinks.handlers);
+		D.Bind<EvNsOnRTO>(&sinks.handlers);
+		D.Bind<EvNsOnFastRTX>(&sinks.handlers);
+		// NACK 이벤트 제거
+
+		// 채널
+		D.Bind<EvNsChOnSend>(&sinks.handlers);
+		D.Bind<EvNsChOnRecv>(&sinks.handlers);
+		D.Bind<EvNsChOnDrop>(&sinks.handlers);
+		D.Bind<EvNsChOnLoss>(&sinks.handlers);
+		D.Bind<EvNsChOnBuffered>(&sinks.handlers);
+		D.Bind<EvNsChOnReordered>(&sinks.handlers);
 
 		sinks.wired = true;
 	}
 
-	// ----- ƽ ý -----
+	// per-shard tick count, phases THROTTLE_IDLE (emplaced by RegisterNetEcs)
+	struct NetstatClock
+	{
+		uint64 tick = 0;
+	};
+
+	// ----- 틱 시스템 -----
 	inline void NetstatTickSystem(utils::exec::ShardLocal& L, uint64, uint64 dt_ns)
 	{
 		if (dt_ns == 0) return;
 		auto& R = L.world;
 		const double invDt = 1'000'000'000.0 / static_cast<double>(dt_ns);
 
-		auto view = R.view<CompNetstat>();
-		for (auto e : view)
-		{
-			auto& s = view.get<CompNetstat>(e);
-
-			// 뿪
-			s.bandwidthSend_Bps = static_cast<float>(s.accSendBytes * invDt);
-			s.bandwidthRecv_Bps = static_cast<float>(s.accRecvBytes * invDt);
-
-			// սǷ (۽ )
-			if (s.totalSent > 0)
-				s.packetLossSend_pct = static_cast<float>(s.totalLost) / static_cast<float>(s.totalSent) * 100.f;
-
-			// սǷ (  )
-			if (s.expectedRecv > 0 && s.totalRecv > 0) 
-			{
-				float loss = static_cast<float>(s.expectedRecv - s.totalRecv) / static_cast<float>(s.expectedRecv) * 100.f;
-				s.packetLossRecv_pct = std::clamp(loss, 0.f, 100.f);
-			}
-
-			// ACK ȿ
-			if (s.bandwidthSend_Bps > 0.f) 
-			{
-				float ackBw = static_cast<float>(s.accAckBytes * invDt);
-				s.ackEfficiency = ackBw / s.bandwidthSend_Bps;
-			}
-			else
-			{
-				s.ackEfficiency = 0.f;
-			}
+		// overloaded (THROTTLE_IDLE): a session with no traffic since its last pass only refreshes
+		// every idleStride ticks, on a phase of its own so each tick does an even share
+		OverloadController* overload = R.ctx().get<OverloadController*>();
+		const uint32 idleStride = overload ? overload->GetIdleTickStride() : 1;
+		const uint64 tick = R.ctx().get<NetstatClock>().tick++;
 
-			//  
-			if (s.totalRetransmits > 0)
-				s.fastRetransmitRatio = static_cast<float>(s.fastRetransmits) / static_cast<float>(s.totalRetransmits);
-			else
-				s.fastRetransmitRatio = 0.f;
-
-			// ä
-			const float totalSendBw = s.bandwidthSend_Bps;
-			for (auto& rt : s.channels)
+		// per-entity math only: chunks of the view run on IO workers
+		auto view = R.view<CompNetstat>();
+		L.systems.ParallelFor(view.size(), NETSTAT_TICK_CHUNK, [&view, invDt, overload, idleStride, tick](size_t begin, size_t end)
 			{
-				const float chSendBw = static_cast<float>(rt.bwSendAccum * invDt);
-				if (totalSendBw > 0.f)
-					rt.stat.utilization = chSendBw / totalSendBw;
-				else
-					rt.stat.utilization = 0.f;
-
-				if (rt.bufferedPackets > 0)
-					rt.stat.averageBufferDelay_ns = rt.bufferDelayAccum_ns / rt.bufferedPackets;
-				else
-					rt.stat.averageBufferDelay_ns = 0;
-
-				// tick accumulator reset
-				rt.bwSendAccum = 0;
-				rt.bwRecvAccum = 0;
-				rt.bufferDelayAccum_ns = 0;
-				rt.bufferedPackets = 0;
-			}
-
-			//  tick  
-			s.accSendBytes = 0;
-			s.accRecvBytes = 0;
-			s.accAckBytes = 0;
-		}
+				uint64 throttled = 0;
+				auto it = view.begin() + begin;
+				for (size_t i = begin; i < end; ++i, ++it)
+				{
+					auto& s = view.get<CompNetstat>(*it);
+
+					// nothing accumulated: skipping loses no sample, derived values just age
+					if (idleStride > 1 && s.accSendBytes == 0 && s.accRecvBytes == 0 && (i + tick) % idleStride != 0)
+					{
+						++throttled;
+						continue;
+					}
+
+					// 대역폭
+					s.bandwidthSend_Bps = static_cast<float>(s.accSendBytes * invDt);
+					s.bandwidthRecv_Bps = static_cast<float>(s.accRecvBytes * invDt);
+
+					// 손실률 (송신 기준)
+					if (s.totalSent > 0)
+						s.packetLossSend_pct = static_cast<float>(s.totalLost) / static_cast<float>(s.totalSent) * 100.f;
+
+					// 손실률 (수신 기대 기반)
+					if (s.expectedRecv > 0 && s.totalRecv > 0) 
+					{
+						float loss = static_cast<float>(s.expectedRecv - s.totalRecv) / static_cast<float>(s.expectedRecv) * 100.f;
+						s.packetLossRecv_pct = std::clamp(loss, 0.f, 100.f);
+					}
+
+					// ACK 효율
+					if (s.bandwidthSend_Bps > 0.f) 
+					{
+						float ackBw = static_cast<float>(s.accAckBytes * invDt);
+						s.ackEfficiency = ackBw / s.bandwidthSend_Bps;
+					}
+					else
+					{
+						s.ackEfficiency = 0.f;
+					}
+
+					// 재전송 비율
+					if (s.totalRetransmits > 0)
+						s.fastRetransmitRatio = static_cast<float>(s.fastRetransmits) / static_cast<float>(s.totalRetransmits);
+					else
+						s.fastRetransmitRatio = 0.f;
+
+					// 채널
+					const float totalSendBw = s.bandwidthSend_Bps;
+					for (auto& rt : s.channels)
+					{
+						const float chSendBw = static_cast<float>(rt.bwSendAccum * invDt);
+						if (totalSendBw > 0.f)
+							rt.stat.utilization = chSendBw / totalSendBw;
+						else
+							rt.stat.utilization = 0.f;
+
+						if (rt.bufferedPackets > 0)
+							rt.stat.averageBufferDelay_ns = rt.bufferDelayAccum_ns / rt.bufferedPackets;
+						else
+							rt.stat.averageBufferDelay_ns = 0;
+
+						// tick accumulator reset
+						rt.bwSendAccum = 0;
+						rt.bwRecvAccum = 0;
+						rt.bufferDelayAccum_ns = 0;
+						rt.bufferedPackets = 0;
+					}
+
+					// 전역 tick 누적 리셋
+					s.accSendBytes = 0;
+					s.accRecvBytes = 0;
+					s.accAckBytes = 0;
+				}
+
+				if (throttled != 0)
+					overload->RecordThrottledTicks(throttled);
+			});
 	}
 }
\ No newline at end of file
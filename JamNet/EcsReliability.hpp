@@ -5,6 +5,7 @@
 #include "EcsCommon.hpp"
 #include "EcsHandle.h"
 #include "EcsTransportAPI.hpp"
+#include "EcsEventBus.hpp"
 #include "PacketBuilder.h"
 
 #include "ReliableTransportManager.h"	//temp
@@ -53,7 +54,7 @@ namespace jam::net::ecs
 	struct EvReSendR
 	{
 		entt::entity        e{ entt::null };
-		Sptr<SendBuffer>    buf;
+		SendBufferRef       buf;
 		uint16              seq;
 		uint32              size;
 		uint64              ts;
@@ -92,6 +93,9 @@ namespace jam::net::ecs
 
 	static inline bool SeqGreater(uint16 a, uint16 b) { return static_cast<int16>(a - b) > 0; }
 
+	// stamps are loop time (LoopNowNs); one taken after now reads as 0 elapsed, never as a wrap
+	static inline uint64 ElapsedSince(uint64 now_ns, uint64 since_ns) { return since_ns > now_ns ? 0 : now_ns - since_ns; }
+
 	static inline uint32 BuildAckBitfield(const CompReliability& cr, uint16 latestSeq)
 	{
 		uint32 bitfield = 0;
@@ -152,8 +156,8 @@ namespace jam::net::ecs
 			// gap -> NACK 고려
 			if (SeqGreater(seq, cr.expectedNextSeq))
 			{
-				const uint64 now = utils::Clock::Instance().NowNs();
-				if ((now - cr.lastNackTime_ns) >= ReliableTransportManager::NACK_THROTTLE_INTERVAL &&
+				const uint64 now = utils::Clock::Instance().LoopNowNs();
+				if (ElapsedSince(now, cr.lastNackTime_ns) >= ReliableTransportManager::NACK_THROTTLE_INTERVAL &&
 					!st->sentNackSeqs.contains(cr.expectedNextSeq) &&
 					SeqGreater(seq, static_cast<uint16>(cr.expectedNextSeq + 1)))
 				{
@@ -176,7 +180,7 @@ namespace jam::net::ecs
 			}
 
 			// 지연 ACK 예약
-			const uint64 now_ns = utils::Clock::Instance().NowNs();
+			const uint64 now_ns = utils::Clock::Instance().LoopNowNs();
 			if (!cr.hasPendingAck)
 			{
 				cr.hasPendingAck = true;
@@ -222,10 +226,10 @@ namespace jam::net::ecs
 					{
 						ecs::EnqueueSend(*R, ev.e, it->second.buffer, eTxReason::RETRANSMIT);
 						it->second.retryCount++;
-						it->second.timestamp = utils::Clock::Instance().NowNs();
+						it->second.timestamp = utils::Clock::Instance().LoopNowNs();
 
-						R->ctx().get<entt::dispatcher>().enqueue<EvNsOnFastRTX>(EvNsOnFastRTX{ ev.e });
-						R->ctx().get<entt::dispatcher>().enqueue<EvCCFastRTX>(EvCCFastRTX{ ev.e });
+						NetEvents(*R).Post(EvNsOnFastRTX{ ev.e });
+						NetEvents(*R).Post(EvCCFastRTX{ ev.e });
 					}
 					cnt = 0;
 				}
@@ -249,10 +253,10 @@ namespace jam::net::ecs
 				{
 					ecs::EnqueueSend(*R, ev.e, it->second.buffer, eTxReason::RETRANSMIT);
 					it->second.retryCount++;
-					it->second.timestamp = utils::Clock::Instance().NowNs();
+					it->second.timestamp = utils::Clock::Instance().LoopNowNs();
 
-					R->ctx().get<entt::dispatcher>().enqueue<EvNsOnFastRTX>(EvNsOnFastRTX{ ev.e });
-					R->ctx().get<entt::dispatcher>().enqueue<EvCCFastRTX>(EvCCFastRTX{ ev.e });
+					NetEvents(*R).Post(EvNsOnFastRTX{ ev.e });
+					NetEvents(*R).Post(EvCCFastRTX{ ev.e });
 				}
 			};
 			trigger(ev.missingSeq);
@@ -262,17 +266,16 @@ namespace jam::net::ecs
 		}
 	};
 
+	constexpr auto EventRoute(std::type_identity<EvReSendR>)       { return &ReliabilityHandlers::OnSendR; }
+	constexpr auto EventRoute(std::type_identity<EvReRecvR>)       { return &ReliabilityHandlers::OnRecvR; }
+	constexpr auto EventRoute(std::type_identity<EvReRecvACK>)     { return &ReliabilityHandlers::OnRecvACK; }
+	constexpr auto EventRoute(std::type_identity<EvReRecvNACK>)    { return &ReliabilityHandlers::OnRecvNACK; }
+
 	// Sinks
 
 	struct ReliabilitySinks
 	{
 		bool                    wired = false;
-
-		entt::scoped_connection onSendR;
-		entt::scoped_connection onRecvR;
-		entt::scoped_connection onRecvACK;
-		entt::scoped_connection onRecvNACK;
-
 		ReliabilityHandlers     handlers;
 	};
 
@@ -281,17 +284,17 @@ namespace jam::net::ecs
 	inline void ReliabilityWiringSystem(utils::exec::ShardLocal& L, uint64, uint64)
 	{
 		auto& R = L.world;
-		auto& D = L.events;
+		auto& D = NetEvents(L);
 
 		auto& sinks = R.ctx().emplace<ReliabilitySinks>();
 		if (sinks.wired) return;
 
 		sinks.handlers.R = &R;
 
-		sinks.onSendR   = D.sink<EvReSendR>().connect<&ReliabilityHandlers::OnSendR>(&sinks.handlers);
-		sinks.onRecvR   = D.sink<EvReRecvR>().connect<&ReliabilityHandlers::OnRecvR>(&sinks.handlers);
-		sinks.onRecvACK = D.sink<EvReRecvACK>().connect<&ReliabilityHandlers::OnRecvACK>(&sinks.handlers);
-		sinks.onRecvNACK= D.sink<EvReRecvNACK>().connect<&ReliabilityHandlers::OnRecvNACK>(&sinks.handlers);
+		D.Bind<EvReSendR>(&sinks.handlers);
+		D.Bind<EvReRecvR>(&sinks.handlers);
+		D.Bind<EvReRecvACK>(&sinks.handlers);
+		D.Bind<EvReRecvNACK>(&sinks.handlers);
 
 		sinks.wired = true;
 	}
@@ -300,7 +303,7 @@ namespace jam::net::ecs
 	{
 		auto& R = L.world;
 		auto& pools = R.ctx().get<EcsHandlePools>();
-		const uint64 now = utils::Clock::Instance().NowNs();
+		const uint64 now = now_ns;
 
 		auto view = R.view<CompReliability, CompEndpoint>();
 		for (auto e : view)
@@ -313,7 +316,7 @@ namespace jam::net::ecs
 			// 펜딩 없을 때 지연 ACK (타임아웃)
 			if (st->pending.empty())
 			{
-				if (cr.hasPendingAck && (now - cr.firstPendingAckTime_ns) >= MAX_DELAY_TICK_PIGGYBACK_ACK)
+				if (cr.hasPendingAck && ElapsedSince(now, cr.firstPendingAckTime_ns) >= MAX_DELAY_TICK_PIGGYBACK_ACK)
 				{
 					ecs::EnqueueSend(R, e,
 						PacketBuilder::CreateReliabilityAckPacket(cr.pendingAckSeq, cr.pendingAckBitfield),
@@ -331,7 +334,7 @@ namespace jam::net::ecs
 
 			for (auto& [seq, pk] : st->pending)
 			{
-				const uint64 elapsed = now - pk.timestamp;
+				const uint64 elapsed = ElapsedSince(now, pk.timestamp);
 				if (elapsed >= RETRANSMIT_TIMEOUT || pk.retryCount >= MAX_RETRY_COUNT)
 				{
 					toRemove.push_back(seq);
@@ -360,13 +363,13 @@ namespace jam::net::ecs
 					it->second.retryCount++;
 					it->second.timestamp = now;
 
-					R.ctx().get<entt::dispatcher>().enqueue<EvNsOnFastRTX>(EvNsOnFastRTX{ e });
-					R.ctx().get<entt::dispatcher>().enqueue<EvCCFastRTX>(EvCCFastRTX{ e });
+					NetEvents(R).Post(EvNsOnFastRTX{ e });
+					NetEvents(R).Post(EvCCFastRTX{ e });
 				}
 			}
 
 			// 펜딩 있어도 ACK 지연 한도 초과 -> 독립 ACK 송신
-			if (cr.hasPendingAck && (now - cr.firstPendingAckTime_ns) >= MAX_DELAY_TICK_PIGGYBACK_ACK)
+			if (cr.hasPendingAck && ElapsedSince(now, cr.firstPendingAckTime_ns) >= MAX_DELAY_TICK_PIGGYBACK_ACK)
 			{
 				ecs::EnqueueSend(R, e,
 					PacketBuilder::CreateReliabilityAckPacket(cr.pendingAckSeq, cr.pendingAckBitfield),
@@ -3,6 +3,7 @@
 #include "pch.h"
 
 #include "EcsTransportAPI.hpp"
+#include "EcsEventBus.hpp"
 
 #include "EcsReliability.hpp"
 #include "EcsCongestionControl.hpp"    
@@ -27,13 +28,13 @@ namespace jam::net::ecs
 	//{
  //       NORMAL,
  //       RETRANSMIT,
- //       CONTROL,       // Handshake, FIN, ACK( )
- //       ACK_ONLY,       //  ACK
+ //       CONTROL,       // Handshake, FIN, ACK(세션 제어)
+ //       ACK_ONLY,       // 독립 ACK
  //   };
 
     struct PendingTx
 	{
-        Sptr<SendBuffer>    buf;
+        SendBufferRef       buf;
         eTxReason           reason{ eTxReason::NORMAL };
         uint32              size = 0;
     };
@@ -51,7 +52,7 @@ namespace jam::net::ecs
     struct EvTxEnqueue
 	{
         entt::entity        e{ entt::null };
-        Sptr<SendBuffer>    buf;
+        SendBufferRef       buf;
         eTxReason           reason{ eTxReason::NORMAL };
         uint32              size = 0;
     };
@@ -61,11 +62,22 @@ namespace jam::net::ecs
         entt::entity        e{ entt::null };
     };
 
-    //   ( config ̵)
+    // 설정 상수 (추후 config 이동)
     constexpr uint32 TRANSPORT_BATCH_MAX            = 32;
     constexpr uint64 TRANSPORT_FLUSH_INTERVAL_NS    = 1'000'000_ns;       // 1ms
-    constexpr uint64 TRANSPORT_FORCE_INTERVAL_NS    = 5'000'000_ns;       // 5ms (ִ )
-    constexpr uint64 TRANSPORT_IMMEDIATE_CTRL_NS    = 0_ns;               // Control 
+    constexpr uint64 TRANSPORT_FORCE_INTERVAL_NS    = 5'000'000_ns;       // 5ms (최대 지연)
+    constexpr uint64 TRANSPORT_IMMEDIATE_CTRL_NS    = 0_ns;               // Control 즉시
+
+    // At most one EvTxFlush pending per session: immediate sends and the tick share it.
+    // Posted on the bus, so an enqueue drained this tick is flushed in the same drain.
+    inline void RequestFlush(entt::registry& R, entt::entity e)
+    {
+        auto& tx = R.get<CompTransportTx>(e);
+        if (tx.flushRequested) return;
+
+        tx.flushRequested = true;
+        NetEvents(R).Post(EvTxFlush{ e });
+    }
 
     struct TransportHandlers
     {
@@ -83,7 +95,7 @@ namespace jam::net::ecs
 
 
      //   // todo: change to PacketAnalysis
-     //   static bool IsReliable(const Sptr<SendBuffer>&buf)
+     //   static bool IsReliable(const SendBufferRef&buf)
     	//{
      //       if (!buf || !buf->Buffer()) return false;
      //       auto* h = reinterpret_cast<PacketHeader*>(buf->Buffer());
@@ -91,12 +103,11 @@ namespace jam::net::ecs
      //   }
 
 
-        // Piggyback õ (  true)
+        // Piggyback 시도 (성공 시 true)
         bool TryPiggyback(entt::entity e, PendingTx& txp)
     	{
             auto& L = SHARD_LOCAL_CHECKED();
             auto& R = L.world;
-            auto& D = L.events;
 
             if (!R.all_of<CompReliability>(e)) return false;
 
@@ -143,14 +154,13 @@ namespace jam::net::ecs
         {
             auto& L = SHARD_LOCAL_CHECKED();
             auto& R = L.world;
-            auto& D = L.events;
 
             if (!ev.buf || !ev.buf->Buffer()) return;
             auto& tx = R.get<CompTransportTx>(ev.e);
             tx.queue.push_back(PendingTx{ ev.buf, ev.reason, ev.size });
             tx.bytesQueued += ev.size;
 
-            //  ÷ 
+            // 즉시 플러시 조건
             bool immediate = false;
             switch (ev.reason)
             {
@@ -167,7 +177,7 @@ namespace jam::net::ecs
             if (tx.queue.size() >= TRANSPORT_BATCH_MAX) immediate = true;
             if (immediate && CanFlush(ev.e))
             {
-               D.enqueue<EvTxFlush>(EvTxFlush{ ev.e });
+                RequestFlush(R, ev.e);
             }
         }
 
@@ -175,19 +185,20 @@ namespace jam::net::ecs
         {
             auto& L = SHARD_LOCAL_CHECKED();
             auto& R = L.world;
-            auto& D = L.events;
+            auto& D = NetEvents(L);
 
             if (!R.all_of<CompTransportTx, CompEndpoint>(ev.e)) return;
             auto& tx = R.get<CompTransportTx>(ev.e);
+            tx.flushRequested = false;
             if (tx.queue.empty()) return;
 
-            // (1)  ACK ŸӾƿ̸ standalone ACK_ONLY Ŷ  (Piggyback  ã )
+            // (1) 지연 ACK 타임아웃이면 standalone ACK_ONLY 패킷 삽입 (Piggyback 못 찾을 대비)
             if (R.all_of<CompReliability>(ev.e)) 
             {
                 auto& cr = R.get<CompReliability>(ev.e);
                 if (cr.hasPendingAck) 
                 {
-                    uint64 now = utils::Clock::Instance().NowNs();
+                    uint64 now = utils::Clock::Instance().LoopNowNs();
                     if ((now - cr.firstPendingAckTime_ns) >= MAX_DELAY_TICK_PIGGYBACK_ACK) 
                     {
                         auto ackBuf = PacketBuilder::CreateReliabilityAckPacket(cr.pendingAckSeq, cr.pendingAckBitfield);
@@ -196,10 +207,10 @@ namespace jam::net::ecs
                 }
             }
 
-            // (2) 켱 
+            // (2) 우선순위 정렬
             ranges::stable_sort(tx.queue, [](const PendingTx& a, const PendingTx& b) { return Priority(a.reason) < Priority(b.reason); });
 
-            // (3) Piggyback 1ȸ õ (ڿ Reliable ĺ)
+            // (3) Piggyback 1회 시도 (뒤에서부터 Reliable 후보)
             bool piggyOK = false;
             if (R.all_of<CompReliability>(ev.e)) 
             {
@@ -217,12 +228,12 @@ namespace jam::net::ecs
                 }
             }
 
-            // (4) ߴٸ ACK_ONLY ׸ 
+            // (4) 성공했다면 ACK_ONLY 항목 제거
             if (piggyOK) 
             {
                 std::erase_if(tx.queue, [](const PendingTx& p) { return p.reason == eTxReason::ACK_ONLY; });
             }
-            // (piggy  + timeout̸ ACK_ONLY  Ƿ ״ )
+            // (piggy 실패 + timeout이면 ACK_ONLY 남아 있으므로 그대로 전송)
 
 
             for (auto& p : tx.queue)
@@ -230,26 +241,25 @@ namespace jam::net::ecs
                 PacketAnalysis an = PacketBuilder::AnalyzePacket(p.buf->Buffer(), p.buf->WriteSize());
                 if (an.IsReliable())
                 {
-                	D.enqueue<EvNsOnSendR>(EvNsOnSendR{ ev.e });
+                	D.Post(EvNsOnSendR{ ev.e });
                 }
 
-                D.enqueue<EvNsOnSend>(EvNsOnSend{ ev.e });
+                D.Post(EvNsOnSend{ ev.e, p.size });
             }
 
 
             auto& ep = R.get<CompEndpoint>(ev.e);
 
-            // ť Ͽ   غ
+            // 큐 스왑하여 락없이 전송 준비
             xvector<PendingTx> batch;
             batch.swap(tx.queue);
             tx.bytesQueued = 0;
-            tx.flushRequested = false;
-            tx.lastFlush_ns = utils::Clock::Instance().NowNs();
+            tx.lastFlush_ns = utils::Clock::Instance().LoopNowNs();
 
             auto session = ep.owner; // UdpSession*
             if (!session) return;
 
-            // IO-thread(PostCtrl) 
+            // IO-thread(PostCtrl)로 전송
             auto sending = std::make_shared<xvector<PendingTx>>(std::move(batch));
             session->PostCtrl(utils::job::Job([sending, session] {
 	                for (auto& p : *sending)
@@ -260,13 +270,14 @@ namespace jam::net::ecs
         }
     };
 
+    constexpr auto EventRoute(std::type_identity<EvTxEnqueue>)     { return &TransportHandlers::OnEnqueue; }
+    constexpr auto EventRoute(std::type_identity<EvTxFlush>)       { return &TransportHandlers::OnFlush; }
+
     // Sinks
 
     struct TransportSinks
     {
         bool                    wired = false;
-        entt::scoped_connection onEnqueue;
-        entt::scoped_connection onFlush;
         TransportHandlers       handlers;
     };
 
@@ -275,13 +286,13 @@ namespace jam::net::ecs
     inline void TransportWiringSystem(utils::exec::ShardLocal& L, uint64, uint64)
     {
         auto& R = L.world;
-    	auto& D = L.events;
+    	auto& D = NetEvents(L);
         auto& s = R.ctx().emplace<TransportSinks>();
         if (s.wired) return;
         s.handlers.R = &R;
 
-        s.onEnqueue     = D.sink<EvTxEnqueue>().connect<&TransportHandlers::OnEnqueue>(&s.handlers);
-        s.onFlush       = D.sink<EvTxFlush>().connect<&TransportHandlers::OnFlush>(&s.handlers);
+        D.Bind<EvTxEnqueue>(&s.handlers);
+        D.Bind<EvTxFlush>(&s.handlers);
 
         s.wired = true;
     }
@@ -289,7 +300,6 @@ namespace jam::net::ecs
     inline void TransportTickSystem(utils::exec::ShardLocal& L, uint64 now_ns, uint64 dt_ns)
     {
         auto& R = L.world;
-        auto& D = L.events;
         auto view = R.view<CompTransportTx, CompEndpoint>();
         for (auto e : view)
         {
@@ -300,7 +310,7 @@ namespace jam::net::ecs
             bool timeFlush = (elapsed >= TRANSPORT_FLUSH_INTERVAL_NS);
             bool forceFlush = (elapsed >= TRANSPORT_FORCE_INTERVAL_NS);
 
-            // ȥ üũ
+            // 혼잡 체크
             bool canFlush = true;
             if (R.all_of<CompReliability, CompCongestion>(e))
             {
@@ -311,7 +321,7 @@ namespace jam::net::ecs
 
             if ((timeFlush || forceFlush) && canFlush)
             {
-                D.enqueue<EvTxFlush>(EvTxFlush{ e });
+                RequestFlush(R, e);
             }
         }
     }
@@ -319,38 +329,48 @@ namespace jam::net::ecs
     
     // Helper
 
-    inline void EnqueueSend(entt::entity e, const Sptr<SendBuffer>& buf, eTxReason reason)
+    inline void EnqueueSend(entt::entity e, const SendBufferRef& buf, eTxReason reason)
     {
         auto& L = utils::exec::ShardTLS::GetCurrentChecked();
         auto& R = L.world;
-        auto& D = L.events;
+        auto& D = NetEvents(L);
 
         if (!R.all_of<CompTransportTx>(e))
             R.emplace<CompTransportTx>(e);
 
         PacketAnalysis an = PacketBuilder::AnalyzePacket(buf->Buffer(), buf->WriteSize());
 
+        // overloaded: best-effort game traffic goes first; system and ACK packets keep links alive
+        const bool bestEffort = !an.IsReliable() && reason == eTxReason::NORMAL
+            && (an.GetType() == ePacketType::RPC || an.GetType() == ePacketType::CUSTOM);
+        if (bestEffort)
+        {
+            OverloadController* overload = R.ctx().get<OverloadController*>();
+            if (overload && overload->DropUnreliable())
+                return;
+        }
+
         if (an.IsNeedToFragmentation())
         {
-            D.enqueue<EvFgFragmentize>(EvFgFragmentize{ e, buf, an });
+            D.Post(EvFgFragmentize{ e, buf, an });
             return;
         }
 
-        // 2. ŷڼ ʿ
+        // 2. 신뢰성 필요
         if (an.IsReliable() && R.all_of<CompReliability>(e))
         {
             uint16 seq = AllocSeqRange(R, e, 1);
             auto* ph = reinterpret_cast<PacketHeader*>(buf->Buffer());
             ph->SetSequence(seq);
 
-            uint64 now = utils::Clock::Instance().NowNs();
+            uint64 now = utils::Clock::Instance().LoopNowNs();
             uint32 size = buf->WriteSize();
 
-            D.enqueue<EvReSendR>(EvReSendR{ e, buf, seq, size, now });
+            D.Post(EvReSendR{ e, buf, seq, size, now });
             return;
         }
 
         uint32 sz = (buf && buf->Buffer()) ? buf->WriteSize() : 0;
-        D.enqueue<EvTxEnqueue>(EvTxEnqueue{ e, buf, reason, sz });
+        D.Post(EvTxEnqueue{ e, buf, reason, sz });
     }
 }
@@ -5,9 +5,9 @@
 
 namespace jam::net
 {
-	xvector<Sptr<SendBuffer>> FragmentManager::Fragmentize(const Sptr<SendBuffer>& buf, const PacketAnalysis& analysis)
+	xvector<SendBufferRef> FragmentManager::Fragmentize(const SendBufferRef& buf, const PacketAnalysis& analysis)
 	{
-        xvector<Sptr<SendBuffer>> fragments;
+        xvector<SendBufferRef> fragments;
 
         if (!buf || analysis.payloadSize == 0)
             return fragments;
@@ -68,22 +68,22 @@ namespace jam::net
 
         CleanupStaleReassemblies();
 
-        // Fragment ׷ Ű  (ù ° Fragment sequence)
+        // Fragment 그룹 키 계산 (첫 번째 Fragment의 sequence)
         uint16 groupKey = sequence - fragIndex;
         auto& reassembly = m_reassemblies[groupKey];
 
-        // ù Fragment̰ų  ʱȭ   ʱȭ
+        // 첫 Fragment이거나 아직 초기화되지 않은 경우 초기화
         if (!reassembly.headerSaved)
         {
             reassembly.Init(fragTotal);
 
-            //     (Fragment ÷ )
+            // 원본 헤더 정보 저장 (Fragment 플래그 제거)
             reassembly.originalHeader = analysis.header;
             reassembly.originalHeader.SetFlags(reassembly.originalHeader.GetFlags() & ~PacketFlags::FRAGMENTED);
             reassembly.headerSaved = true;
         }
 
-        // Fragment  ġ Ȯ
+        // Fragment 개수 일치 확인
         if (reassembly.totalCount != fragTotal)
         {
             std::cout << "[FragmentManager] Fragment count mismatch. Expected: "
@@ -92,32 +92,32 @@ namespace jam::net
             return result;
         }
 
-        // ߺ Fragment üũ
+        // 중복 Fragment 체크
         if (reassembly.recvFragments[fragIndex])
         {
             std::cout << "[FragmentManager] Duplicate fragment received: " << (int)fragIndex << std::endl;
-            // ߺ  ƴϹǷ ׳ ȯ
+            // 중복이지만 에러는 아니므로 그냥 반환
             return result;
         }
 
-        // Fragment  
+        // Fragment 데이터 저장
         if (!reassembly.WriteFragment(fragIndex, payload, payloadSize))
         {
             std::cout << "[FragmentManager] Failed to write fragment " << (int)fragIndex << std::endl;
             return result;
         }
 
-        //   ð 
+        // 마지막 수신 시간 갱신
         reassembly.lastRecvTime = Clock::Instance().GetCurrentTick();
 
-        //  Fragment ŵǾ Ȯ
+        // 모든 Fragment가 수신되었는지 확인
         if (reassembly.IsComplete())
         {
-            //   
+            // 재조립된 데이터 가져오기
             result.first = true;
             result.second = reassembly.GetReassembledData();
 
-            //   
+            // 재조립 정보 삭제
             m_reassemblies.erase(groupKey);
 
             std::cout << "[FragmentManager] Fragment reassembly completed. Total size: "
@@ -125,7 +125,7 @@ namespace jam::net
         }
         //else
         //{
-        //    //  Ȳ α
+        //    // 진행 상황 로깅
         //    uint32 receivedCount = 0;
         //    for (bool received : reassembly.recvFragments)
         //    {
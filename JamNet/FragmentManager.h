@@ -23,7 +23,7 @@ namespace jam::net
         uint64			        lastRecvTime_ns;
         uint8			        totalCount;
         xvector<bool>	        recvFragments;
-        xvector<xvector<BYTE>>  fragmentData;  //  Fragment ͸  
+        xvector<xvector<BYTE>>  fragmentData;  // 각 Fragment 데이터를 별도 저장
 
         PacketHeader	        originalHeader;
         bool			        headerSaved = false;
@@ -41,7 +41,7 @@ namespace jam::net
             if (index >= totalCount)
                 return false;
 
-            // Fragment   (е )
+            // Fragment별로 별도 저장 (패딩 없음)
             fragmentData[index].resize(size);
             memcpy(fragmentData[index].data(), data, size);
             recvFragments[index] = true;
@@ -83,7 +83,7 @@ namespace jam::net
 		~FragmentManager() = default;
 
 
-		xvector<Sptr<SendBuffer>>		Fragmentize(const Sptr<SendBuffer>& buf, const PacketAnalysis& analysis);
+		xvector<SendBufferRef>			Fragmentize(const SendBufferRef& buf, const PacketAnalysis& analysis);
 		std::pair<bool, xvector<BYTE>>	OnRecvFragment(BYTE* buf, uint16 size);
 
 	private:
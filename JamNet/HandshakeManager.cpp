@@ -103,7 +103,7 @@ namespace jam::net
 	//		m_retryCount.store(0);
 	//		break;
 	//	case eHandshakeState::DISCONNECTED:
-	//		if (oldState != eHandshakeState::TIME_WAIT)	// TIME_WAIT  ȯ  쿡 ݹ ȣ
+	//		if (oldState != eHandshakeState::TIME_WAIT)	// TIME_WAIT 에서 전환되지 않은 경우에만 콜백 호출
 	//		{
 	//			m_owner->OnLinkTerminated();
 	//		}
@@ -273,11 +273,11 @@ namespace jam::net
 	//		TransitionToState(eHandshakeState::DISCONNECT_FIN_RECEIVED);
 	//		SendDisconnectFinAck();
 	//		break;
-	//	case eHandshakeState::DISCONNECT_FIN_SENT:	//  
+	//	case eHandshakeState::DISCONNECT_FIN_SENT:	// 동시 종료
 	//		TransitionToState(eHandshakeState::CLOSING);
 	//		SendDisconnectFinAck();
 	//		break;
-	//	case eHandshakeState::TIME_WAIT:	// TIME_WAIT  ߺ FIN  - ٽ ACK 
+	//	case eHandshakeState::TIME_WAIT:	// TIME_WAIT 중 중복 FIN 수신 - 다시 ACK 전송
 	//		SendDisconnectAck();
 	//		break;
 	//	default:
@@ -310,7 +310,7 @@ namespace jam::net
 	//		TransitionToState(eHandshakeState::DISCONNECT_FINACK_RECEIVED);
 	//		SendDisconnectAck();
 	//		break;
-	//	case eHandshakeState::CLOSING:	//  ῡ FINACK 
+	//	case eHandshakeState::CLOSING:	// 동시 종료에서 FINACK 수신
 	//		SendDisconnectAck();
 	//		EnterTimeWait();
 	//		break;
@@ -330,7 +330,7 @@ namespace jam::net
 
 	//	if (state == eHandshakeState::DISCONNECT_FINACK_RECEIVED)
 	//	{
-	//		EnterTimeWait();	// ɵ   ACK   TIME_WAIT 
+	//		EnterTimeWait();	// 능동 종료측에서 마지막 ACK 전송 후 TIME_WAIT 진입
 	//	}
 
 	//	m_lastHandshakeTime.store(Clock::Instance().GetCurrentTick());
@@ -341,13 +341,13 @@ namespace jam::net
 	//	switch (eHandshakeState state = m_state.load())
 	//	{
 	//	case eHandshakeState::DISCONNECT_FINACK_SENT:
-	//		//   ACK  -  
+	//		// 수동 종료측에서 ACK 수신 - 즉시 종료
 	//		TransitionToState(eHandshakeState::DISCONNECTED);
-	//		m_owner->OnLinkTerminated(); //   Ϸ
+	//		m_owner->OnLinkTerminated(); // 연결 종료 완료
 	//		break;
 
 	//	case eHandshakeState::TIME_WAIT:
-	//		// TIME_WAIT  ߺ ACK -  (Ÿ̸  )
+	//		// TIME_WAIT 중 중복 ACK - 무시 (타이머 리셋하지 않음)
 	//		break;
 	//	default:
 	//		break;
@@ -365,7 +365,7 @@ namespace jam::net
 	//void HandshakeManager::HandleTimeWaitTimeout()
 	//{
 	//	TransitionToState(eHandshakeState::DISCONNECTED);
-	//	m_owner->OnLinkTerminated(); //   Ϸ
+	//	m_owner->OnLinkTerminated(); // 연결 종료 완료
 	//}
 
 	//bool HandshakeManager::IsTimeWaitExpired(uint64 currentTick) const
@@ -2,13 +2,13 @@
 
 namespace jam::net
 {
-	////	 (ɵ ) :
+	////	정상 종료(능동 종료측) :
 	////	CONNECTED->FIN_SENT->FINACK_RECEIVED->TIME_WAIT->DISCONNECTED
 
-	////	 ( ) :
+	////	정상 종료(수동 종료측) :
 	////	CONNECTED->FIN_RECEIVED->FINACK_SENT->DISCONNECTED
 
-	////	  :
+	////	동시 종료 :
 	////	CONNECTED->FIN_SENT->CLOSING->TIME_WAIT->DISCONNECTED
 
 
@@ -1,12 +1,12 @@
 #pragma once
 #include "IocpCore.h"
 #include "NetAddress.h"
+#include "SendBuffer.h"
 
 namespace jam::net
 {
 	class Session;
 	class TcpSession;
-	class SendBuffer;
 
 	enum class eEventType : uint8
 	{
@@ -89,12 +89,12 @@ namespace jam::net
 		SendEvent() : IocpEvent(eEventType::Send) {}
 
 	public:
-		//  /   ϳ 
+		// 단일 / 다중 중 하나만 사용
 		bool                         use_gather = false;
-		WSABUF                       single{};          //  
-		xvector<WSABUF>              gather;            // S/G 
+		WSABUF                       single{};          // 단일 경로
+		xvector<WSABUF>              gather;            // S/G 경로
 
-		xvector<Sptr<SendBuffer>>    sendBuffers;       //   
+		xvector<SendBufferRef>       sendBuffers;       // 데이터 생존 보장
 		NetAddress                   remoteAddress;
 	};
 }
\ No newline at end of file
@@ -19,4 +19,23 @@ enum class eSessionState : uint8
 {
 	Connect = 0,
 	Disconnect,
-};
\ No newline at end of file
+};
+
+// per-session idempotent requests (Mailbox::PostCoalesced): at most one of each queued
+enum class eCoalesceKey : uint8
+{
+	TX_FLUSH = 0,
+
+	COUNT
+};
+
+// OverloadController stages, cumulative: each one keeps shedding what the ones below it shed
+enum class eShedStage : uint8
+{
+	NONE = 0,
+	REJECT_HANDSHAKE,		// new UDP peers are not admitted
+	DROP_UNRELIABLE,		// best-effort sends (unreliable, non-system) are dropped
+	THROTTLE_IDLE,			// idle sessions' per-tick stats run every idleTickStride ticks
+
+	COUNT
+};
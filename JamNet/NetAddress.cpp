@@ -35,7 +35,7 @@ namespace jam::net
 		//IN_ADDR address = {};
 		//if (::InetPtonW(AF_INET, ip, &address) != 1)
 		//{
-		//	//   α  0.0.0.0 ȯ
+		//	// 실패 시 로그 남기고 0.0.0.0 반환
 		//	//::wprintf(L"InetPtonW failed for IP: %s\n", ip);
 		//	address.s_addr = INADDR_ANY;
 		//}
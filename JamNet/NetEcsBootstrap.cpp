@@ -7,9 +7,103 @@
 #include "EcsFragment.hpp"
 #include "EcsHandshake.hpp"
 #include "EcsNetstat.hpp"
+#include "EcsTransport.hpp"
+#include "EcsGroup.hpp"
+#include "EcsEventBus.hpp"
+#include "Session.h"
 
 namespace jam::net::ecs
 {
+    namespace
+    {
+        using utils::exec::EntityParcel;
+
+        /*---- migration : a session entity moving to another shard (GlobalExecutor resize) ----*/
+
+        // component + the pool store behind its handle; the life observer hands out the new handle
+        template<typename Comp, EcsHandle Comp::* HandleMember, typename StoreT, EcsHandlePool<StoreT> EcsHandlePools::* PoolMember>
+        void PackWithStore(entt::registry& R, entt::entity e, EntityParcel& parcel)
+        {
+            Comp* comp = R.try_get<Comp>(e);
+            if (comp == nullptr)
+                return;
+
+            StoreT store{};
+            if (auto* pools = R.ctx().find<EcsHandlePools>())
+            {
+                if (StoreT* st = (pools->*PoolMember).get(comp->*HandleMember))
+                    store = std::move(*st);
+            }
+
+            Comp moved = std::move(*comp);
+            moved.*HandleMember = EcsHandle::invalid();
+            parcel.Add([c = std::move(moved), st = std::move(store)](entt::registry& to, entt::entity dst) mutable
+                {
+                    auto& placed = to.emplace_or_replace<Comp>(dst, std::move(c));
+                    if (StoreT* target = (to.ctx().get<EcsHandlePools>().*PoolMember).get(placed.*HandleMember))
+                        *target = std::move(st);
+                });
+        }
+
+        void PackGroupMembership(entt::registry& R, entt::entity e, EntityParcel& parcel)
+        {
+            const auto* gm = R.try_get<CompGroupMembership>(e);
+            auto* gi = R.ctx().find<GroupIndex>();
+            if (gm != nullptr && gi != nullptr)
+            {
+                for (uint64 gid : gm->groups)
+                {
+                    auto it = gi->members.find(gid);
+                    if (it == gi->members.end())
+                        continue;
+                    std::erase(it->second, e);
+                    if (it->second.empty())
+                        gi->members.erase(it);
+                }
+            }
+            utils::exec::EntityMigrator::PackComponent<CompGroupMembership>(R, e, parcel);
+        }
+
+        void OnEntityMigrated(entt::registry& R, entt::entity e)
+        {
+            if (const auto* gm = R.try_get<CompGroupMembership>(e))
+            {
+                if (auto* gi = R.ctx().find<GroupIndex>())
+                {
+                    for (uint64 gid : gm->groups)
+                        gi->members[gid].push_back(e);
+                }
+            }
+
+            if (const auto* ref = R.try_get<SessionRef>(e))
+            {
+                if (auto session = ref->wp.lock())
+                    session->OnEntityMigrated(e);
+            }
+        }
+
+        void InstallMigration(utils::exec::EntityMigrator& M)
+        {
+            M.Register<SessionRef>();
+            M.Register<MailboxRef>();
+            M.Register<utils::exec::RouteKey>();
+            M.Register<SessionKey>();
+            M.Register<CompEndpoint>();
+
+            M.Register(&PackWithStore<CompReliability, &CompReliability::hStore, ReliabilityStore, &EcsHandlePools::reliability>);
+            M.Register(&PackWithStore<CompFragment, &CompFragment::hStore, FragmentStore, &EcsHandlePools::fragments>);
+            M.Register(&PackWithStore<CompChannel, &CompChannel::hStore, ChannelStore, &EcsHandlePools::channels>);
+
+            M.Register<CompNetstat>();
+            M.Register<CompHandshake>();
+            M.Register<CompCongestion>();
+            M.Register<CompTransportTx>();
+            M.Register(&PackGroupMembership);
+
+            M.OnAdopted(&OnEntityMigrated);
+        }
+    }
+
     void InstallLifeObserver(entt::registry& R)
     {
         struct LifeObsInstalled {};
@@ -37,21 +131,32 @@ namespace jam::net::ecs
         R.ctx().emplace<LifeObsInstalled>();
     }
 
-    void RegisterNetEcs(utils::exec::ShardLocal& L, Service* svc)
+    void RegisterNetEcs(utils::exec::ShardLocal& L, Service* svc, const utils::exec::EventBusConfig& busConfig)
 	{
 		L.world.ctx().emplace<Service*>(svc);
+		L.world.ctx().emplace<OverloadController*>(svc ? svc->GetOverloadController() : nullptr);	// nullptr: no shedding
+		L.world.ctx().emplace<NetstatClock>();
 
-        L.systems.push_back(&HandshakeWiringSystem);
-        L.systems.push_back(&ChannelWiringSystem);
-        L.systems.push_back(&FragmentWiringSystem);
-        L.systems.push_back(&NetstatWiringSystem);
-        L.systems.push_back(&CongestionControlWiringSystem);
+        // event bus: handlers reach it through the registry as well
+        auto& bus = L.events.Install<NetEventBus>(busConfig);
+        L.world.ctx().emplace<NetEventBus*>(&bus);
 
-        L.systems.push_back(&HandshakeTickSystem);
-        L.systems.push_back(&ChannelTickSystem);
-        L.systems.push_back(&NetstatTickSystem);
+        // wiring: binds handlers to the event bus, exclusive
+        L.systems.Add(&HandshakeWiringSystem, "HandshakeWiring");
+        L.systems.Add(&ChannelWiringSystem, "ChannelWiring");
+        L.systems.Add(&FragmentWiringSystem, "FragmentWiring");
+        L.systems.Add(&NetstatWiringSystem, "NetstatWiring");
+        L.systems.Add(&CongestionControlWiringSystem, "CongestionControlWiring");
+
+        // handshake tick sends (emplaces CompTransportTx, enqueues events) and channel tick
+        // calls back into the session: both stay exclusive
+        L.systems.Add(&HandshakeTickSystem, "HandshakeTick");
+        L.systems.Add(&ChannelTickSystem, "ChannelTick");
+        L.systems.Add(&NetstatTickSystem, "NetstatTick").Writes<CompNetstat>();
 
         L.world.ctx().emplace<EcsHandlePools>();
         InstallLifeObserver(L.world);              
+
+        InstallMigration(L.migrator);
 	}
 }
@@ -3,7 +3,7 @@
 
 namespace jam::net::ecs
 {
-    // Comp::*(EcsHandle)  EcsHandlePools::* (EcsHandlePool<Store>) ø ڷ 
+    // Comp::*(EcsHandle) 과 EcsHandlePools::* (EcsHandlePool<Store>)를 템플릿 인자로 받음
     template<typename Comp, EcsHandle Comp::* HandleMember, typename StoreT, EcsHandlePool<StoreT> EcsHandlePools::* PoolMember>
     static void OnConstruct_Handle(entt::registry& R, entt::entity e)
 	{
@@ -34,5 +34,5 @@ namespace jam::net::ecs
 
 
 	inline void InstallLifeObserver(entt::registry& R);
-	inline void RegisterNetEcs(utils::exec::ShardLocal& L, Service* svc);
+	inline void RegisterNetEcs(utils::exec::ShardLocal& L, Service* svc, const utils::exec::EventBusConfig& busConfig = {});
 }
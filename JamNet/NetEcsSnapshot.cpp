@@ -0,0 +1,422 @@
+#include "pch.h"
+#include "NetEcsSnapshot.h"
+
+#include "EcsCommon.hpp"
+#include "EcsHandle.h"
+#include "EcsReliability.hpp"
+#include "EcsChannel.hpp"
+#include "EcsCongestionControl.hpp"
+#include "EcsFragment.hpp"
+#include "EcsHandshake.hpp"
+#include "EcsNetstat.hpp"
+#include "Clock.h"
+#include "GlobalExecutor.h"
+
+namespace jam::net::ecs
+{
+    using utils::exec::SnapshotLoadContext;
+    using utils::exec::SnapshotReader;
+    using utils::exec::SnapshotWriter;
+
+    namespace
+    {
+        constexpr uint64 PARK_SWEEP_INTERVAL_NS = 1'000'000'000_ns;
+
+        /*---- fixups : timestamps of the old process, handles of the old pools ----*/
+
+        void FixHandshake(CompHandshake& c, const SnapshotLoadContext& ctx)
+        {
+            c.lastHsTime_ns = ctx.Rebase(c.lastHsTime_ns);
+            c.timeWaitStart_ns = ctx.Rebase(c.timeWaitStart_ns);
+        }
+
+        // stores are re-allocated by the life observer on emplace; reliability refills its own below
+        void FixReliability(CompReliability& c, const SnapshotLoadContext& ctx)
+        {
+            c.firstPendingAckTime_ns = ctx.Rebase(c.firstPendingAckTime_ns);
+            c.lastNackTime_ns = ctx.Rebase(c.lastNackTime_ns);
+            c.hStore = EcsHandle::invalid();
+        }
+
+        void FixChannel(CompChannel& c, const SnapshotLoadContext&)
+        {
+            c.hStore = EcsHandle::invalid();
+        }
+
+        void FixFragment(CompFragment& c, const SnapshotLoadContext&)
+        {
+            c.hStore = EcsHandle::invalid();
+        }
+
+        void FixNetstat(CompNetstat& c, const SnapshotLoadContext& ctx)
+        {
+            c.rttProbeSend_ns = ctx.Rebase(c.rttProbeSend_ns);
+        }
+
+        /*---- ReliabilityStore : unacked packets survive the restart ----*/
+
+        // per entity: id, lastAckedSeq, pending {seq, size, timestamp, retry, bytes}, dupAckCount, sentNackSeqs
+        void SaveReliabilityStores(const entt::registry& R, SnapshotWriter& w, OUT uint32& count)
+        {
+            count = 0;
+            const auto* storage = R.storage<CompReliability>();
+            const auto* pools = R.ctx().find<EcsHandlePools>();
+            if (storage == nullptr || pools == nullptr)
+                return;
+
+            for (auto [e, cr] : storage->each())
+            {
+                const ReliabilityStore* st = pools->reliability.get(cr.hStore);
+                if (st == nullptr)
+                    continue;
+
+                ++count;
+                w.Write(e);
+                w.Write(st->lastAckedSeq);
+
+                w.Write(static_cast<uint32>(st->pending.size()));
+                for (const auto& [seq, info] : st->pending)
+                {
+                    w.Write(seq);
+                    w.Write(info.size);
+                    w.Write(info.timestamp);
+                    w.Write(info.retryCount);
+                    const bool hasBuffer = info.buffer != nullptr;
+                    w.WriteBytes(hasBuffer ? info.buffer->Buffer() : nullptr, hasBuffer ? info.buffer->WriteSize() : 0);
+                }
+
+                w.Write(static_cast<uint32>(st->dupAckCount.size()));
+                for (const auto& [seq, n] : st->dupAckCount)
+                {
+                    w.Write(seq);
+                    w.Write(n);
+                }
+
+                w.Write(static_cast<uint32>(st->sentNackSeqs.size()));
+                for (uint16 seq : st->sentNackSeqs)
+                    w.Write(seq);
+            }
+        }
+
+        bool LoadReliabilityStores(entt::registry& R, SnapshotReader& r, uint32 count, SnapshotLoadContext& ctx)
+        {
+            auto& pools = R.ctx().get<EcsHandlePools>();
+
+            for (uint32 i = 0; i < count; ++i)
+            {
+                entt::entity saved = entt::null;
+                uint16 lastAckedSeq = 0;
+                uint32 pendingCount = 0;
+                if (!r.Read(saved) || !r.Read(lastAckedSeq) || !r.Read(pendingCount))
+                    return false;
+
+                // the CompReliability column was loaded first, so the entity has a fresh store
+                const entt::entity e = ctx.Resolve(R, saved);
+                const CompReliability* cr = R.try_get<CompReliability>(e);
+                ReliabilityStore* st = cr ? pools.reliability.get(cr->hStore) : nullptr;
+                if (st == nullptr)
+                    return false;
+
+                st->lastAckedSeq = lastAckedSeq;
+
+                for (uint32 k = 0; k < pendingCount; ++k)
+                {
+                    uint16 seq = 0;
+                    PendingPacketInfo info = {};
+                    uint32 bytes = 0;
+                    if (!r.Read(seq) || !r.Read(info.size) || !r.Read(info.timestamp) || !r.Read(info.retryCount))
+                        return false;
+                    const uint8* data = r.ReadBytes(OUT bytes);
+                    if (data == nullptr)
+                        return false;
+
+                    info.timestamp = ctx.Rebase(info.timestamp);
+                    if (bytes > 0)
+                    {
+                        info.buffer = SendBufferManager::Instance().Open(bytes);
+                        ::memcpy(info.buffer->Buffer(), data, bytes);
+                        info.buffer->Close(bytes);
+                    }
+                    st->pending[seq] = std::move(info);
+                }
+
+                uint32 dupCount = 0;
+                if (!r.Read(dupCount))
+                    return false;
+                for (uint32 k = 0; k < dupCount; ++k)
+                {
+                    uint16 seq = 0;
+                    uint32 n = 0;
+                    if (!r.Read(seq) || !r.Read(n))
+                        return false;
+                    st->dupAckCount[seq] = n;
+                }
+
+                uint32 nackCount = 0;
+                if (!r.Read(nackCount))
+                    return false;
+                for (uint32 k = 0; k < nackCount; ++k)
+                {
+                    uint16 seq = 0;
+                    if (!r.Read(seq))
+                        return false;
+                    st->sentNackSeqs.insert(seq);
+                }
+            }
+            return true;
+        }
+
+        /*---- parked keys : which shard holds a restored session ----*/
+
+        // process-wide; touched on restore, claim and expiry only
+        struct ParkedIndex
+        {
+            Mutex                   lock;
+            xumap<uint64, uint32>   shardOf;    // SessionKey -> shard index
+        };
+
+        ParkedIndex& GetParkedIndex()
+        {
+            static ParkedIndex index;
+            return index;
+        }
+
+        void IndexParked(uint64 key, uint32 shardIndex)
+        {
+            auto& index = GetParkedIndex();
+            LockGuard guard(index.lock);
+            index.shardOf[key] = shardIndex;
+        }
+
+        void UnindexParked(uint64 key)
+        {
+            auto& index = GetParkedIndex();
+            LockGuard guard(index.lock);
+            index.shardOf.erase(key);
+        }
+
+        bool FindParked(uint64 key, OUT uint32& shardIndex)
+        {
+            auto& index = GetParkedIndex();
+            LockGuard guard(index.lock);
+            auto it = index.shardOf.find(key);
+            if (it == index.shardOf.end())
+                return false;
+            shardIndex = it->second;
+            return true;
+        }
+
+        // restored state -> live entity. Handles are swapped with the rest, so the live entity keeps
+        // the restored stores and the fresh ones are freed with the parked entity.
+        template<typename... C>
+        void SwapComponents(entt::registry& R, entt::entity live, entt::entity parked)
+        {
+            ([&]
+            {
+                C* a = R.try_get<C>(live);
+                C* b = R.try_get<C>(parked);
+                if (a && b)
+                    std::swap(*a, *b);
+            }(), ...);
+        }
+
+        void AdoptState(entt::registry& R, entt::entity live, entt::entity parked)
+        {
+            SwapComponents<CompHandshake, CompReliability, CompChannel, CompFragment, CompCongestion, CompNetstat>(R, live, parked);
+            R.destroy(parked);
+        }
+
+        // takes the entity parked under key off this shard; null if it expired or was claimed already
+        entt::entity Unpark(entt::registry& R, uint64 key)
+        {
+            auto* parked = R.ctx().find<ParkedSessions>();
+            if (parked == nullptr)
+                return entt::null;
+
+            auto it = parked->byKey.find(key);
+            if (it == parked->byKey.end())
+                return entt::null;
+
+            const entt::entity e = it->second;
+            parked->byKey.erase(it);
+            UnindexParked(key);
+            return e;
+        }
+
+        // parking shard thread: the state leaves as a parcel, adopted on the session's shard
+        void HandOverParked(utils::exec::ShardLocal& L, uint64 key, const Sptr<utils::exec::Mailbox>& replyTo, entt::entity live)
+        {
+            const entt::entity old = Unpark(L.world, key);
+            if (old == entt::null)
+                return;
+
+            auto parcel = utils::memory::MakeShared<utils::exec::EntityParcel>(L.migrator.Pack(L.world, old));
+            L.world.destroy(old);
+
+            (void)replyTo->Post(utils::job::Job([mb = replyTo, parcel, key, live]
+                {
+                    auto shard = mb->GetOwner();
+                    if (shard == nullptr)
+                        return;
+
+                    // a resize moved the session meanwhile: the state is dropped with the parcel
+                    auto& R = shard->Local().world;
+                    const SessionKey* sk = R.valid(live) ? R.try_get<SessionKey>(live) : nullptr;
+                    if (sk == nullptr || sk->value != key)
+                        return;
+
+                    const entt::entity temp = R.create();
+                    parcel->Apply(R, temp);
+                    AdoptState(R, live, temp);
+                }), utils::exec::eMailboxChannel::CTRL);
+        }
+    }
+
+    utils::exec::SnapshotSchema BuildNetSnapshotSchema()
+    {
+        // restore order: SessionKey first (it names the session), the store section after its column
+        utils::exec::SnapshotSchema schema;
+        schema.AddComponent<SessionKey>("SessionKey")
+              .AddComponent<CompHandshake, &FixHandshake>("CompHandshake")
+              .AddComponent<CompReliability, &FixReliability>("CompReliability")
+              .AddComponent<CompChannel, &FixChannel>("CompChannel")
+              .AddComponent<CompFragment, &FixFragment>("CompFragment")
+              .AddComponent<CompCongestion>("CompCongestion")
+              .AddComponent<CompNetstat, &FixNetstat>("CompNetstat")
+              .AddSection("ReliabilityStore", &SaveReliabilityStores, &LoadReliabilityStores);
+        return schema;
+    }
+
+    uint32 InstallNetSnapshot(utils::exec::ShardLocal& L, const std::filesystem::path& path, uint32 shardIndex,
+                              utils::exec::GlobalExecutor* io, uint64 interval_ns, uint64 parkTimeout_ns)
+    {
+        auto& R = L.world;
+        const uint64 now_ns = utils::Clock::Instance().NowNs();
+
+        auto& state = R.ctx().emplace<NetSnapshotState>();
+        state.snapshot = utils::memory::MakeShared<utils::exec::ShardSnapshot>(BuildNetSnapshotSchema(), path, shardIndex);
+        state.io = io;
+        state.interval_ns = interval_ns;
+        state.next_ns = now_ns + interval_ns;
+
+        uint32 restored = 0;
+        if (state.snapshot->Restore(R, OUT restored) && restored > 0)
+        {
+            // no endpoint yet: tick systems skip parked entities until a session claims them.
+            // Never named (no RebindRouteKey before the save): nothing can claim it
+            auto& parked = R.ctx().emplace<ParkedSessions>();
+
+            xvector<entt::entity> unnamed;
+            for (auto e : R.view<CompHandshake>())
+            {
+                const SessionKey* key = R.try_get<SessionKey>(e);
+                if (key == nullptr || key->value == 0)
+                {
+                    unnamed.push_back(e);
+                    continue;
+                }
+
+                R.emplace<CompParked>(e, now_ns + parkTimeout_ns);
+                parked.byKey[key->value] = e;
+                IndexParked(key->value, shardIndex);
+            }
+            R.destroy(unnamed.begin(), unnamed.end());
+            parked.nextSweep_ns = now_ns + PARK_SWEEP_INTERVAL_NS;
+
+            LOG_INFO("snapshot: shard {} restored {} entities from {}, {} parked", shardIndex, restored, path.string(), parked.byKey.size());
+        }
+
+        // a parked entity waits for its session here, not on the shard its key moves to
+        L.migrator.Pin<CompParked>();
+
+        L.systems.Add(&SnapshotAdoptSystem, "SnapshotAdopt");
+        L.systems.Add(&SnapshotCaptureSystem, "SnapshotCapture");
+        return restored;
+    }
+
+    bool SaveNetSnapshot(utils::exec::ShardLocal& L)
+    {
+        auto* state = L.world.ctx().find<NetSnapshotState>();
+        return state != nullptr && state->snapshot->Save(L.world);
+    }
+
+    bool BindSessionKey(utils::exec::ShardLocal& L, entt::entity e, uint64 sessionKey)
+    {
+        if (e == entt::null)
+            return false;
+
+        auto& R = L.world;
+        if (!R.valid(e))
+            return true;     // closed meanwhile
+
+        R.emplace_or_replace<SessionKey>(e, sessionKey);
+
+        // parked here: adopt in place
+        const entt::entity local = Unpark(R, sessionKey);
+        if (local != entt::null)
+        {
+            AdoptState(R, e, local);
+            return true;
+        }
+
+        uint32 home = 0;
+        if (!FindParked(sessionKey, OUT home))
+            return true;
+
+        // parked on another shard: it sends the state back through the session's mailbox
+        Service** service = R.ctx().find<Service*>();
+        const MailboxRef* mb = R.try_get<MailboxRef>(e);
+        if (service == nullptr || *service == nullptr || mb == nullptr || mb->mailbox == nullptr)
+            return true;
+
+        auto dir = (*service)->GetGlobalExecutor()->GetDirectory();
+        auto shard = dir ? dir->ShardAt(home) : nullptr;
+        if (shard == nullptr)
+            return true;
+
+        shard->Submit(utils::job::Job([shard, sessionKey, reply = mb->mailbox, e]
+            {
+                HandOverParked(shard->Local(), sessionKey, reply, e);
+            }));
+        return true;
+    }
+
+    void SnapshotAdoptSystem(utils::exec::ShardLocal& L, uint64 now_ns, uint64 dt_ns)
+    {
+        auto& R = L.world;
+        auto* parked = R.ctx().find<ParkedSessions>();
+        if (parked == nullptr)
+            return;
+
+        // claims come through BindSessionKey; this pass only lets unclaimed state expire
+        if (now_ns >= parked->nextSweep_ns)
+        {
+            parked->nextSweep_ns = now_ns + PARK_SWEEP_INTERVAL_NS;
+
+            xvector<entt::entity> expired;
+            for (auto [e, p, key] : R.view<CompParked, SessionKey>().each())
+            {
+                if (p.expire_ns <= now_ns)
+                {
+                    parked->byKey.erase(key.value);
+                    UnindexParked(key.value);
+                    expired.push_back(e);
+                }
+            }
+            R.destroy(expired.begin(), expired.end());
+        }
+
+        if (parked->byKey.empty())
+            R.ctx().erase<ParkedSessions>();
+    }
+
+    void SnapshotCaptureSystem(utils::exec::ShardLocal& L, uint64 now_ns, uint64 dt_ns)
+    {
+        auto* state = L.world.ctx().find<NetSnapshotState>();
+        if (state == nullptr || state->interval_ns == 0 || now_ns < state->next_ns)
+            return;
+
+        state->next_ns = now_ns + state->interval_ns;
+        state->snapshot->Capture(L.world, state->io);
+    }
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include "EcsSnapshot.h"
+
+namespace jam::net::ecs
+{
+    // State restored from a snapshot, waiting for its session to bind again.
+    // A returning session is matched by SessionKey, the key it was rebound to (Session::RebindRouteKey):
+    // stable across a restart when ServiceConfig::routeSeed is fixed and the session id is stable.
+    // The state is parked on the shard that saved it and handed to whichever shard the session lands on.
+    struct CompParked
+    {
+        uint64                      expire_ns = 0;
+    };
+
+    struct ParkedSessions
+    {
+        xumap<uint64, entt::entity> byKey;              // SessionKey -> parked entity
+        uint64                      nextSweep_ns = 0;
+    };
+
+    struct NetSnapshotState
+    {
+        Sptr<utils::exec::ShardSnapshot>    snapshot;
+        utils::exec::GlobalExecutor*        io = nullptr;
+        uint64                              interval_ns = 0;    // 0: Service::SaveSnapshots() only
+        uint64                              next_ns = 0;
+    };
+
+    utils::exec::SnapshotSchema     BuildNetSnapshotSchema();
+
+    // Before the shard serves sessions: restores the shard's file (if any), parks what was restored and
+    // registers the adopt/capture systems. Returns the number of restored entities.
+    uint32  InstallNetSnapshot(utils::exec::ShardLocal& L, const std::filesystem::path& path, uint32 shardIndex,
+                               utils::exec::GlobalExecutor* io, uint64 interval_ns, uint64 parkTimeout_ns);
+
+    // shard thread, blocking
+    bool    SaveNetSnapshot(utils::exec::ShardLocal& L);
+
+    // session's shard thread: names the live entity e with its session key and claims the state parked
+    // under it, from whichever shard holds it. False while e is not created yet (retry on the next pass).
+    bool    BindSessionKey(utils::exec::ShardLocal& L, entt::entity e, uint64 sessionKey);
+
+    void    SnapshotAdoptSystem(utils::exec::ShardLocal& L, uint64 now_ns, uint64 dt_ns);
+    void    SnapshotCaptureSystem(utils::exec::ShardLocal& L, uint64 now_ns, uint64 dt_ns);
+}
@@ -7,17 +7,17 @@ namespace jam::net
 
 	//struct NetStat
 	//{
- //       double      rtt = 0.0;              // RTT հ (tick)
- //       double      rttVariance = 0.0;      // RTT л,   Ȱ
- //       double      jitter = 0.0;           //   (RTT ȭ)
+ //       double      rtt = 0.0;              // RTT 평균값 (tick)
+ //       double      rttVariance = 0.0;      // RTT 분산, 지터 측정에 활용
+ //       double      jitter = 0.0;           // 지터 추정값 (RTT 변화율)
  //       double      margin = 0.5;
  //       int64       tickOffset = 0;
 
- //       //float       packetLossSend = 0.0f;   // ۽  սǷ (%)
- //       //float       packetLossRecv = 0.0f;   //   սǷ (%)
+ //       //float       packetLossSend = 0.0f;   // 송신 기준 손실률 (%)
+ //       //float       packetLossRecv = 0.0f;   // 수신 기준 손실률 (%)
 
-	//	float       bandwidthSend = 0.0f;    // ʴ ۽ŷ (bytes/sec)
- //       float       bandwidthRecv = 0.0f;    // ʴ ŷ (bytes/sec)
+	//	float       bandwidthSend = 0.0f;    // 초당 송신량 (bytes/sec)
+ //       float       bandwidthRecv = 0.0f;    // 초당 수신량 (bytes/sec)
  //       //uint64      totalSent = 0;
  //       //uint64      totalRecv = 0;
  //       //uint64      totalLost = 0;
@@ -35,7 +35,7 @@ namespace jam::net
  //       uint64      piggybackAcks = 0;
  //       uint64      immediateAcks = 0;
  //       uint64      delayedAcks = 0;
-	//	float       ackEfficiency = 0.0f; // ACK ȿ (۽ŵ ACK /  ۽ŷ)
+	//	float       ackEfficiency = 0.0f; // ACK 효율성 (송신된 ACK / 총 송신량)
 	//};
 
     //struct ChannelStat
@@ -117,7 +117,7 @@ namespace jam::net
   //      uint64              m_highestSeqSeen = 0;
   //      uint64              m_lastAckedSeq = 0;
 
-		//uint64              m_ackSendAccum = 0; // ACK ۽ŷ 
+		//uint64              m_ackSendAccum = 0; // ACK 송신량 누적
   //  };
 }
 
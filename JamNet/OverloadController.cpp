@@ -0,0 +1,162 @@
+#include "pch.h"
+#include "OverloadController.h"
+#include "ShardExecutor.h"
+#include "MemoryManager.h"
+
+namespace jam::net
+{
+	namespace
+	{
+		const char* ShedStageName(eShedStage stage)
+		{
+			switch (stage)
+			{
+			case eShedStage::NONE:				return "none";
+			case eShedStage::REJECT_HANDSHAKE:	return "reject-handshake";
+			case eShedStage::DROP_UNRELIABLE:	return "drop-unreliable";
+			case eShedStage::THROTTLE_IDLE:		return "throttle-idle";
+			default:							return "?";
+			}
+		}
+	}
+
+	OverloadController::OverloadController(const OverloadConfig& config)
+		: m_config(config)
+	{
+		m_config.escalatePeriods = (std::max)(m_config.escalatePeriods, 1u);
+		m_config.relaxPeriods = (std::max)(m_config.relaxPeriods, 1u);
+		if (m_config.memoryHighBytes > 0 && (m_config.memoryLowBytes <= 0 || m_config.memoryLowBytes > m_config.memoryHighBytes))
+			m_config.memoryLowBytes = m_config.memoryHighBytes / 10 * 9;
+	}
+
+	void OverloadController::Step(const std::vector<Sptr<utils::exec::ShardExecutor>>& shards, uint64 elapsed_ns)
+	{
+		if (elapsed_ns == 0)
+			return;
+
+		if (m_states.size() < shards.size())
+			m_states.resize(shards.size());
+
+		// worst shard decides: one swamped shard is enough to hurt the players on it
+		uint64 waitP99 = 0;
+		float overrun = 0.f;
+		for (size_t i = 0; i < shards.size(); ++i)
+		{
+			if (!shards[i])
+				continue;
+
+			utils::exec::ShardMetrics& metrics = shards[i]->Metrics();
+			ShardState& st = m_states[i];
+
+			uint64 samples = 0;
+			waitP99 = (std::max)(waitP99, metrics.readyWait.TakeQuantile(0.99f, st.waitCursor, OUT samples));
+
+			const uint64 ticks = metrics.ticks.load(std::memory_order_relaxed);
+			const uint64 overruns = metrics.tickOverruns.load(std::memory_order_relaxed);
+			if (ticks < st.lastTicks)
+			{
+				// a new shard under a reused index: its counters start over
+				st.lastTicks = 0;
+				st.lastOverruns = 0;
+			}
+
+			const uint64 periodTicks = ticks - st.lastTicks;
+			const uint64 periodOverruns = overruns - st.lastOverruns;
+			st.lastTicks = ticks;
+			st.lastOverruns = overruns;
+
+			if (periodTicks > 0)
+				overrun = (std::max)(overrun, static_cast<float>(periodOverruns) / static_cast<float>(periodTicks));
+		}
+
+		const bool watchMemory = m_config.memoryHighBytes > 0;
+		const int64 memory = watchMemory ? utils::memory::MemoryManager::Instance().GetStats().LiveBytes() : 0;
+
+		m_lastWaitP99_ns.store(waitP99, std::memory_order_relaxed);
+		m_lastTickOverrun.store(overrun, std::memory_order_relaxed);
+		m_lastMemoryBytes.store(memory, std::memory_order_relaxed);
+
+		const bool hot = waitP99 > m_config.waitP99High_ns
+			|| overrun > m_config.tickOverrunHigh
+			|| (watchMemory && memory > m_config.memoryHighBytes);
+		const bool calm = waitP99 <= m_config.waitP99Low_ns
+			&& overrun <= m_config.tickOverrunLow
+			&& (!watchMemory || memory <= m_config.memoryLowBytes);
+
+		const uint8 stage = m_stage.load(std::memory_order_relaxed);
+		if (hot)
+		{
+			m_calmPeriods = 0;
+			if (++m_hotPeriods >= m_config.escalatePeriods)
+			{
+				m_hotPeriods = 0;
+				if (stage + 1 < E2U(eShedStage::COUNT))
+					SetStage(U2E(eShedStage, stage + 1));
+			}
+		}
+		else if (calm)
+		{
+			m_hotPeriods = 0;
+			if (++m_calmPeriods >= m_config.relaxPeriods)
+			{
+				m_calmPeriods = 0;
+				if (stage > E2U(eShedStage::NONE))
+					SetStage(U2E(eShedStage, stage - 1));
+			}
+		}
+		else
+		{
+			// between the marks: the current stage is holding the load, keep it
+			m_hotPeriods = 0;
+			m_calmPeriods = 0;
+		}
+	}
+
+	bool OverloadController::AdmitHandshake()
+	{
+		if (!IsShedding(eShedStage::REJECT_HANDSHAKE))
+			return true;
+
+		m_rejectedHandshakes.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	bool OverloadController::DropUnreliable()
+	{
+		if (!IsShedding(eShedStage::DROP_UNRELIABLE))
+			return false;
+
+		m_droppedUnreliable.fetch_add(1, std::memory_order_relaxed);
+		return true;
+	}
+
+	OverloadStats OverloadController::GetStats() const
+	{
+		OverloadStats stats;
+		stats.stage = GetStage();
+		for (uint32 i = 0; i < E2U(eShedStage::COUNT); ++i)
+			stats.enteredStage[i] = m_enteredStage[i].load(std::memory_order_relaxed);
+
+		stats.rejectedHandshakes = m_rejectedHandshakes.load(std::memory_order_relaxed);
+		stats.droppedUnreliable = m_droppedUnreliable.load(std::memory_order_relaxed);
+		stats.throttledTicks = m_throttledTicks.load(std::memory_order_relaxed);
+
+		stats.waitP99_ns = m_lastWaitP99_ns.load(std::memory_order_relaxed);
+		stats.tickOverrun = m_lastTickOverrun.load(std::memory_order_relaxed);
+		stats.memoryBytes = m_lastMemoryBytes.load(std::memory_order_relaxed);
+		return stats;
+	}
+
+	void OverloadController::SetStage(eShedStage next)
+	{
+		const eShedStage prev = GetStage();
+		m_stage.store(E2U(next), std::memory_order_relaxed);
+		m_enteredStage[E2U(next)].fetch_add(1, std::memory_order_relaxed);
+
+		LOG_WARN("overload: stage {} -> {} (wait p99 {} us, tick overrun {:.2f}, memory {} B)",
+			ShedStageName(prev), ShedStageName(next),
+			m_lastWaitP99_ns.load(std::memory_order_relaxed) / 1000,
+			m_lastTickOverrun.load(std::memory_order_relaxed),
+			m_lastMemoryBytes.load(std::memory_order_relaxed));
+	}
+}
@@ -0,0 +1,98 @@
+#pragma once
+#include "AutoTuner.h"
+
+namespace jam::utils::exec
+{
+	class ShardExecutor;
+}
+
+namespace jam::net
+{
+	struct OverloadConfig
+	{
+		uint64		period_ns = 250'000'000_ns;			// one controller step per period
+
+		// pressure signals, each with a high (hot) and low (calm) mark; between the two: hold
+		uint64		waitP99High_ns = 10'000'000_ns;		// worst shard, mailbox ready -> serviced
+		uint64		waitP99Low_ns = 4'000'000_ns;
+		float		tickOverrunHigh = 0.2f;				// worst shard, overrun ticks / ticks in the period
+		float		tickOverrunLow = 0.05f;
+		int64		memoryHighBytes = 0;				// MemoryStats::LiveBytes; 0: not watched
+		int64		memoryLowBytes = 0;					// 0: 90% of memoryHighBytes
+
+		// quick to shed, slow to readmit: existing players' latency comes first
+		uint32		escalatePeriods = 2;				// hot this many periods in a row: one stage up
+		uint32		relaxPeriods = 20;					// calm this many periods in a row: one stage down
+
+		uint32		idleTickStride = 8;					// THROTTLE_IDLE: idle sessions run every Nth tick
+	};
+
+	struct OverloadStats
+	{
+		eShedStage		stage = eShedStage::NONE;
+		uint64			enteredStage[E2U(eShedStage::COUNT)] = {};	// transitions into each stage, up or down
+		uint64			rejectedHandshakes = 0;		// datagrams from unknown peers dropped
+		uint64			droppedUnreliable = 0;
+		uint64			throttledTicks = 0;			// idle session ticks skipped
+
+		uint64			waitP99_ns = 0;				// last period's signals
+		float			tickOverrun = 0.f;
+		int64			memoryBytes = 0;
+	};
+
+	/*------------------------
+		OverloadController
+	-------------------------*/
+
+	// Staged admission control (ServiceConfig::loadShedding). Every period it reads the shards'
+	// ready-wait p99 and tick overruns, and live memory; when any signal stays hot the stage goes
+	// up by one (eShedStage), when all stay calm it comes down by one. Readers on the hot paths
+	// (handshake, send, netstat tick) load the stage relaxed; every transition is counted and logged.
+	class OverloadController
+	{
+	public:
+		explicit OverloadController(const OverloadConfig& config);
+
+		// one controller step; elapsed_ns since the previous step
+		void				Step(const std::vector<Sptr<utils::exec::ShardExecutor>>& shards, uint64 elapsed_ns);
+
+		eShedStage			GetStage() const { return U2E(eShedStage, m_stage.load(std::memory_order_relaxed)); }
+		bool				IsShedding(eShedStage stage) const { return E2U(GetStage()) >= E2U(stage); }
+
+		// hot paths: false / true / 1 outside their stage
+		bool				AdmitHandshake();
+		bool				DropUnreliable();
+		uint32				GetIdleTickStride() const { return IsShedding(eShedStage::THROTTLE_IDLE) ? (std::max)(m_config.idleTickStride, 1u) : 1; }
+		void				RecordThrottledTicks(uint64 count) { m_throttledTicks.fetch_add(count, std::memory_order_relaxed); }
+
+		const OverloadConfig& GetConfig() const { return m_config; }
+		OverloadStats		GetStats() const;
+
+	private:
+		struct ShardState
+		{
+			utils::exec::WaitHistogram::Cursor	waitCursor;
+			uint64								lastTicks = 0;
+			uint64								lastOverruns = 0;
+		};
+
+		void				SetStage(eShedStage next);
+
+	private:
+		OverloadConfig								m_config;
+		std::vector<ShardState>						m_states;		// controller thread only
+		uint32										m_hotPeriods = 0;
+		uint32										m_calmPeriods = 0;
+
+		Atomic<uint8>								m_stage{ E2U(eShedStage::NONE) };
+		std::array<Atomic<uint64>, E2U(eShedStage::COUNT)>	m_enteredStage{};
+
+		Atomic<uint64>								m_rejectedHandshakes{ 0 };
+		Atomic<uint64>								m_droppedUnreliable{ 0 };
+		Atomic<uint64>								m_throttledTicks{ 0 };
+
+		Atomic<uint64>								m_lastWaitP99_ns{ 0 };
+		Atomic<float>								m_lastTickOverrun{ 0.f };
+		Atomic<int64>								m_lastMemoryBytes{ 0 };
+	};
+}
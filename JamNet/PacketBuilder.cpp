@@ -5,35 +5,35 @@
 
 namespace jam::net
 {
-	Sptr<SendBuffer> PacketBuilder::CreatePacket(ePacketType type, uint8 id, uint8 flags, eChannelType channel, const void* payload, uint32 payloadSize, uint16 seq, uint8 fragIndex, uint8 fragTotal)
+	SendBufferRef PacketBuilder::CreatePacket(ePacketType type, uint8 id, uint8 flags, eChannelType channel, const void* payload, uint32 payloadSize, uint16 seq, uint8 fragIndex, uint8 fragTotal)
 	{
 		return CreatePacketInternal(E2U(type), id, flags, E2U(channel), payload, payloadSize, seq, fragIndex, fragTotal);
 	}
 
-	Sptr<SendBuffer> PacketBuilder::CreateSystemPacket(eSystemPacketId id, uint8 flags, eChannelType channel, const void* payload, uint32 payloadSize, uint16 seq)
+	SendBufferRef PacketBuilder::CreateSystemPacket(eSystemPacketId id, uint8 flags, eChannelType channel, const void* payload, uint32 payloadSize, uint16 seq)
 	{
 		return CreatePacketInternal(E2U(ePacketType::SYSTEM), E2U(id), flags, E2U(channel), payload, payloadSize, seq);
 	}
 
-	Sptr<SendBuffer> PacketBuilder::CreateHandshakePacket(eSystemPacketId id)
+	SendBufferRef PacketBuilder::CreateHandshakePacket(eSystemPacketId id)
 	{
 		return CreateSystemPacket(id, PacketFlags::NONE, eChannelType::RELIABLE_ORDERED, nullptr, 0);
 	}
 
-	Sptr<SendBuffer> PacketBuilder::CreatePingPacket(const PING& ping, uint16 seq)
+	SendBufferRef PacketBuilder::CreatePingPacket(const PING& ping, uint16 seq)
 	{
 		return CreateSystemPacket(eSystemPacketId::PING, PacketFlags::NONE, eChannelType::UNRELIABLE_SEQUENCED, &ping, sizeof(ping), seq);
 	}
 
-	Sptr<SendBuffer> PacketBuilder::CreatePongPacket(const PONG& pong, uint16 seq)
+	SendBufferRef PacketBuilder::CreatePongPacket(const PONG& pong, uint16 seq)
 	{
 		return CreateSystemPacket(eSystemPacketId::PING, PacketFlags::NONE, eChannelType::UNRELIABLE_SEQUENCED, &pong, sizeof(pong), seq);
 	}
 
-	Sptr<SendBuffer> PacketBuilder::CreateReliabilityAckPacket(uint16 seq, uint32 bitfield)
+	SendBufferRef PacketBuilder::CreateReliabilityAckPacket(uint16 seq, uint32 bitfield)
 	{
 		constexpr uint32 size = sizeof(PacketHeader) + sizeof(AckHeader);
-		Sptr<SendBuffer> buf = SendBufferManager::Instance().Open(size);
+		SendBufferRef buf = SendBufferManager::Instance().Open(size);
 		BufferWriter bw(buf->Buffer(), buf->AllocSize());
 
 		// todo
@@ -43,12 +43,12 @@ namespace jam::net
 		return buf;
 	}
 
-	Sptr<SendBuffer> PacketBuilder::CreateNackPacket(uint16 seq, uint32 bitfield)
+	SendBufferRef PacketBuilder::CreateNackPacket(uint16 seq, uint32 bitfield)
 	{
-		return Sptr<SendBuffer>();
+		return SendBufferRef();
 	}
 
-	Sptr<SendBuffer> PacketBuilder::CreateRpcPacket(eRpcPacketId id, uint8 flags, uint8 channel, const void* payload, uint32 payloadSize, uint16 seq)
+	SendBufferRef PacketBuilder::CreateRpcPacket(eRpcPacketId id, uint8 flags, uint8 channel, const void* payload, uint32 payloadSize, uint16 seq)
 	{
 		return CreatePacketInternal(E2U(ePacketType::RPC), E2U(id), flags, channel, payload, payloadSize, seq);
 	}
@@ -112,7 +112,7 @@ namespace jam::net
 
 
 
-	Sptr<SendBuffer> PacketBuilder::CreatePacketInternal(uint8 type, uint8 id, uint8 flags, uint8 channel, const void* payload, uint32 payloadSize, uint16 seq, uint8 fragIndex, uint8 fragTotal)
+	SendBufferRef PacketBuilder::CreatePacketInternal(uint8 type, uint8 id, uint8 flags, uint8 channel, const void* payload, uint32 payloadSize, uint16 seq, uint8 fragIndex, uint8 fragTotal)
 	{
 		bool isReliable = HasReliable(U2E(eChannelType, channel));
 		bool isFragmented = HasFlag(flags, PacketFlags::FRAGMENTED);
@@ -129,10 +129,10 @@ namespace jam::net
 		const uint32 totalSize = headerSize + payloadSize;
 		const uint32 allocSize = isFragmented ? totalSize : totalSize + sizeof(AckHeader);
 
-		Sptr<SendBuffer> buf = SendBufferManager::Instance().Open(allocSize);
+		SendBufferRef buf = SendBufferManager::Instance().Open(allocSize);
 		BufferWriter bw(buf->Buffer(), buf->AllocSize());
 
-		// todo : size  ؼ ִ°  ȵ
+		// todo : size를 직접 계산해서 넣는게 맘에 안듦
 		PacketHeader header(type, id, totalSize, flags, channel, seq, fragIndex, fragTotal);
 
 		bw.WriteBytes(&header, headerSize);
@@ -202,25 +202,25 @@ namespace jam::net
 	class PacketBuilder
 	{
 	public:
-		static Sptr<SendBuffer> CreatePacket(ePacketType type, uint8 id, uint8 flags = PacketFlags::NONE, eChannelType channel = eChannelType::UNRELIABLE_UNORDERED, const void* payload = nullptr, uint32 payloadSize = 0, uint16 seq = 0, uint8 fragIndex = 0, uint8 fragTotal = 0);
+		static SendBufferRef CreatePacket(ePacketType type, uint8 id, uint8 flags = PacketFlags::NONE, eChannelType channel = eChannelType::UNRELIABLE_UNORDERED, const void* payload = nullptr, uint32 payloadSize = 0, uint16 seq = 0, uint8 fragIndex = 0, uint8 fragTotal = 0);
 
 		// System Packets
-		static Sptr<SendBuffer> CreateSystemPacket(eSystemPacketId id, uint8 flags = PacketFlags::NONE, eChannelType channel = eChannelType::UNRELIABLE_UNORDERED, const void* payload = nullptr, uint32 payloadSize = 0, uint16 seq = 0);
+		static SendBufferRef CreateSystemPacket(eSystemPacketId id, uint8 flags = PacketFlags::NONE, eChannelType channel = eChannelType::UNRELIABLE_UNORDERED, const void* payload = nullptr, uint32 payloadSize = 0, uint16 seq = 0);
 
-		static Sptr<SendBuffer> CreateHandshakePacket(eSystemPacketId id);
-		static Sptr<SendBuffer> CreatePingPacket(const PING& ping, uint16 seq);
-		static Sptr<SendBuffer> CreatePongPacket(const PONG& pong, uint16 seq);
+		static SendBufferRef CreateHandshakePacket(eSystemPacketId id);
+		static SendBufferRef CreatePingPacket(const PING& ping, uint16 seq);
+		static SendBufferRef CreatePongPacket(const PONG& pong, uint16 seq);
 
 		// Ack Packets
-		static Sptr<SendBuffer> CreateAckPacket(eAckPacketId id, const void* payload = nullptr, uint32 payloadSize = 0, uint16 seq = 0);
+		static SendBufferRef CreateAckPacket(eAckPacketId id, const void* payload = nullptr, uint32 payloadSize = 0, uint16 seq = 0);
 
-		static Sptr<SendBuffer> CreateReliabilityAckPacket(uint16 seq, uint32 bitfield);
-		static Sptr<SendBuffer> CreateNackPacket(uint16 seq, uint32 bitfield);
+		static SendBufferRef CreateReliabilityAckPacket(uint16 seq, uint32 bitfield);
+		static SendBufferRef CreateNackPacket(uint16 seq, uint32 bitfield);
 		// Rpc Packets
-		static Sptr<SendBuffer> CreateRpcPacket(eRpcPacketId id, uint8 flags = PacketFlags::NONE, uint8 channel, const void* payload = nullptr, uint32 payloadSize = 0, uint16 seq = 0);
+		static SendBufferRef CreateRpcPacket(eRpcPacketId id, uint8 flags = PacketFlags::NONE, uint8 channel, const void* payload = nullptr, uint32 payloadSize = 0, uint16 seq = 0);
 
 		// Custom Packets
-		static Sptr<SendBuffer> CreateCustomPacket();
+		static SendBufferRef CreateCustomPacket();
 
 
 		static PacketAnalysis	AnalyzePacket(BYTE* buf, uint32 size);
@@ -233,7 +233,7 @@ namespace jam::net
 
 
 	private:
-		static Sptr<SendBuffer> CreatePacketInternal(uint8 type, uint8 id, uint8 flags, uint8 channel, const void* payload, uint32 payloadSize, uint16 seq = 0, uint8 fragIndex = 0, uint8 fragTotal = 0);
+		static SendBufferRef CreatePacketInternal(uint8 type, uint8 id, uint8 flags, uint8 channel, const void* payload, uint32 payloadSize, uint16 seq = 0, uint8 fragIndex = 0, uint8 fragTotal = 0);
 	};
 }
 
@@ -64,7 +64,7 @@ namespace jam::net
 		}
 	}
 
-	void ReliableTransportManager::AddPendingPacket(uint16 seq, const Sptr<SendBuffer>& buf, uint64 timestamp)
+	void ReliableTransportManager::AddPendingPacket(uint16 seq, const SendBufferRef& buf, uint64 timestamp)
 	{
 		m_pendingPackets[seq] = { buf, buf->WriteSize(), timestamp, 0 };
 		m_inFlightSize += buf->WriteSize();
@@ -110,11 +110,11 @@ namespace jam::net
 		m_latestSeq = IsSeqGreator(seq, m_latestSeq) ? seq : m_latestSeq;
 
 		//temp
-		// ӵ Ŷ expectedNextSeq Ʈ
+		// 연속된 패킷만 expectedNextSeq 업데이트
 		if (seq == m_expectedNextSeq)
 		{
 			m_expectedNextSeq++;
-			// ӵ  Ŷ鵵 üũ
+			// 연속된 다음 패킷들도 체크
 			while (m_receiveHistory.test(m_expectedNextSeq % WINDOW_SIZE))
 			{
 				m_expectedNextSeq++;
@@ -190,7 +190,7 @@ namespace jam::net
 		return m_hasPendingAck && (currentTick - m_firstPendingAckTick) >= MAX_DELAY_TICK_PIGGYBACK_ACK;
 	}
 
-	bool ReliableTransportManager::TryAttachPiggybackAck(const Sptr<SendBuffer>& buf)
+	bool ReliableTransportManager::TryAttachPiggybackAck(const SendBufferRef& buf)
 	{
 		if (!m_hasPendingAck)
 			return false;
@@ -231,10 +231,10 @@ namespace jam::net
 
 	void ReliableTransportManager::OnRecvNack(uint16 missingSeq, uint32 bitfield)
 	{
-		// NACK û Ŷ  
+		// NACK로 요청된 패킷들 즉시 재전송
 		TriggerFastRTX(missingSeq);
 
-		// Ʈʵ ߰  Ŷ鵵 
+		// 비트필드의 추가 누락 패킷들도 재전송
 		for (uint16 i = 1; i <= 32; ++i)
 		{
 			if (bitfield & (1 << (i - 1)))
@@ -247,7 +247,7 @@ namespace jam::net
 
 	void ReliableTransportManager::CheckFastRTX(uint16 ackSeq)
 	{
-		if (!IsSeqGreator(ackSeq, m_lastAckedSeq))  // ų  
+		if (!IsSeqGreator(ackSeq, m_lastAckedSeq))  // 같거나 작은 경우
 		{
 			m_duplicateAckCount[ackSeq]++;
 
@@ -260,7 +260,7 @@ namespace jam::net
 		}
 		else
 		{
-			// ο ACK  ߺ īƮ 
+			// 새로운 ACK인 경우 중복 카운트 리셋
 			m_duplicateAckCount.clear();
 			m_lastAckedSeq = ackSeq;
 		}
@@ -271,13 +271,13 @@ namespace jam::net
 		auto it = m_pendingPackets.find(seq);
 		if (it != m_pendingPackets.end())
 		{
-			//   (ŸӾƿ  )
+			// 즉시 재전송 (타임아웃 대기 없음)
 			m_owner->SendDirect(it->second.buffer);
 			it->second.retryCount++;
 			it->second.timestamp = Clock::Instance().GetCurrentTick();
 
-			m_owner->GetNetStatManager()->OnFastRTX(); //  ߰
-			m_owner->GetCongestionController()->OnFastRTX(); // ȥ 
+			m_owner->GetNetStatManager()->OnFastRTX(); // 통계 추가
+			m_owner->GetCongestionController()->OnFastRTX(); // 혼잡 제어
 		}
 	}
 
@@ -312,14 +312,14 @@ namespace jam::net
 	{
 		uint64 now = Clock::Instance().GetCurrentTick();
 
-		// NACK    ( NACK )
+		// NACK 전송 간격 제한 (과도한 NACK 방지)
 		if (now - m_lastNackTime < NACK_THROTTLE_INTERVAL)
 			return false;
 
 		if (m_sentNackSeqs.contains(expectedSeq))
 			return false;
 
-		// Gap  ũ ̻  NACK 
+		// Gap이 일정 크기 이상일 때만 NACK 전송
 		return IsSeqGreator(receivedSeq, expectedSeq + 1);
 	}
 }
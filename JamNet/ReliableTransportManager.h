@@ -12,7 +12,7 @@ namespace jam::net
 
 	struct PendingPacketInfo
 	{
-		Sptr<SendBuffer>	buffer;
+		SendBufferRef		buffer;
 		uint32				size;
 		uint64				timestamp;
 		uint32				retryCount = 0;
@@ -37,7 +37,7 @@ namespace jam::net
 		uint16			GetNextSendSeq() { return m_sendSeq.fetch_add(1, std::memory_order_relaxed); }
 		uint16			AllocateSequnceRange(uint8 count) { return m_sendSeq.fetch_add(count, std::memory_order_relaxed); }
 
-		void			AddPendingPacket(uint16 seq, const Sptr<SendBuffer>& buf, uint64 timestamp);
+		void			AddPendingPacket(uint16 seq, const SendBufferRef& buf, uint64 timestamp);
 
 		// Recv
 		uint32			GenerateAckBitfield(uint16 latestSeq) const;
@@ -55,7 +55,7 @@ namespace jam::net
 		bool			HasPendingAck() const { return m_hasPendingAck; }
 		void			ClearPendingAck();
 		bool			ShouldSendImmediateAck(uint64 currentTick);
-		bool			TryAttachPiggybackAck(const Sptr<SendBuffer>& buf);
+		bool			TryAttachPiggybackAck(const SendBufferRef& buf);
 		void			FailedAttachPiggybackAck();
 
 		uint16			GetPendigAckSeq() const { return m_pendingAckSeq; }
@@ -99,13 +99,13 @@ namespace jam::net
 
 		// Fast RTX
 		constexpr static uint32 DUPLICATE_ACK_THRESHOLD = 3;
-		xumap<uint16, uint32>   m_duplicateAckCount;    //  ߺ ACK īƮ
-		uint16                  m_lastAckedSeq = 0;     //  ACK 
+		xumap<uint16, uint32>   m_duplicateAckCount;    // 시퀀스별 중복 ACK 카운트
+		uint16                  m_lastAckedSeq = 0;     // 마지막으로 ACK된 시퀀스
 
 		// NACK
-		uint16                  m_expectedNextSeq = 1;  //    Ǵ 
-		uint64                  m_lastNackTime = 0;     //  NACK  ð
-		constexpr static uint64 NACK_THROTTLE_INTERVAL = 10; // NACK   
+		uint16                  m_expectedNextSeq = 1;  // 다음에 받을 것으로 예상되는 시퀀스
+		uint64                  m_lastNackTime = 0;     // 마지막 NACK 전송 시간
+		constexpr static uint64 NACK_THROTTLE_INTERVAL = 10; // NACK 전송 간격 제한
 
 		xuset<uint16>			m_sentNackSeqs;
 	};
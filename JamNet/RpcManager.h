@@ -55,9 +55,9 @@ namespace jam::net
 #pragma pack(push, 1)
 	struct RpcHeader
 	{
-		uint16 rpcId;        //  RPC
-		uint32 requestId;    //  Ī
-		uint8  flags;        // : isResponse, isReliable, isCompressed 
+		uint16 rpcId;        // 어떤 RPC인지
+		uint32 requestId;    // 응답 매칭용
+		uint8  flags;        // 예: isResponse, isReliable, isCompressed 등
 	};
 #pragma pack(pop)
 
@@ -211,7 +211,7 @@ namespace jam::net
 			RegisterAwait(requestId, [currentFiber, &result](const BYTE* data, size_t len) {
 					if (Serializer::Deserialize(data, static_cast<uint32>(len), result)) {
 
-						Sptr<utils::job::Job> job = utils::memory::MakeShared<utils::job::Job>([currentFiber]() {
+						Sptr<utils::job::Job> job = utils::memory::MakeShared<utils::job::Job, utils::memory::eMemTag::JOB>([currentFiber]() {
 								currentFiber->SwitchTo();
 							});
 						utils::thrd::tl_Worker->GetCurrentJobQueue()->Push(job);
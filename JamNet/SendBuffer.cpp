@@ -45,7 +45,7 @@ namespace jam::net
 		m_usedSize = 0;
 	}
 
-	Sptr<SendBuffer> SendBufferChunk::Open(uint32 allocSize)
+	SendBufferRef SendBufferChunk::Open(uint32 allocSize)
 	{
 		ASSERT_CRASH(allocSize <= SEND_BUFFER_CHUNK_SIZE);
 		ASSERT_CRASH(m_open == false);
@@ -55,7 +55,7 @@ namespace jam::net
 
 		m_open = true;
 
-		return utils::memory::ObjectPool<SendBuffer>::MakeShared(shared_from_this(), Buffer(), allocSize);
+		return utils::memory::MakeRef<SendBuffer>(shared_from_this(), Buffer(), allocSize);
 	}
 
 	void SendBufferChunk::Close(uint32 writeSize)
@@ -73,7 +73,21 @@ namespace jam::net
 	   SendBufferManager
 	----------------------*/
 
-	Sptr<SendBuffer> SendBufferManager::Open(uint32 size)
+	void SendBufferManager::Init(bool hugePages, int32 prefaultChunks)
+	{
+		// every service calls this: the first one decides
+		if (m_initialized.exchange(true))
+			return;
+
+		// the arena only on request: chunks never go back to the OS once carved from it
+		if (hugePages)
+			m_arena.Init(true);
+
+		for (int32 i = 0; i < prefaultChunks; i++)
+			Push(WrapChunk(NewChunk()));	// construction zero-fills -> pages faulted in
+	}
+
+	SendBufferRef SendBufferManager::Open(uint32 size)
 	{
 		if (tl_SendBufferChunk == nullptr)
 		{
@@ -103,7 +117,18 @@ namespace jam::net
 				return sendBufferChunk;
 			}
 		}
-		return Sptr<SendBufferChunk>(utils::memory::xnew<SendBufferChunk>(), PushGlobal);
+		return WrapChunk(NewChunk());
+	}
+
+	SendBufferChunk* SendBufferManager::NewChunk()
+	{
+		if (m_arena.IsEnabled())
+		{
+			if (void* memory = m_arena.Alloc(sizeof(SendBufferChunk), alignof(SendBufferChunk)))
+				return new(memory)SendBufferChunk();
+		}
+
+		return utils::memory::xnew<SendBufferChunk, utils::memory::eMemTag::NET_SEND_BUFFER>();
 	}
 
 	void SendBufferManager::Push(Sptr<SendBufferChunk> buffer)
@@ -114,7 +139,13 @@ namespace jam::net
 
 	void SendBufferManager::PushGlobal(SendBufferChunk* buffer)
 	{
-		SendBufferManager::Instance().Push(Sptr<SendBufferChunk>(buffer, PushGlobal));
+		SendBufferManager::Instance().Push(WrapChunk(buffer));
+	}
+
+	Sptr<SendBufferChunk> SendBufferManager::WrapChunk(SendBufferChunk* buffer)
+	{
+		// a chunk is re-wrapped on every recycle: keep that control block off the global heap
+		return Sptr<SendBufferChunk>(buffer, PushGlobal, utils::memory::StlAllocator<SendBufferChunk>());
 	}
 
 }
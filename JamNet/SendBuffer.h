@@ -8,8 +8,12 @@ namespace jam::net
 	-----------------*/
 
 	class SendBufferChunk;
+	class SendBuffer;
 
-	class SendBuffer : public enable_shared_from_this<SendBuffer>
+	// one per packet, copied into every send job and queue: intrusive count, pooled object
+	using SendBufferRef = utils::memory::RefPtr<SendBuffer>;
+
+	class SendBuffer : public utils::memory::RefCounted<SendBuffer>
 	{
 	public:
 		SendBuffer(Sptr<SendBufferChunk> owner, BYTE* buffer, int32 allocSize);
@@ -43,7 +47,7 @@ namespace jam::net
 		~SendBufferChunk();
 
 		void										Reset();
-		Sptr<SendBuffer>							Open(uint32 allocSize);
+		SendBufferRef								Open(uint32 allocSize);
 		void										Close(uint32 writeSize);
 
 		bool										IsOpen() { return m_open; }
@@ -67,16 +71,26 @@ namespace jam::net
 		DECLARE_SINGLETON(SendBufferManager)
 
 	public:
-		Sptr<SendBuffer>							Open(uint32 size);
+		// hugePages: carve chunks out of 2 MB pages; prefaultChunks: build this many up front.
+		// called from the Service constructor (ServiceConfig::memoryCfg)
+		void										Init(bool hugePages, int32 prefaultChunks = 0);
+
+		SendBufferRef								Open(uint32 size);
 
 	private:
 		Sptr<SendBufferChunk>						Pop();
+		SendBufferChunk*							NewChunk();
 		void										Push(Sptr<SendBufferChunk> buffer);
 		static void									PushGlobal(SendBufferChunk* buffer);
+		static Sptr<SendBufferChunk>				WrapChunk(SendBufferChunk* buffer);
 
 	private:
 		USE_LOCK
 		xvector<Sptr<SendBufferChunk>>				m_sendBufferChunks;
+
+		// chunks are recycled forever (PushGlobal), so arena memory is never handed back
+		utils::memory::HugePageArena				m_arena;
+		Atomic<bool>								m_initialized = false;
 	};
 
 
@@ -65,16 +65,16 @@ namespace jam::net
         template<typename T>
         static SerializationResult Serialize(const T& src);
 
-        // ȭ (÷̽ -  ü )
+        // 역직렬화 (인플레이스 - 기존 객체에 복사)
         template<typename T>
         static bool Deserialize(const BYTE* src, uint32 size, OUT T& dst);
 
-        // ȭ ( ȯ - ޸ ȿ)
+        // 역직렬화 (포인터 반환 - 메모리 효율적)
         template<typename T>
         static DeserializationResult DeserializePtr(const BYTE* src, uint32 size);
 
     private:
-        // ŸԺ ȭ 
+        // 타입별 직렬화 구현
         template<typename T>
         static SerializationResult SerializeBinary(const T& src);
 
@@ -87,7 +87,7 @@ namespace jam::net
         template<typename T>
         static SerializationResult SerializeJson(const T& src);
 
-        // ŸԺ ȭ 
+        // 타입별 역직렬화 구현
         template<typename T>
         static bool DeserializeBinary(const BYTE* src, uint32 size, OUT T& dst);
 
@@ -122,7 +122,7 @@ namespace jam::net
         return { {}, false };
 	}
 
-    //  ȭ Լ (÷̽)
+    // 메인 역직렬화 함수 (인플레이스)
     template<typename T>
     bool Serializer::Deserialize(const BYTE* src, uint32 size, OUT T& dst)
     {
@@ -134,7 +134,7 @@ namespace jam::net
         }
         else if constexpr (type == eSerializationType::FLATBUFFER)
         {
-            // FlatBuffer ÷̽ ȭ  
+            // FlatBuffer는 인플레이스 역직렬화를 지원하지 않음
             auto result = DeserializeFlatBufferPtr<T>(src, size);
             if (result.success && result.objectPtr) 
             {
@@ -155,7 +155,7 @@ namespace jam::net
         return false;
     }
 
-    //  ȭ Լ ( ȯ)
+    // 메인 역직렬화 함수 (포인터 반환)
     template<typename T>
     DeserializationResult Serializer::DeserializePtr(const BYTE* src, uint32 size)
     {
@@ -174,12 +174,12 @@ namespace jam::net
         }
         else 
         {
-            // Protobuf JSON  ȯ    ( Ҵ ʿ)
+            // Protobuf와 JSON은 포인터 반환 방식을 지원하지 않음 (동적 할당 필요)
             return { .objectPtr= nullptr, .size= 0, .success= false};
         }
     }
 
-    // === Binary ȭ/ȭ ===
+    // === Binary 직렬화/역직렬화 ===
     template<typename T>
     SerializationResult Serializer::SerializeBinary(const T& src)
     {
@@ -203,7 +203,7 @@ namespace jam::net
         return true;
     }
 
-    // === FlatBuffer ȭ/ȭ ===
+    // === FlatBuffer 직렬화/역직렬화 ===
     template<typename T>
     SerializationResult Serializer::SerializeFlatBuffer(const T& src)
     {
@@ -228,7 +228,7 @@ namespace jam::net
         return { obj, size, true };
     }
 
-    // === Protobuf ȭ/ȭ ===
+    // === Protobuf 직렬화/역직렬화 ===
     template<typename T>
     SerializationResult Serializer::SerializeProtobuf(const T& src)
     {
@@ -258,7 +258,7 @@ namespace jam::net
 #endif
     }
 
-    // === JSON ȭ/ȭ ===
+    // === JSON 직렬화/역직렬화 ===
     template<typename T>
     SerializationResult Serializer::SerializeJson(const T& src)
     {
@@ -3,13 +3,20 @@
 #include <ranges>
 #include "Clock.h"
 #include "NetEcsBootstrap.h"
+#include "NetEcsSnapshot.h"
 
 namespace jam::net
 {
 	Service::Service(ServiceConfig config) : m_config(config)
 	{
+		// pools are normally up already (startup Init); this only adds the arena / prefault on top
+		utils::memory::MemoryManager::Instance().Init(m_config.memoryCfg);
+		SendBufferManager::Instance().Init(m_config.memoryCfg.hugePages, m_config.sendBufferPrefaultChunks);
+
 		m_iocpCore = std::make_unique<IocpCore>();
 		m_globalExecutor = std::make_unique<utils::exec::GlobalExecutor>(m_config.geConfig);
+		if (m_config.loadShedding)
+			m_overload = std::make_unique<OverloadController>(m_config.overloadCfg);
 	}
 
 	Service::~Service()
@@ -27,14 +34,60 @@ namespace jam::net
 
 		m_globalExecutor->Init();
 
+		if (!m_config.snapshotDir.empty())
+		{
+			std::error_code ec;
+			std::filesystem::create_directories(m_config.snapshotDir, ec);
+		}
+
 		// temp
-		auto& shards = m_globalExecutor->GetShards();
+		auto shards = m_globalExecutor->GetShards();
 		for (auto& shard : shards)
+			InstallShard(*shard);
+	}
+
+	void Service::InstallShard(utils::exec::ShardExecutor& shard)
+	{
+		ecs::RegisterNetEcs(shard.Local(), this, m_config.geConfig.shardCfg.eventBus);
+
+		if (!m_config.snapshotDir.empty())
 		{
-			ecs::RegisterNetEcs(shard->Local(), this);
+			const uint32 index = static_cast<uint32>(shard.GetIndex());
+			const std::filesystem::path path = std::filesystem::path(m_config.snapshotDir) / ("shard_" + std::to_string(index) + ".jsnap");
+			ecs::InstallNetSnapshot(shard.Local(), path, index, m_globalExecutor.get(), m_config.snapshotInterval_ns, m_config.snapshotParkTimeout_ns);
 		}
 	}
 
+	Sptr<utils::exec::ShardExecutor> Service::AddShard()
+	{
+		// modules are installed before the shard starts, so the first hand-over finds them
+		auto shard = m_globalExecutor->AddShard([this](utils::exec::ShardExecutor& s) { InstallShard(s); });
+		if (!shard)
+			return nullptr;
+
+		if (const uint64 period = m_updatePeriod_ns.load(std::memory_order_acquire); period != 0)
+			ScheduleShardTick(shard, period);
+		return shard;
+	}
+
+	bool Service::RemoveShard()
+	{
+		// the retired shard's tick chain ends by itself once it stops running
+		return m_globalExecutor->RemoveShard();
+	}
+
+	bool Service::SaveSnapshots()
+	{
+		if (m_config.snapshotDir.empty() || !m_globalExecutor)
+			return false;
+
+		auto saved = m_globalExecutor->MapReduce<bool>(
+			[](utils::exec::ShardExecutor& shard) { return ecs::SaveNetSnapshot(shard.Local()); },
+			[](bool acc, bool part) { return acc && part; },
+			true);
+		return saved->Get();
+	}
+
 
 	void Service::CloseService()
 	{
@@ -51,24 +104,44 @@ namespace jam::net
 	{
 		//m_running.store(true);
 		//m_lastUpdateTick = utils::Clock::Instance().GetCurrentTick();
-		auto& shards = m_globalExecutor->GetShards();
+		m_updatePeriod_ns.store(period_ns, std::memory_order_release);
+		auto shards = m_globalExecutor->GetShards();
 
 		for (auto& shard : shards)
-		{
-			Sptr<utils::exec::ShardExecutor> s = shard; //  ĸó
-			//   Լ ü
-			auto tick = std::make_shared<std::function<void()>>();
-			*tick = [this, s, period_ns, tick]()
-				{
-					const uint64 now = utils::Clock::Instance().NowNs();
-					s->Tick(now, period_ns);
-					//  ƽ 
-					m_globalExecutor->PostAfter(utils::job::Job([tick]() { (*tick)(); }), period_ns);
-				};
-
-			//  
-			m_globalExecutor->PostAfter(utils::job::Job([tick]() { (*tick)(); }), period_ns);
-		}
+			ScheduleShardTick(shard, period_ns);	// 최초 예약
+
+		if (m_overload)
+			ScheduleOverloadStep(utils::Clock::Instance().NowNs());
+	}
+
+	void Service::ScheduleShardTick(const Sptr<utils::exec::ShardExecutor>& s, uint64 period_ns)
+	{
+		m_globalExecutor->PostAfter(utils::job::Job([this, s, period_ns]()
+			{
+				// a removed shard stops its own chain
+				if (!s->IsRunning())
+					return;
+
+				// systems own the shard registry: run the tick on the shard thread
+				s->Submit(utils::job::Job([s, period_ns]()
+					{
+						s->Tick(utils::Clock::Instance().NowNs(), period_ns);
+					}));
+				// 다음 틱 예약
+				ScheduleShardTick(s, period_ns);
+			}), period_ns);
+	}
+
+	void Service::ScheduleOverloadStep(uint64 last_ns)
+	{
+		// the chain ends with the executor's timer at Stop
+		m_globalExecutor->PostAfter(utils::job::Job([this, last_ns]()
+			{
+				// IO worker: reads shard counters only, never blocks a shard
+				const uint64 now_ns = utils::Clock::Instance().NowNs();
+				m_overload->Step(m_globalExecutor->GetShards(), now_ns - last_ns);
+				ScheduleOverloadStep(now_ns);
+			}), m_config.overloadCfg.period_ns);
 	}
 
 	void Service::Update()
@@ -105,7 +178,7 @@ namespace jam::net
 
 		// todo
 		const uint64 connSalt = reinterpret_cast<uint64>(session.get()) ^ utils::Clock::Instance().NowNs();
-		const utils::exec::RouteKey tempKey = m_routing.KeyForSession(connSalt); // PerUser å ؽø ӽŰ 
+		const utils::exec::RouteKey tempKey = m_routing.KeyForSession(connSalt); // PerUser 정책의 해시를 임시키에도 재사용
 
 		session->AttachEndpoint(*dir, tempKey);
 
@@ -197,7 +270,12 @@ namespace jam::net
 		{
 			session = FindSessionInHandshaking(from);
 			if (!session)
+			{
+				// overloaded: the players already in come first, a new peer can retry later
+				if (m_overload && !m_overload->AdmitHandshake())
+					return;
 				session = CreateAndRegisterToHandshaking(from);
+			}
 		}
 
 		session->ProcessRecv(numOfBytes, recvBuffer);
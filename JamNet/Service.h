@@ -8,6 +8,7 @@
 #include "GlobalExecutor.h"
 
 #include "RoutingPolicy.h"
+#include "OverloadController.h"
 
 namespace jam::net
 {
@@ -21,9 +22,23 @@ namespace jam::net
 		int32								maxUdpSessionCount = 1;
 
 
+		// memory: huge-page pools / send buffer chunks, applied when the service is constructed
+		utils::memory::MemoryConfig			memoryCfg = {};
+		int32								sendBufferPrefaultChunks = 0;
+
 		// exec
 		utils::exec::RouteSeed				routeSeed = {0, 0};
 		utils::exec::GlobalExecutorConfig	geConfig = {};
+
+		// shard snapshots (empty dir: off). restored at Init, sessions reclaim their state when
+		// Session::RebindRouteKey names them again, which needs a fixed routeSeed
+		std::string							snapshotDir = {};
+		uint64								snapshotInterval_ns = 0;		// 0: SaveSnapshots() only
+		uint64								snapshotParkTimeout_ns = 30'000'000'000_ns;
+
+		// staged load shedding under overload (OverloadController)
+		bool								loadShedding = false;
+		OverloadConfig						overloadCfg = {};
 	};
 
 	class Service : public std::enable_shared_from_this<Service>
@@ -45,10 +60,16 @@ namespace jam::net
 		bool								CanStart() const { return m_tcpSessionFactory != nullptr || m_udpSessionFactory; }
 
 		virtual void						CloseService();
+		// blocks until every shard wrote its snapshot, for a planned restart
+		bool								SaveSnapshots();
 
 		void								StartUpdateLoop(uint64 period_ns = 1'000'000_ns);
 		void								Update();
 
+		// live resize: sessions whose key moves follow with their mailbox and entity
+		Sptr<utils::exec::ShardExecutor>	AddShard();
+		bool								RemoveShard();
+
 		template<typename TCP, typename UDP>
 		bool								SetSessionFactory();
 
@@ -63,7 +84,7 @@ namespace jam::net
 		void								CompleteUdpHandshake(const NetAddress& from);
 
 		Sptr<UdpSession>					FindSessionInConnected(const NetAddress& from);
-		Sptr<UdpSession>					FindSessionInHandshaking(const NetAddress& from);	// connection/disconnection иؾұ?
+		Sptr<UdpSession>					FindSessionInHandshaking(const NetAddress& from);	// connection/disconnection 분리해야할까?
 
 		Sptr<UdpSession>					CreateAndRegisterToHandshaking(const NetAddress& from);
 
@@ -86,6 +107,7 @@ namespace jam::net
 
 
 		utils::exec::GlobalExecutor*		GetGlobalExecutor() const { return m_globalExecutor.get(); }
+		OverloadController*					GetOverloadController() const { return m_overload.get(); }		// nullptr: loadShedding off
 
 
 	private:
@@ -94,6 +116,10 @@ namespace jam::net
 
 		void ProcessUpdate();
 
+		void								InstallShard(utils::exec::ShardExecutor& shard);
+		void								ScheduleShardTick(const Sptr<utils::exec::ShardExecutor>& s, uint64 period_ns);
+		void								ScheduleOverloadStep(uint64 last_ns);
+
 	protected:
 		USE_LOCK
 
@@ -123,10 +149,12 @@ namespace jam::net
 
 		Atomic<bool>										m_running{ false };
 		uint64												m_lastUpdateTick = 0;
+		Atomic<uint64>										m_updatePeriod_ns{ 0 };		// 0: update loop not started
 
 
 		utils::exec::RoutingPolicy							m_routing{ m_config.routeSeed };
 		Uptr<utils::exec::GlobalExecutor>					m_globalExecutor;
+		Uptr<OverloadController>							m_overload;
 	};
 
 
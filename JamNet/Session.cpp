@@ -24,7 +24,12 @@ namespace jam::net
 		if (m_endpoint) m_endpoint->PostCtrl(std::move(j));
 	}
 
-	// GE Ÿ̸   ش  routeKey  Job Post
+	void Session::PostCoalesced(eCoalesceKey key, utils::job::Job j, utils::exec::eMailboxChannel ch)
+	{
+		if (m_endpoint) m_endpoint->PostCoalesced(key, std::move(j), ch);
+	}
+
+	// GE 타이머 만료 시 해당 세션 routeKey 샤드로 Job Post
 	void Session::PostAfter(uint64 delay_ns, utils::job::Job j)
 	{
 		auto srvc = GetService();
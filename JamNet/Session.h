@@ -60,7 +60,7 @@ namespace jam::net
 
 		virtual bool							Connect() = 0;
 		virtual void							Disconnect(const WCHAR* cause) = 0;
-		virtual void							Send(const Sptr<SendBuffer>& sendBuffer) = 0;
+		virtual void							Send(const SendBufferRef& sendBuffer) = 0;
 
 		virtual void							Update() = 0;
 
@@ -83,12 +83,16 @@ namespace jam::net
 
 		void									Post(utils::job::Job job);
 		void									PostCtrl(utils::job::Job job);
+		void									PostCoalesced(eCoalesceKey key, utils::job::Job job, utils::exec::eMailboxChannel ch = utils::exec::eMailboxChannel::NORMAL);
 		void									PostAfter(uint64 delay_ns, utils::job::Job j);
 
 		void									JoinGroup(uint64 group_id, utils::exec::GroupHomeKey gk);
 		void									LeaveGroup(uint64 group_id, utils::exec::GroupHomeKey gk);
 		void									PostGroup(uint64 group_id, utils::exec::GroupHomeKey gk, utils::job::Job j);
 
+		// shard resize moved the session's entity (destination shard thread)
+		void									OnEntityMigrated(entt::entity e) { if (m_endpoint) m_endpoint->OnEntityMigrated(e); }
+
 
 	protected:
 		// application level callback
@@ -1,7 +1,7 @@
 #include "pch.h"
 #include "SessionEndpoint.h"
 
-// ECS Ʈ 
+// ECS 컴포넌트들 포함
 #include "EcsCommon.hpp"
 #include "EcsReliability.hpp"
 #include "EcsFragment.hpp"
@@ -10,15 +10,32 @@
 #include "EcsNetstat.hpp"
 #include "EcsCongestionControl.hpp"
 #include "EcsTransport.hpp"
+#include "NetEcsSnapshot.h"
 
 namespace jam::net
 {
+	static_assert(E2U(eCoalesceKey::COUNT) <= utils::exec::Mailbox::MAX_COALESCE_KEYS);
+
+	static constexpr uint64 DISCONNECT_ESCALATE_NS = 50'000'000_ns;		// behind queued sends at most this long
+
 	SessionEndpoint::SessionEndpoint(utils::exec::ShardDirectory& dir, utils::exec::RouteKey key)
 		: m_dir(&dir), m_key(key)
 	{
 		RefreshEnpoint();
 	}
 
+	SessionEndpoint::~SessionEndpoint()
+	{
+		// 샤드 레지스트리에서 제거 : queued jobs still run, the slot is recycled after they drain.
+		// closed first: a mailbox in transit between shards is removed by its new owner on arrival
+		if (!m_mailbox)
+			return;
+
+		m_mailbox->Close();
+		if (auto shard = m_mailbox->GetOwner())
+			shard->RemoveMailbox(m_mailbox->GetId());
+	}
+
 	void SessionEndpoint::Post(utils::job::Job j)
 	{
 		PostImpl(std::move(j), utils::exec::eMailboxChannel::NORMAL);
@@ -29,16 +46,21 @@ namespace jam::net
 		PostImpl(std::move(j), utils::exec::eMailboxChannel::CTRL);
 	}
 
+	void SessionEndpoint::PostCoalesced(eCoalesceKey key, utils::job::Job j, utils::exec::eMailboxChannel ch)
+	{
+		PostImpl(std::move(j), ch, E2U(key));
+	}
+
 	void SessionEndpoint::PostGroup(uint64 group_id, utils::exec::GroupHomeKey gk, utils::job::Job j)
 	{
 		if (m_closed.load(std::memory_order_acquire)) return;
 
-		// Ȩ  ε/ ͸ ̸  ĸó 
+		// 홈 샤드 인덱스/실행자 포인터를 미리 구해 캡처해 둠
 		const uint64 homeShard_id = m_dir->PickShard(gk.v);
 		auto home_shard = m_dir->ShardAt(homeShard_id);
 		if (!home_shard) return;
 
-		//   Ʈ(  )  TLS  this ȣ 
+		// 실행자 기반 엔드포인트(실행자 직접 지정)로 보내면 TLS 없어도 this 호출 가능
 		utils::exec::ShardEndpoint home_ep(home_shard);
 		(void)home_ep.Post(utils::job::Job([s = home_shard, group_id, jj = std::move(j)]() mutable {
 				s->OnGroupMulticastHome(group_id, std::move(jj));
@@ -58,10 +80,11 @@ namespace jam::net
 
 	void SessionEndpoint::EmitDisconnect()
 	{
-		Emit(ecs::EvHsDisconnect{});
+		// NORMAL lane: the FIN goes out after the sends queued before it, unless they stall
+		Post(std::move(MakeEmitJob(ecs::EvHsDisconnect{}).EscalateAfter(DISCONNECT_ESCALATE_NS)));
 	}
 
-	void SessionEndpoint::EmitSend(const Sptr<SendBuffer>& buf)
+	void SessionEndpoint::EmitSend(const SendBufferRef& buf)
 	{
 		Post(utils::job::Job([this, buf] { EnqueueSend(m_entitiy, buf, ecs::eTxReason::NORMAL); }));
 	}
@@ -74,6 +97,23 @@ namespace jam::net
 	{
 		m_key = newKey;
 		RefreshEnpoint();
+
+		// the entity keeps its mailbox's routing key; the new one names it (snapshot adoption)
+		PostSessionKey(newKey.value());
+	}
+
+	void SessionEndpoint::PostSessionKey(uint64 sessionKey)
+	{
+		PostCtrl(utils::job::Job([this, mb = m_mailbox, sessionKey]
+			{
+				auto sh = mb ? mb->GetOwner() : nullptr;
+				if (sh == nullptr)
+					return;
+
+				// the creating command has not applied yet: next pass
+				if (!ecs::BindSessionKey(sh->Local(), m_entitiy, sessionKey))
+					PostSessionKey(sessionKey);
+			}));
 	}
 
 	void SessionEndpoint::BeginDrain()
@@ -84,27 +124,27 @@ namespace jam::net
 	void SessionEndpoint::JoinGroup(uint64 group_id, utils::exec::GroupHomeKey gk)
 	{
 		if (m_closed.load(std::memory_order_acquire)) return;
-		EnsureBound(); //  Mailbox 
+		EnsureBound(); // 세션 Mailbox 보장
 
-		// 1)  ( routeKey )   
+		// 1) 내 샤드(세션 routeKey 기준)에서 로컬 가입 등록
 		const uint64 myShard_id = m_dir->PickShard(m_key.value());
 		auto my_shard = m_dir->ShardAt(myShard_id);
 		if (my_shard) 
 		{
-			auto q = m_mbNorm; // Normal ä 
-			my_shard->Submit(utils::job::Job([s = my_shard, group_id, q] {
-					s->OnGroupLocalJoin(group_id, q);
+			auto q = m_mailbox; // Normal 레인 수신
+			my_shard->Submit(utils::job::Job([s = my_shard, group_id, q, gk] {
+					s->OnGroupLocalJoin(group_id, q, gk.value());
 				}));
 		}
 
-		// 2) Ȩ 忡  忡  +1  (Ctrl ä )
+		// 2) 홈 샤드에 “내 샤드에 멤버 +1” 통지 (Ctrl 채널 권장)
 		const uint64 homeShard_id = m_dir->PickShard(gk.v);
 		auto home_shard = m_dir->ShardAt(homeShard_id);
 		if (!home_shard) return;
 
 		utils::exec::ShardEndpoint epCtrl(home_shard);
-		epCtrl.Post(utils::job::Job([s = home_shard, group_id, myIdx = static_cast<uint32>(myShard_id)] {
-				s->OnGroupHomeMark(group_id, myIdx, +1);
+		epCtrl.Post(utils::job::Job([s = home_shard, group_id, myIdx = static_cast<uint32>(myShard_id), gk] {
+				s->OnGroupHomeMark(group_id, myIdx, +1, gk.value());
 			}));
 	}
 
@@ -112,25 +152,25 @@ namespace jam::net
 	{
 		if (m_closed.load(std::memory_order_acquire)) return;
 
-		// 1)  忡  
+		// 1) 내 샤드에서 로컬 제거
 		const uint64 myShard_id = m_dir->PickShard(m_key.value());
 		auto my_shard = m_dir->ShardAt(myShard_id);
 		if (my_shard) 
 		{
-			auto q = m_mbNorm;
+			auto q = m_mailbox;
 			my_shard->Submit(utils::job::Job([s = my_shard, group_id, q] {
 					s->OnGroupLocalLeave(group_id, q);
 				}));
 		}
 
-		// 2) Ȩ  refcnt -1
+		// 2) 홈 샤드 refcnt -1
 		const uint64 homeShard_id = m_dir->PickShard(gk.v);
 		auto home_shard = m_dir->ShardAt(homeShard_id);
 		if (!home_shard) return;
 
 		utils::exec::ShardEndpoint epCtrl(home_shard);
-		epCtrl.Post(utils::job::Job([s = home_shard, group_id, myIdx = static_cast<uint32>(myShard_id)] {
-				s->OnGroupHomeMark(group_id, myIdx, -1);
+		epCtrl.Post(utils::job::Job([s = home_shard, group_id, myIdx = static_cast<uint32>(myShard_id), gk] {
+				s->OnGroupHomeMark(group_id, myIdx, -1, gk.value());
 			}));
 	}
 
@@ -142,86 +182,82 @@ namespace jam::net
 
 	void SessionEndpoint::EnsureBound()
 	{
-		if (m_mbNorm && m_mbCtrl && !m_boundShard.expired())
+		if (m_mailbox)
 			return;
 
 		WRITE_LOCK
-		if (m_mbNorm && m_mbCtrl && !m_boundShard.expired())
+		if (m_mailbox)
 			return;
 
 		const uint64 shard_id = m_dir->PickShard(m_key.value());
 		auto shard = m_dir->ShardAt(shard_id);
 		if (!shard) return;
 
-		// ǿ Mailbox 2ä 
-		auto qN = shard->CreateMailbox(utils::exec::eMailboxChannel::NORMAL);
-		auto qC = shard->CreateMailbox(utils::exec::eMailboxChannel::CTRL);
+		// 세션용 Mailbox (CTRL/NORMAL 레인), keyed: it follows the key on a resize
+		m_mailbox = shard->CreateMailbox(m_key.value());
 
-		m_mbNorm = std::move(qN);
-		m_mbCtrl = std::move(qC);
-		m_boundShard = shard;
-
-		// Ʈ   ECS ƼƼ  ÿ  Ʈ 
+		// 엔드포인트 생성 시 ECS 엔티티를 샤드 로컬에 생성해 컴포넌트 구성
 		if (m_entitiy != entt::null) return;
-		shard->Local().defers.emplace_back([this](entt::registry& r)
-			{
-				if (m_entitiy != entt::null) return;
-
-				m_entitiy = r.create();
-
-				// /Ϲڽ/Ű 
-				r.emplace<ecs::SessionRef>(m_entitiy, ecs::SessionRef{ m_session });
-				r.emplace<ecs::MailboxRef>(m_entitiy, ecs::MailboxRef{ m_mbNorm, m_mbCtrl });
-				r.emplace<utils::exec::RouteKey>(m_entitiy, utils::exec::RouteKey{ m_key });
-
-				// Ʈũ ECS Ʈ ⺻ ¾
-				r.emplace<ecs::CompReliability>(m_entitiy);
-				r.emplace<ecs::CompFragment>(m_entitiy);
-				r.emplace<ecs::CompChannel>(m_entitiy);
-				r.emplace<ecs::CompNetstat>(m_entitiy);
-				r.emplace<ecs::CompHandshake>(m_entitiy);
-				r.emplace<ecs::CompCongestion>(m_entitiy);
-
-				// ʿ  ߰ Ʈ ⼭ 
-				// r.emplace<GroupMember>(...);
-			});
+		// one typed record: entity + full component set, written to m_entitiy when the shard applies it
+		shard->Local().commands.CreateWith(&m_entitiy,
+			// 세션/메일박스/라우팅키 연결
+			ecs::SessionRef{ m_session },
+			ecs::MailboxRef{ m_mailbox },
+			utils::exec::RouteKey{ m_key },
+
+			// 네트워크 ECS 컴포넌트 기본 셋업
+			ecs::CompReliability{},
+			ecs::CompFragment{},
+			ecs::CompChannel{},
+			ecs::CompNetstat{},
+			ecs::CompHandshake{},
+			ecs::CompCongestion{}
+			// 필요 시 추가 컴포넌트도 여기서 부착
+			// , GroupMember{...}
+		);
 	}
 
 	void SessionEndpoint::RebindIfExecutorChanged()
 	{
-		// Ű    
+		// 키 기준으로 현재 샤드 재계산
 		const uint64 sid = m_dir->PickShard(m_key.value());	//
 		auto shard = m_dir->ShardAt(sid);
 		if (!shard) return;
 
-		auto locked = m_boundShard.lock();
-		if (locked == shard) return; //  ڸ Ϲڽ  ʿ
+		// null while the mailbox is handed over between shards: it is on its way to shard already
+		auto locked = m_mailbox ? m_mailbox->GetOwner() : nullptr;
+		if (locked == shard || (m_mailbox && !locked)) return; // 같은 실행자면 메일박스 재생성 불필요
 
 		WRITE_LOCK	
-		locked = m_boundShard.lock();
-		if (locked == shard) return;
+		locked = m_mailbox ? m_mailbox->GetOwner() : nullptr;
+		if (locked == shard || (m_mailbox && !locked)) return;
+
+		// 새 실행자에 새 세션 Mailbox 생성
+		auto mb = shard->CreateMailbox(m_key.value());
 
-		//  ڿ   Mailbox 
-		auto mbN = shard->CreateMailbox(utils::exec::eMailboxChannel::NORMAL);
-		auto mbC = shard->CreateMailbox(utils::exec::eMailboxChannel::CTRL);
+		// 교체 (구 큐는 구 샤드가 드레인 후 정리)
+		m_mailbox.swap(mb);
 
-		// ü ( ť  尡 巹  )
-		m_mbNorm.swap(mbN);
-		m_mbCtrl.swap(mbC);
-		m_boundShard = shard;
+		if (locked && mb)
+			locked->RemoveMailbox(mb->GetId());
 	}
 
-	void SessionEndpoint::PostImpl(utils::job::Job j, utils::exec::eMailboxChannel ch)
+	void SessionEndpoint::PostImpl(utils::job::Job j, utils::exec::eMailboxChannel ch, uint8 coalesceKey)
 	{
 		if (m_closed.load(std::memory_order_acquire)) return;
 
-		// 1)   Mailbox õ ( )
+		// 1) 세션 전용 Mailbox로 시도 (빠른 경로)
 		EnsureBound();
-		auto& q = (ch == utils::exec::eMailboxChannel::NORMAL) ? m_mbNorm : m_mbCtrl;
-		if (q && q->Post(std::move(j)))
-			return;
+		if (m_mailbox)
+		{
+			const bool posted = (coalesceKey == utils::job::Job::NO_COALESCE)
+				? m_mailbox->Post(std::move(j), ch)
+				: m_mailbox->PostCoalesced(coalesceKey, std::move(j), ch);
+			if (posted)
+				return;
+		}
 
-		// 2)  : ֽ Ʈ ȹ +  ε  " " Post
+		// 2) 실패 시 (the fallback does not coalesce): 최신 엔드포인트 재획득 + 실행자 재바인딩 후 "한 번만" Post
 		auto& ep = (ch == utils::exec::eMailboxChannel::NORMAL) ? m_epNorm : m_epCtrl;
 		ep = m_dir->EndpointFor(m_key, ch);
 		RebindIfExecutorChanged();
@@ -1,6 +1,7 @@
 #pragma once
 #include "ShardDirectory.h"
 #include "RoutingPolicy.h"
+#include "EcsEventBus.hpp"
 
 namespace jam::net
 {
@@ -10,18 +11,22 @@ namespace jam::net
 	{
     public:
         SessionEndpoint(utils::exec::ShardDirectory& dir, utils::exec::RouteKey key);
+        ~SessionEndpoint();
 
-        // Ϲ ۾
+        // 일반 작업
         void Post(utils::job::Job j);
 
-        // /ΰ
+        // 제어/지연민감
         void PostCtrl(utils::job::Job j);
 
+        // dropped while the same key is still queued for this session
+        void PostCoalesced(eCoalesceKey key, utils::job::Job j, utils::exec::eMailboxChannel ch = utils::exec::eMailboxChannel::NORMAL);
 
-        //  ̵/ε(尡 ٲ ->migrate)
+
+        // 세션 이동/리바인딩(샤드가 바뀌는 경우->migrate)
         void RebindKey(utils::exec::RouteKey newKey);
 
-        //   巹(ο Post )
+        // 세션 단위 드레인(새로운 Post 차단)
         void BeginDrain();
 
 
@@ -35,32 +40,44 @@ namespace jam::net
 
         // Emit Helpers
 
+        // the shard and entity are resolved when the job runs: both change when the session's key
+        // moves to another shard (GlobalExecutor::AddShard / RemoveShard)
         template<typename Ev>
         void Emit(Ev ev)
         {
-            PostCtrl(utils::job::Job([wk = m_boundShard, ev = std::move(ev), e = m_entitiy]() mutable {
-	                if (auto sh = wk.lock())
-	                {
-	                    auto& L = sh->Local();            // ShardLocal
-	                    ev.e = e;                         // ƼƼ 
-	                    L.events.enqueue<Ev>(std::move(ev));
-	                }
-                }));
+            PostCtrl(MakeEmitJob(std::move(ev)));
         }
 
+        // the session's entity was re-created on another shard (destination shard thread)
+        void OnEntityMigrated(entt::entity e) { m_entitiy = e; }
+
         
         void EmitConnect();
         void EmitDisconnect();
-        void EmitSend(const Sptr<SendBuffer>& buf);
+        void EmitSend(const SendBufferRef& buf);
         void EmitRecv();
 
     private:
+        template<typename Ev>
+        utils::job::Job MakeEmitJob(Ev ev)
+        {
+            return utils::job::Job([this, mb = m_mailbox, ev = std::move(ev)]() mutable {
+	                if (auto sh = mb ? mb->GetOwner() : nullptr)
+	                {
+	                    auto& L = sh->Local();            // ShardLocal
+	                    ev.e = m_entitiy;                 // 엔티티 주입
+	                    ecs::NetEvents(L).Post(std::move(ev));
+	                }
+                });
+        }
+
         void RefreshEnpoint();
         void EnsureBound();     // lazy-bind
 
         void RebindIfExecutorChanged();
+        void PostSessionKey(uint64 sessionKey);
 
-        void PostImpl(utils::job::Job j, utils::exec::eMailboxChannel ch);
+        void PostImpl(utils::job::Job j, utils::exec::eMailboxChannel ch, uint8 coalesceKey = utils::job::Job::NO_COALESCE);
 
 
     private:
@@ -74,9 +91,7 @@ namespace jam::net
         utils::exec::ShardEndpoint                  m_epNorm{nullptr};
         utils::exec::ShardEndpoint                  m_epCtrl{nullptr};
 
-        Sptr<utils::exec::Mailbox>                  m_mbNorm;
-        Sptr<utils::exec::Mailbox>                  m_mbCtrl;
-        Wptr<utils::exec::ShardExecutor>            m_boundShard;
+        Sptr<utils::exec::Mailbox>                  m_mailbox;      // CTRL + NORMAL lanes; its owner is the bound shard
 
         entt::entity                                m_entitiy{ entt::null };
         std::weak_ptr<Session>                      m_session;
@@ -17,17 +17,17 @@ namespace jam::net
 		~TcpListener();
 
 	public:
-		// ܺο 
+		// 외부에서 사용
 		bool					StartAccept(Sptr<Service> service);
 		void					CloseSocket();
 
 	public:
-		// ̽ 
+		// 인터페이스 구현
 		virtual HANDLE			GetHandle() override;
 		virtual void			Dispatch(class IocpEvent* iocpEvent, int32 numOfBytes = 0) override;
 
 	private:
-		//  
+		// 수신 관련
 		void					RegisterAccept(AcceptEvent* acceptEvent);
 		void					ProcessAccept(AcceptEvent* acceptEvent);
 
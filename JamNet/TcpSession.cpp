@@ -31,7 +31,7 @@ namespace jam::net
 		RegisterDisconnect();
 	}
 
-	void TcpSession::Send(const Sptr<SendBuffer>& sendBuffer)
+	void TcpSession::Send(const SendBufferRef& sendBuffer)
 	{
 		if (IsConnected() == false)
 			return;
@@ -155,7 +155,7 @@ namespace jam::net
 			int32 writeSize = 0;
 			while (m_sendQueue.empty() == false)
 			{
-				Sptr<SendBuffer> sendBuffer = m_sendQueue.front();
+				SendBufferRef sendBuffer = m_sendQueue.front();
 
 				writeSize += sendBuffer->WriteSize();
 				// TODO: exception check
@@ -168,7 +168,7 @@ namespace jam::net
 		// Scatter-Gather
 		xvector<WSABUF> wsaBufs;
 		wsaBufs.reserve(m_sendEvent.sendBuffers.size());
-		for (const Sptr<SendBuffer>& sendBuffer : m_sendEvent.sendBuffers)
+		for (const SendBufferRef& sendBuffer : m_sendEvent.sendBuffers)
 		{
 			WSABUF wsaBuf;
 			wsaBuf.buf = reinterpret_cast<char*>(sendBuffer->Buffer());
@@ -291,7 +291,7 @@ namespace jam::net
 			Disconnect(L"Handle Error");
 			break;
 		default:
-			cout << "Handle Error : " << errorCode << '\n';
+			LOG_ERROR_EVERY(1_s, "[TcpSession] HandleError : {}", errorCode);
 			break;
 		}
 	}
@@ -17,7 +17,7 @@ namespace jam::net
 
 		virtual bool							Connect() override;
 		virtual void							Disconnect(const WCHAR* cause) override;
-		virtual void							Send(const Sptr<SendBuffer>& sendBuffer) override;
+		virtual void							Send(const SendBufferRef& sendBuffer) override;
 
 	private:
 		/** Iocp Object impl **/
@@ -43,7 +43,7 @@ namespace jam::net
 		USE_LOCK
 
 		RecvBuffer								m_recvBuffer;
-		xqueue<Sptr<SendBuffer>>				m_sendQueue;
+		xqueue<SendBufferRef>					m_sendQueue;
 		Atomic<bool>							m_sendRegistered = false;
 
 		ConnectEvent							m_connectEvent;
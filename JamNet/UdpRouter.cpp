@@ -79,11 +79,11 @@ namespace jam::net
             //ProcessSend(numOfBytes, sendEvent->remoteAddress);
 
 
-            //  ۸  ̺Ʈ  ⼭ 
+            // 매 전송마다 새 이벤트를 썼으니 여기서 정리
             //auto* sendEvent = static_cast<SendEvent*>(iocpEvent);
             auto* sendEvent = utils::memory::ObjectPool<SendEvent>().Pop();
             ProcessSend(numOfBytes, sendEvent->remoteAddress);
-            // sendEvent->sendBuffers       
+            // sendEvent->sendBuffers 가 스코프를 떠나며 버퍼 생존 보장 끝
             /*delete sendEvent;*/
             utils::memory::ObjectPool<SendEvent>().Push(sendEvent);
             break;
@@ -93,7 +93,7 @@ namespace jam::net
         }
     }
 
-    void UdpRouter::RegisterSend(Sptr<SendBuffer> buf, const NetAddress& to)
+    void UdpRouter::RegisterSend(SendBufferRef buf, const NetAddress& to)
     {
     //    WSABUF wsaBuf;
     //    wsaBuf.buf = reinterpret_cast<char*>(sendBuffer->Buffer());
@@ -113,7 +113,7 @@ namespace jam::net
     //        }
     //    }
 
-            //  ۸  SendEvent   thread-safe
+            // ★ 전송마다 독립 SendEvent 생성 → thread-safe
         //auto* ev = new SendEvent();
 
         auto* ev = ObjectPool<SendEvent>().Pop();
@@ -130,7 +130,7 @@ namespace jam::net
         DWORD sent = 0;
         int rc = ::WSASendTo(
             m_socket,
-            &ev->single, 1,           //   WSABUF
+            &ev->single, 1,           // ★ 단일 WSABUF
             OUT & sent,
             0,
             reinterpret_cast<const SOCKADDR*>(&ev->remoteAddress),
@@ -147,7 +147,7 @@ namespace jam::net
         }
     }
 
-    void UdpRouter::RegisterSendMany(const xvector<Sptr<SendBuffer>>& bufs, const NetAddress& to)
+    void UdpRouter::RegisterSendMany(const xvector<SendBufferRef>& bufs, const NetAddress& to)
     {
         //auto* ev = new SendEvent();
 
@@ -157,9 +157,9 @@ namespace jam::net
         ev->remoteAddress = to;
 
         ev->use_gather = true;
-        ev->sendBuffers = bufs;                  //  
+        ev->sendBuffers = bufs;                  // 생존 보장
         ev->gather.clear();
-        ev->gather.reserve(bufs.size());         //  ȭ
+        ev->gather.reserve(bufs.size());         // 작은 최적화
 
         for (auto& sb : bufs) {
             WSABUF w;
@@ -225,7 +225,7 @@ namespace jam::net
     {
         if (numOfBytes == 0) return;
 
-        // : NetAddress from(m_remoteSockAddr);  // ʿ/ ɼ
+        // 기존: NetAddress from(m_remoteSockAddr);  // 불필요/오류 가능성
         m_service.lock()->ProcessUdpSession(remoteAddress, numOfBytes, m_recvBuffer);
         RegisterRecv();
     }
@@ -238,7 +238,7 @@ namespace jam::net
         case WSAECONNABORTED:
             break;
         default:
-            cout << "Handle Error : " << errorCode << '\n';
+            LOG_ERROR_EVERY(1_s, "[UdpRouter] HandleError : {}", errorCode);
             break; 
         }
     }
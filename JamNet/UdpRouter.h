@@ -20,8 +20,8 @@ namespace jam::net
 		virtual void			Dispatch(class IocpEvent* iocpEvent, int32 numOfBytes = 0) override;
 
 
-		void					RegisterSend(Sptr<SendBuffer> buf, const NetAddress& to);
-		void					RegisterSendMany(const xvector<Sptr<SendBuffer>>& bufs, const NetAddress& to);
+		void					RegisterSend(SendBufferRef buf, const NetAddress& to);
+		void					RegisterSendMany(const xvector<SendBufferRef>& bufs, const NetAddress& to);
 		void					RegisterRecv();
 
 		void					ProcessSend(int32 numOfBytes, const NetAddress& remoteAddress);
@@ -16,6 +16,8 @@
 
 namespace jam::net
 {
+	static constexpr uint64 PING_TTL_NS = 100'000'000_ns;		// a pong sent later measures our backlog, not the link
+
 	UdpSession::UdpSession() : m_recvBuffer(BUFFER_SIZE)
 	{
 		m_sid = GenerateSID(eProtocolType::UDP);
@@ -65,7 +67,7 @@ namespace jam::net
 		m_endpoint->EmitDisconnect();
 	}
 
-	void UdpSession::Send(const Sptr<SendBuffer>& buf)
+	void UdpSession::Send(const SendBufferRef& buf)
 	{
 		if (!buf || !buf->Buffer())
 			return;
@@ -161,9 +163,12 @@ namespace jam::net
 		case ePacketType::SYSTEM: 
 		{
 			xvector<BYTE> data(payload, payload + payloadSize);
-			self->PostCtrl(utils::job::Job([self, id, data = std::move(data)]() mutable {
+			utils::job::Job job([self, id, data = std::move(data)]() mutable {
 					self->HandleSystemPacket(id, data.data(), static_cast<uint32>(data.size()));
-				}));
+				});
+			if (id == E2U(eSystemPacketId::PING))
+				job.ExpireAfter(PING_TTL_NS);
+			self->PostCtrl(std::move(job));
 			break;
 		}
 		case ePacketType::ACK: 
@@ -242,7 +247,7 @@ namespace jam::net
 			BYTE* flatBufferData = payload + sizeof(RpcHeader);
 			uint32 flatBufferSize = payloadSize - sizeof(RpcHeader);
 
-			// RpcManager ġ
+			// RpcManager로 디스패치
 			m_rpcManager->Dispatch(GetSession(),
 				rpcHeader->rpcId,
 				rpcHeader->requestId,
@@ -300,7 +305,7 @@ namespace jam::net
 			Disconnect(L"Handle Error");
 			break;
 		default:
-			cout << "Handle Error : " << errorCode << '\n';
+			LOG_ERROR_EVERY(1_s, "[UdpSession] HandleError : {}", errorCode);
 			break;
 		}
 	}
@@ -338,14 +343,14 @@ namespace jam::net
 	}
 
 
-	void UdpSession::SendDirect(const Sptr<SendBuffer>& buf)
+	void UdpSession::SendDirect(const SendBufferRef& buf)
 	{
 		// todo: post to io-thread (in Service::GE)
 		
 		GetService()->m_udpRouter->RegisterSend(buf, GetRemoteNetAddress());
 	}
 
-	//void UdpSession::SendSinglePacket(const Sptr<SendBuffer>& buf)
+	//void UdpSession::SendSinglePacket(const SendBufferRef& buf)
 	//{
 	//	PacketAnalysis analysis = PacketBuilder::AnalyzePacket(buf->Buffer(), buf->WriteSize());
 	//	if (analysis.isValid && analysis.IsReliable())
@@ -362,7 +367,7 @@ namespace jam::net
 	//	SendDirect(buf);
 	//}
 
-	//void UdpSession::SendMultiplePacket(const xvector<Sptr<SendBuffer>>& fragments)
+	//void UdpSession::SendMultiplePacket(const xvector<SendBufferRef>& fragments)
 	//{
 	//	for (auto& fragment : fragments)
 	//	{
@@ -370,7 +375,7 @@ namespace jam::net
 	//	}
 	//}
 
-	void UdpSession::ProcessSend(const Sptr<SendBuffer>& buf)
+	void UdpSession::ProcessSend(const SendBufferRef& buf)
 	{
 		//if (!CanSend())
 		//{
@@ -461,9 +466,12 @@ namespace jam::net
 		case ePacketType::SYSTEM: 
 		{
 			xvector<BYTE> data(payload, payload + payloadSize);
-			self->PostCtrl(utils::job::Job([self, id, data = std::move(data)]() mutable {
+			utils::job::Job job([self, id, data = std::move(data)]() mutable {
 					self->HandleSystemPacket(id, data.data(), static_cast<uint32>(data.size()));
-				}));
+				});
+			if (id == E2U(eSystemPacketId::PING))
+				job.ExpireAfter(PING_TTL_NS);
+			self->PostCtrl(std::move(job));
 			break;
 		}
 		case ePacketType::ACK: 
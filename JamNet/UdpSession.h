@@ -61,7 +61,7 @@ namespace jam::net
 
 		virtual bool							Connect() override;
 		virtual void							Disconnect(const WCHAR* cause) override;
-		virtual void							Send(const Sptr<SendBuffer>& buf) override;
+		virtual void							Send(const SendBufferRef& buf) override;
 
 		virtual void							Update() override;
 
@@ -92,7 +92,7 @@ namespace jam::net
 		//FragmentManager* GetFragmentManager() { return m_fragmentManager.get(); }
 		//HandshakeManager* GetHandshakeManager() { return m_handshakeManager.get(); }
 
-		void									PushSendQueue(const Sptr<SendBuffer>& buf) { m_sendQueue.push(buf); }
+		void									PushSendQueue(const SendBufferRef& buf) { m_sendQueue.push(buf); }
 
 	private:
 		//bool									CanSend() const;
@@ -100,13 +100,13 @@ namespace jam::net
 		void									ProcessUpdate();
 
 
-		void									SendDirect(const Sptr<SendBuffer>& buf);
+		void									SendDirect(const SendBufferRef& buf);
 
 
-		//void									SendSinglePacket(const Sptr<SendBuffer>& buf);
-		//void									SendMultiplePacket(const xvector<Sptr<SendBuffer>>& fragments);
+		//void									SendSinglePacket(const SendBufferRef& buf);
+		//void									SendMultiplePacket(const xvector<SendBufferRef>& fragments);
 
-		void									ProcessSend(const Sptr<SendBuffer>& buf);
+		void									ProcessSend(const SendBufferRef& buf);
 		void									ProcessQueuedSendBuffer();
 
 		
@@ -124,7 +124,7 @@ namespace jam::net
 
 		RecvBuffer								m_recvBuffer;
 
-		xqueue<Sptr<SendBuffer>>				m_sendQueue;
+		xqueue<SendBufferRef>					m_sendQueue;
 		static constexpr uint32 MAX_SENDQUEUE_SIZE = 100;
 
 		//Uptr<HandshakeManager>					m_handshakeManager = nullptr;
@@ -18,6 +18,27 @@ namespace jam::utils::memory
 		::free(ptr);
 	}
 
+	void* BaseAllocator::AlignedAlloc(int32 size, int32 alignment)
+	{
+#ifdef _WIN32
+		return ::_aligned_malloc(size, alignment);
+#else
+		void* ptr = nullptr;
+		if (::posix_memalign(&ptr, alignment, size) != 0)
+			return nullptr;
+		return ptr;
+#endif
+	}
+
+	void BaseAllocator::AlignedRelease(void* ptr)
+	{
+#ifdef _WIN32
+		::_aligned_free(ptr);
+#else
+		::free(ptr);
+#endif
+	}
+
 	/*-------------------
 		StompAllocator
 	-------------------*/
@@ -41,9 +62,9 @@ namespace jam::utils::memory
 		PoolAllocator
 	-------------------*/
 
-	void* PoolAllocator::Alloc(int32 size)
+	void* PoolAllocator::Alloc(int32 size, eMemTag tag)
 	{
-		return MemoryManager::Instance().Allocate(size);
+		return MemoryManager::Instance().Allocate(size, tag);
 	}
 
 	void PoolAllocator::Release(void* ptr)
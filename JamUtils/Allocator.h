@@ -1,4 +1,5 @@
 #pragma once
+#include "MemoryStats.h"
 
 namespace jam::utils::memory
 {
@@ -11,6 +12,9 @@ namespace jam::utils::memory
 	public:
 		static void*	Alloc(int32 size);
 		static void		Release(void* ptr);
+
+		static void*	AlignedAlloc(int32 size, int32 alignment);
+		static void		AlignedRelease(void* ptr);
 	};
 
 	/*-------------------
@@ -33,7 +37,7 @@ namespace jam::utils::memory
 	class PoolAllocator
 	{
 	public:
-		static void*	Alloc(int32 size);
+		static void*	Alloc(int32 size, eMemTag tag = eMemTag::NONE);
 		static void		Release(void* ptr);
 	};
 
@@ -41,28 +45,32 @@ namespace jam::utils::memory
 		STL Allocator
 	-------------------*/
 
-	template<typename T>
+	template<typename T, eMemTag Tag = eMemTag::NONE>
 	class StlAllocator
 	{
 	public:
 		using value_type = T;
 
+		template<typename Other>
+		struct rebind { using other = StlAllocator<Other, Tag>; };
+
 		StlAllocator() = default;
 
 		template<typename Other>
-		StlAllocator(const StlAllocator<Other>&) {}
+		StlAllocator(const StlAllocator<Other, Tag>&) {}
 
 		T* allocate(size_t count)
 		{
 			const int32 size = static_cast<int32>(count * sizeof(T));
-			return static_cast<T*>(PoolAllocator::Alloc(size));
+			return static_cast<T*>(PoolAllocator::Alloc(size, Tag));
 		}
 
 		void deallocate(T* ptr, size_t count)
 		{
 			PoolAllocator::Release(ptr);
 		}
+
+		template<typename Other>
+		bool operator==(const StlAllocator<Other, Tag>&) const { return true; }
 	};
 }
-
-
@@ -0,0 +1,118 @@
+#include "pch.h"
+#include "AutoTuner.h"
+#include "ShardExecutor.h"
+
+namespace jam::utils::exec
+{
+	void AutoTuner::Step(const std::vector<Sptr<ShardExecutor>>& shards, uint64 elapsed_ns)
+	{
+		if (elapsed_ns == 0)
+			return;
+
+		if (m_states.size() < shards.size())
+			m_states.resize(shards.size());
+
+		for (size_t i = 0; i < shards.size(); ++i)
+		{
+			if (shards[i])
+				StepShard(*shards[i], m_states[i], elapsed_ns);
+		}
+	}
+
+	void AutoTuner::StepShard(ShardExecutor& shard, ShardState& st, uint64 elapsed_ns)
+	{
+		ShardMetrics& metrics = shard.Metrics();
+		ShardTuning& tuning = shard.Tuning();
+		const uint32 index = static_cast<uint32>(shard.GetIndex());
+
+		// raw sample of this period
+		uint64 samples = 0;
+		const uint64 p99 = metrics.readyWait.TakeQuantile(0.99f, st.waitCursor, OUT samples);
+		const uint64 idleNs = metrics.idleNs.load(std::memory_order_relaxed);
+		const uint64 assists = metrics.assistRequests.load(std::memory_order_relaxed);
+
+		const float wait = static_cast<float>(p99);		// nothing serviced: nothing waited
+		const float idle = std::clamp(static_cast<float>(idleNs - st.lastIdleNs) / static_cast<float>(elapsed_ns), 0.f, 1.f);
+		const float assistRate = static_cast<float>(assists - st.lastAssists) * 1e9f / static_cast<float>(elapsed_ns);
+		st.lastIdleNs = idleNs;
+		st.lastAssists = assists;
+
+		// the first period only primes the filters (counters were not at a period boundary)
+		if (!st.primed)
+		{
+			st.primed = true;
+			st.waitP99_ns = wait;
+			st.idleRatio = idle;
+			st.assistsPerSec = assistRate;
+			return;
+		}
+
+		const float a = m_config.smoothing;
+		st.waitP99_ns += a * (wait - st.waitP99_ns);
+		st.idleRatio += a * (idle - st.idleRatio);
+		st.assistsPerSec += a * (assistRate - st.assistsPerSec);
+
+		const float error = st.waitP99_ns / static_cast<float>(m_config.targetWaitP99_ns) - 1.f;	// > 0: late
+		const bool late = error > m_config.deadband;
+		const bool early = error < -m_config.deadband;
+		const bool underloaded = st.idleRatio > m_config.idleHigh;
+		const bool eagerAssists = st.assistsPerSec > m_config.assistsPerSecHigh;
+
+		if (late && !underloaded)
+		{
+			// throughput: fewer ready-queue round trips, help earlier and for longer
+			Adjust(index, "batchBudget", tuning.batchBudget, Factor(error), m_config.batchBudgetMin, m_config.batchBudgetMax, st);
+			Adjust(index, "assistThreshold", tuning.assistThreshold, Factor(-error), m_config.assistThresholdMin, m_config.assistThresholdMax, st);
+			Adjust(index, "assistMailboxes", tuning.assistMailboxes, Factor(error), m_config.assistBudgetMin, m_config.assistBudgetMax, st);
+			Adjust(index, "assistBudget", tuning.assistBudget, Factor(error), m_config.assistBudgetMin, m_config.assistBudgetMax, st);
+		}
+		else if (early && underloaded)
+		{
+			// fairness: smaller batches interleave mailboxes, shorter assists
+			Adjust(index, "batchBudget", tuning.batchBudget, Factor(error), m_config.batchBudgetMin, m_config.batchBudgetMax, st);
+			Adjust(index, "assistMailboxes", tuning.assistMailboxes, Factor(error), m_config.assistBudgetMin, m_config.assistBudgetMax, st);
+			Adjust(index, "assistBudget", tuning.assistBudget, Factor(error), m_config.assistBudgetMin, m_config.assistBudgetMax, st);
+		}
+
+		// on target yet asking for help all the time: the threshold is too low
+		if (eagerAssists && !late)
+		{
+			const float over = st.assistsPerSec / m_config.assistsPerSecHigh - 1.f;
+			Adjust(index, "assistThreshold", tuning.assistThreshold, Factor(over), m_config.assistThresholdMin, m_config.assistThresholdMax, st);
+		}
+
+		// idle sleep granularity is pure latency when late; saves CPU when idle and early
+		if (late)
+			Adjust(index, "idleSleepMs", tuning.idleSleepMs, Factor(-error), m_config.idleSleepMsMin, m_config.idleSleepMsMax, st);
+		else if (early && underloaded)
+			Adjust(index, "idleSleepMs", tuning.idleSleepMs, Factor(-error), m_config.idleSleepMsMin, m_config.idleSleepMsMax, st);
+	}
+
+	float AutoTuner::Factor(float error) const
+	{
+		return 1.f + std::clamp(m_config.gain * error, -m_config.maxStep, m_config.maxStep);
+	}
+
+	template<typename T>
+	void AutoTuner::Adjust(uint32 shard, const char* name, Atomic<T>& knob, float factor, T lo, T hi, const ShardState& st)
+	{
+		const T cur = knob.load(std::memory_order_relaxed);
+
+		T next = static_cast<T>(std::llround(static_cast<double>(cur) * factor));
+		// small knobs would never move multiplicatively: at least one unit toward the factor
+		if (next == cur && factor > 1.f)
+			next = cur + 1;
+		else if (next == cur && factor < 1.f && cur > 0)
+			next = cur - 1;
+		next = std::clamp(next, lo, hi);
+
+		if (next == cur)
+			return;
+
+		knob.store(next, std::memory_order_relaxed);
+		++m_adjustments;
+
+		LOG_INFO("autotune: shard {} {} {} -> {} (wait p99 {} us, idle {:.2f}, assists {:.1f}/s)",
+			shard, name, cur, next, static_cast<uint64>(st.waitP99_ns / 1000.f), st.idleRatio, st.assistsPerSec);
+	}
+}
@@ -0,0 +1,148 @@
+#pragma once
+
+namespace jam::utils::exec
+{
+	class ShardExecutor;
+
+	struct AutoTuneConfig
+	{
+		uint64		period_ns = 250'000'000_ns;			// one controller step per period
+		uint64		targetWaitP99_ns = 2'000'000_ns;	// ready -> serviced, per mailbox
+
+		float		smoothing = 0.3f;		// EMA weight of the newest sample
+		float		deadband = 0.15f;		// relative latency error that is left alone
+		float		gain = 0.5f;			// step = gain * error, then clamped
+		float		maxStep = 0.25f;		// largest relative change per period
+
+		float		idleHigh = 0.5f;			// idle ratio above: underloaded (lobby)
+		float		assistsPerSecHigh = 20.f;	// assist requests above: too eager
+
+		// bounds
+		int32		batchBudgetMin = 8;
+		int32		batchBudgetMax = 256;
+		uint64		assistThresholdMin = 64;
+		uint64		assistThresholdMax = 8192;
+		int32		idleSleepMsMin = 0;
+		int32		idleSleepMsMax = 4;
+		int32		assistBudgetMin = 4;		// AssistDrainOnce: mailboxes and jobs per mailbox
+		int32		assistBudgetMax = 128;
+	};
+
+	// Live values of the shard knobs. Written by the tuner, read relaxed by the shard and IO workers.
+	struct ShardTuning
+	{
+		Atomic<int32>		batchBudget = 32;
+		Atomic<uint64>		assistThreshold = 512;
+		Atomic<int32>		idleSleepMs = 1;
+		Atomic<int32>		assistMailboxes = 16;
+		Atomic<int32>		assistBudget = 16;
+	};
+
+	/*-------------------
+		WaitHistogram
+	--------------------*/
+
+	// log2 buckets of microseconds; any thread records. Buckets only grow: each reader (auto-tuner,
+	// overload controller) keeps its own Cursor and takes the samples recorded since its last read
+	class WaitHistogram
+	{
+		enum : uint32 { BUCKETS = 32 };
+
+	public:
+		struct Cursor
+		{
+			std::array<uint64, BUCKETS>		seen{};
+		};
+
+		void Record(uint64 wait_ns)
+		{
+			const uint64 us = wait_ns >> 10;
+			const uint32 b = (std::min)(static_cast<uint32>(std::bit_width(us)), BUCKETS - 1);
+			m_buckets[b].fetch_add(1, std::memory_order_relaxed);
+		}
+
+		// upper bound of the bucket holding the q-quantile of the samples since cursor (ns); 0 without samples
+		uint64 TakeQuantile(float q, Cursor& cursor, OUT uint64& samples) const
+		{
+			std::array<uint64, BUCKETS> counts;
+			samples = 0;
+			for (uint32 b = 0; b < BUCKETS; ++b)
+			{
+				const uint64 now = m_buckets[b].load(std::memory_order_relaxed);
+				// behind the cursor: a new shard under a reused index, count from zero
+				counts[b] = now >= cursor.seen[b] ? now - cursor.seen[b] : now;
+				cursor.seen[b] = now;
+				samples += counts[b];
+			}
+			if (samples == 0)
+				return 0;
+
+			const uint64 rank = static_cast<uint64>(static_cast<double>(samples) * q);
+			uint64 seen = 0;
+			for (uint32 b = 0; b < BUCKETS; ++b)
+			{
+				seen += counts[b];
+				if (seen > rank)
+					return (1ull << b) << 10;
+			}
+			return (1ull << (BUCKETS - 1)) << 10;
+		}
+
+	private:
+		std::array<Atomic<uint64>, BUCKETS>		m_buckets{};
+	};
+
+	// Counters the tuner and the overload controller read per period (all monotonic)
+	struct ShardMetrics
+	{
+		WaitHistogram		readyWait;
+		Atomic<uint64>		idleNs = 0;
+		Atomic<uint64>		assistRequests = 0;
+		Atomic<uint64>		ticks = 0;
+		Atomic<uint64>		tickOverruns = 0;		// Tick took longer than its period
+	};
+
+	/*---------------
+		AutoTuner
+	----------------*/
+
+	// Damped feedback controller over the shard knobs (GlobalExecutorConfig::autoTune).
+	// Inputs per shard and period: ready-wait p99, idle ratio, assist rate, all EMA smoothed.
+	//  - late and busy:        larger batches, assist sooner and longer, shorter idle sleep
+	//  - early and idle:       smaller batches (fairness), assist later, longer idle sleep
+	//  - frequent assists but on target: raise the assist threshold
+	// Each knob moves by at most maxStep per period inside its bounds; every change is logged.
+	class AutoTuner
+	{
+	public:
+		explicit AutoTuner(const AutoTuneConfig& config) : m_config(config) {}
+
+		// one controller step; elapsed_ns since the previous step
+		void				Step(const std::vector<Sptr<ShardExecutor>>& shards, uint64 elapsed_ns);
+
+		uint64				GetAdjustCount() const { return m_adjustments; }
+
+	private:
+		struct ShardState
+		{
+			bool		primed = false;
+			float		waitP99_ns = 0.f;
+			float		idleRatio = 0.f;
+			float		assistsPerSec = 0.f;
+			uint64		lastIdleNs = 0;
+			uint64		lastAssists = 0;
+			WaitHistogram::Cursor	waitCursor;
+		};
+
+		void				StepShard(ShardExecutor& shard, ShardState& st, uint64 elapsed_ns);
+		float				Factor(float error) const;
+
+		template<typename T>
+		void				Adjust(uint32 shard, const char* name, Atomic<T>& knob, float factor, T lo, T hi, const ShardState& st);
+
+	private:
+		AutoTuneConfig				m_config;
+		std::vector<ShardState>		m_states;
+		uint64						m_adjustments = 0;
+	};
+}
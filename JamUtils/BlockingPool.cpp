@@ -0,0 +1,198 @@
+#include "pch.h"
+#include "BlockingPool.h"
+#include "ShardExecutor.h"
+#include "ShardTLS.h"
+
+namespace jam::utils::exec
+{
+	BlockingPool::BlockingPool(const BlockingPoolConfig& config)
+		: m_config(config)
+	{
+		m_config.maxThreads = (std::max)(m_config.maxThreads, 1u);
+		m_config.minThreads = (std::min)(m_config.minThreads, m_config.maxThreads);
+	}
+
+	BlockingPool::~BlockingPool()
+	{
+		Stop();
+		Join();
+	}
+
+	void BlockingPool::Start()
+	{
+		std::unique_lock lk(m_lock);
+		if (m_running)
+			return;
+
+		m_running = true;
+		for (uint32 i = 0; i < m_config.minThreads; ++i)
+			SpawnLocked();
+	}
+
+	void BlockingPool::Stop()
+	{
+		{
+			std::unique_lock lk(m_lock);
+			if (!m_running)
+				return;
+
+			m_running = false;
+			uint64 dropped = m_ready.size();
+			for (auto& [key, lane] : m_lanes)
+				dropped += lane.waiting.size();
+			m_pending.fetch_sub(dropped, std::memory_order_relaxed);
+			m_ready.clear();
+			m_lanes.clear();
+		}
+		m_cv.notify_all();
+	}
+
+	void BlockingPool::Join()
+	{
+		std::vector<std::thread> threads;
+		{
+			std::unique_lock lk(m_lock);
+			threads.swap(m_threads);
+			m_exited.clear();
+		}
+
+		for (std::thread& t : threads)
+		{
+			if (t.joinable())
+				t.join();
+		}
+	}
+
+	void BlockingPool::Post(job::Job job, uint64 laneKey)
+	{
+		{
+			std::unique_lock lk(m_lock);
+			if (!m_running)
+				return;
+
+			m_pending.fetch_add(1, std::memory_order_relaxed);
+
+			// a busy lane holds the job back until its current one is done
+			if (laneKey != NO_LANE)
+			{
+				auto [it, fresh] = m_lanes.try_emplace(laneKey);
+				if (!fresh)
+				{
+					it->second.waiting.push_back(std::move(job));
+					return;
+				}
+			}
+
+			m_ready.push_back(Item{ std::move(job), laneKey });
+
+			if (m_idle == 0 && m_threadCount.load(std::memory_order_relaxed) < m_config.maxThreads)
+				SpawnLocked();
+		}
+		m_cv.notify_one();
+	}
+
+	void BlockingPool::WorkerLoop()
+	{
+		const auto idleTimeout = std::chrono::nanoseconds(m_config.idleTimeout_ns);
+
+		std::unique_lock lk(m_lock);
+		while (true)
+		{
+			if (m_ready.empty())
+			{
+				++m_idle;
+				const bool woke = m_cv.wait_for(lk, idleTimeout, [this] { return !m_running || !m_ready.empty(); });
+				--m_idle;
+
+				if (!m_running)
+					break;
+
+				// idle for a whole timeout: give the thread back
+				if (!woke && m_threadCount.load(std::memory_order_relaxed) > m_config.minThreads)
+					break;
+				if (m_ready.empty())
+					continue;
+			}
+
+			Item item = std::move(m_ready.front());
+			m_ready.pop_front();
+
+			lk.unlock();
+			item.job.Execute();
+			lk.lock();
+
+			m_pending.fetch_sub(1, std::memory_order_relaxed);
+			if (item.laneKey != NO_LANE && m_running)
+				FinishLaneLocked(item.laneKey);
+		}
+
+		m_threadCount.fetch_sub(1, std::memory_order_relaxed);
+		if (m_running)
+			m_exited.push_back(std::this_thread::get_id());
+	}
+
+	void BlockingPool::SpawnLocked()
+	{
+		ReapLocked();
+		m_threadCount.fetch_add(1, std::memory_order_relaxed);
+		m_threads.emplace_back(&BlockingPool::WorkerLoop, this);
+	}
+
+	void BlockingPool::ReapLocked()
+	{
+		// exited threads have left the lock for good: their joins return at once
+		for (std::thread::id id : m_exited)
+		{
+			auto it = std::find_if(m_threads.begin(), m_threads.end(), [id](const std::thread& t) { return t.get_id() == id; });
+			if (it == m_threads.end())
+				continue;
+
+			it->join();
+			*it = std::move(m_threads.back());
+			m_threads.pop_back();
+		}
+		m_exited.clear();
+	}
+
+	void BlockingPool::FinishLaneLocked(uint64 laneKey)
+	{
+		auto it = m_lanes.find(laneKey);
+		if (it == m_lanes.end())
+			return;
+
+		Lane& lane = it->second;
+		if (lane.waiting.empty())
+		{
+			m_lanes.erase(it);
+			return;
+		}
+
+		// the lane's next job joins the back of the queue: a long lane does not starve the rest
+		m_ready.push_back(Item{ std::move(lane.waiting.front()), laneKey });
+		lane.waiting.pop_front();
+		m_cv.notify_one();
+	}
+
+	void BlockingPool::Deliver(job::Job done, const Sptr<Mailbox>& replyTo, const Sptr<ShardExecutor>& origin)
+	{
+		if (replyTo)
+		{
+			(void)replyTo->Post(std::move(done));
+			return;
+		}
+
+		if (origin && origin->IsRunning())
+		{
+			origin->Submit(std::move(done));
+			return;
+		}
+
+		done.Execute();
+	}
+
+	Sptr<ShardExecutor> BlockingPool::CurrentShard()
+	{
+		ShardExecutor* shard = ShardTLS::GetExecutor();
+		return shard ? shard->shared_from_this() : nullptr;
+	}
+}
@@ -0,0 +1,105 @@
+#pragma once
+#include "Job.h"
+#include "Mailbox.h"
+
+namespace jam::utils::exec
+{
+	class ShardExecutor;
+
+	struct BlockingPoolConfig
+	{
+		uint32		minThreads = 1;
+		uint32		maxThreads = 16;
+		uint64		idleTimeout_ns = 30'000'000'000_ns;		// an idle thread above minThreads exits after this
+	};
+
+	/*------------------
+		BlockingPool
+	-------------------*/
+
+	// Threads for work that blocks (file writes, DNS, slow backends), apart from the IO workers
+	// that serve shard assists. Grows by one thread whenever work arrives and no thread is idle,
+	// up to maxThreads; shrinks back to minThreads as threads sit idle.
+	// Lanes: jobs posted with the same non-zero lane key run one at a time, in post order (per
+	// user / session writes); other lanes and unkeyed jobs run beside them.
+	class BlockingPool
+	{
+	public:
+		static constexpr uint64 NO_LANE = 0;
+
+		explicit BlockingPool(const BlockingPoolConfig& config = {});
+		~BlockingPool();
+
+		void			Start();
+		void			Stop();		// queued work is dropped
+		void			Join();
+
+		void			Post(job::Job job, uint64 laneKey = NO_LANE);
+
+		// work() on the pool, then then(result) where the caller lives: replyTo's mailbox if given
+		// (dropped if it has closed meanwhile), else the shard that called Offload, else the pool
+		// thread itself. Results are copied into a job, so they must be copyable.
+		template<typename Work, typename Then>
+		void			Offload(uint64 laneKey, Work work, Then then, Sptr<Mailbox> replyTo = nullptr);
+
+		uint32			GetThreadCount() const { return m_threadCount.load(std::memory_order_relaxed); }
+		uint64			GetPendingCount() const { return m_pending.load(std::memory_order_relaxed); }
+
+	private:
+		struct Item
+		{
+			job::Job	job;
+			uint64		laneKey = NO_LANE;
+		};
+
+		struct Lane
+		{
+			xdeque<job::Job>		waiting;	// behind the one queued or running
+		};
+
+		void			WorkerLoop();
+		void			SpawnLocked();
+		void			ReapLocked();
+		void			FinishLaneLocked(uint64 laneKey);
+		static void		Deliver(job::Job done, const Sptr<Mailbox>& replyTo, const Sptr<ShardExecutor>& origin);
+		static Sptr<ShardExecutor> CurrentShard();
+
+	private:
+		BlockingPoolConfig								m_config;
+		bool											m_running = false;
+
+		std::mutex										m_lock;
+		std::condition_variable							m_cv;
+		xdeque<Item>									m_ready;
+		xumap<uint64, Lane>								m_lanes;		// lanes with a job queued or running
+
+		std::vector<std::thread>						m_threads;
+		std::vector<std::thread::id>					m_exited;		// joined by the next spawn / Join
+		uint32											m_idle = 0;
+
+		Atomic<uint32>									m_threadCount{ 0 };
+		Atomic<uint64>									m_pending{ 0 };
+	};
+
+
+
+	template<typename Work, typename Then>
+	inline void BlockingPool::Offload(uint64 laneKey, Work work, Then then, Sptr<Mailbox> replyTo)
+	{
+		Sptr<ShardExecutor> origin = replyTo ? nullptr : CurrentShard();
+
+		Post(job::Job([work = std::move(work), then = std::move(then), replyTo = std::move(replyTo), origin = std::move(origin)]() mutable
+			{
+				if constexpr (std::is_void_v<std::invoke_result_t<Work&>>)
+				{
+					work();
+					Deliver(job::Job([then]() mutable { then(); }), replyTo, origin);
+				}
+				else
+				{
+					auto result = work();
+					Deliver(job::Job([then, result = std::move(result)]() mutable { then(std::move(result)); }), replyTo, origin);
+				}
+			}), laneKey);
+	}
+}
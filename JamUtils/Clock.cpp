@@ -1,22 +1,113 @@
 #include "pch.h"
 #include "Clock.h"
 
+#if JAM_CLOCK_TSC && !defined(_MSC_VER)
+#include <cpuid.h>
+#endif
+
 namespace jam::utils
 {
-	void Clock::Start(uint32 tickHz)
+	static thread_local uint64 tl_LoopNowNs = 0;
+
+	static constexpr uint64 CALIBRATION_NS = 20'000'000;		// spin this long against the reference clock
+	static constexpr uint64 MIN_TSC_HZ = 100'000'000;
+
+	static bool HasInvariantTsc()
+	{
+#if JAM_CLOCK_TSC
+#ifdef _MSC_VER
+		int regs[4] = {};
+		__cpuid(regs, 0x80000000);
+		if (static_cast<uint32>(regs[0]) < 0x80000007)
+			return false;
+		__cpuid(regs, 0x80000007);
+		return (regs[3] & (1 << 8)) != 0;		// EDX.InvariantTSC
+#else
+		uint32 eax, ebx, ecx, edx;
+		if (__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) == 0)
+			return false;
+		return (edx & (1u << 8)) != 0;
+#endif
+#else
+		return false;
+#endif
+	}
+
+	uint64 Clock::ReadRawTicks(eClockSource source)
+	{
+		switch (source)
+		{
+#if JAM_CLOCK_TSC
+		case eClockSource::TSC:
+			return __rdtsc();
+#endif
+#ifdef _WIN32
+		case eClockSource::QPC:
+		{
+			LARGE_INTEGER counter;
+			::QueryPerformanceCounter(&counter);
+			return static_cast<uint64>(counter.QuadPart);
+		}
+#else
+		case eClockSource::MONOTONIC:
+		{
+			timespec ts;
+			::clock_gettime(CLOCK_MONOTONIC, &ts);
+			return static_cast<uint64>(ts.tv_sec) * 1'000'000'000ull + static_cast<uint64>(ts.tv_nsec);
+		}
+#endif
+		default:
+			CRASH("CLOCK_SOURCE");
+			return 0;
+		}
+	}
+
+	Clock::Calibration Clock::Calibrate()
 	{
+		// reference clock: QPC / CLOCK_MONOTONIC
+		Calibration ref;
+#ifdef _WIN32
 		LARGE_INTEGER freq;
 		::QueryPerformanceFrequency(&freq);
-		m_qpcFreq = freq.QuadPart;
+		ref.source = eClockSource::QPC;
+		ref.hz = static_cast<uint64>(freq.QuadPart);
+#else
+		ref.source = eClockSource::MONOTONIC;
+		ref.hz = 1'000'000'000ull;
+#endif
+		ref.mult = (1'000'000'000ull << MULT_SHIFT) / ref.hz;
+
+		if (HasInvariantTsc() == false)
+			return ref;
+
+		// TSC frequency = tsc delta / reference delta over a short spin
+		const uint64 refSpan = ref.hz * CALIBRATION_NS / 1'000'000'000ull;
+		const uint64 ref0 = ReadRawTicks(ref.source);
+		const uint64 tsc0 = ReadRawTicks(eClockSource::TSC);
+		uint64 ref1, tsc1;
+		do
+		{
+			ref1 = ReadRawTicks(ref.source);
+			tsc1 = ReadRawTicks(eClockSource::TSC);
+		} while (ref1 - ref0 < refSpan);
+
+		const double hz = static_cast<double>(tsc1 - tsc0) * static_cast<double>(ref.hz) / static_cast<double>(ref1 - ref0);
+		if (hz < static_cast<double>(MIN_TSC_HZ))
+			return ref;
+
+		Calibration tsc;
+		tsc.source = eClockSource::TSC;
+		tsc.hz = static_cast<uint64>(hz);
+		tsc.mult = (1'000'000'000ull << MULT_SHIFT) / tsc.hz;
+		return tsc;
+	}
 
+	void Clock::Start(uint32 tickHz)
+	{
 		m_tickHz = tickHz;
 		m_tickInterval_ns = (m_tickHz > 0) ? (1'000'000'000ull / m_tickHz) : 0ull;
 
-		const int64 q = ReadQpc();
-		if (m_qpcAtBoot == 0)
-			m_qpcAtBoot = q;
-
-		m_qpcAtStart = q;
+		m_ticksAtStart = ReadTicks();
 	}
 
 
@@ -66,6 +157,21 @@ namespace jam::utils
 
 
 
+	uint64 Clock::UpdateLoopNow() const
+	{
+		tl_LoopNowNs = NowAbsNs();
+		return tl_LoopNowNs;
+	}
+
+	uint64 Clock::LoopNowNs() const
+	{
+		return tl_LoopNowNs != 0 ? tl_LoopNowNs : NowAbsNs();
+	}
+
+
+
+
+
 	static inline FractionalTick ToFractionalTickU64(uint64 totalNs, uint64 stepNs)
 	{
 		if (stepNs == 0) 
@@ -2,6 +2,17 @@
 #include <chrono>
 #include "TimeUnits.h"
 
+#if defined(_M_X64) || defined(__x86_64__)
+#define JAM_CLOCK_TSC 1
+#ifndef _MSC_VER
+#include <x86intrin.h>
+#endif
+#endif
+
+#ifndef _WIN32
+#include <time.h>
+#endif
+
 namespace jam::utils
 {
 	struct FractionalTick
@@ -10,29 +21,46 @@ namespace jam::utils
 		double alpha;    // [0, 1)
 	};
 
+	enum class eClockSource : uint8
+	{
+		TSC,			// invariant rdtsc, calibrated at startup
+		QPC,			// QueryPerformanceCounter
+		MONOTONIC		// clock_gettime(CLOCK_MONOTONIC), already ns
+	};
+
+	// Ticks -> ns is a multiply-shift (ns = ticks * mult >> 32), no 128-bit divide on the hot path.
+	// The source is picked once, when the singleton is first touched.
 	class Clock
 	{
 		DECLARE_SINGLETON(Clock)
 
+		enum : uint32 { MULT_SHIFT = 32 };
+
 	public:
 		void			Start(uint32 tickHz);
 
-		//   ð(Ʈ  )
+		// 절대 단조 시간(부트 원점 기준)
 		uint64			NowNs() const;
 		uint64			NowUs() const;
 		uint64			NowMs() const;
 		uint64			NowSec() const;
 
-		// Start()  
+		// Start() 이후 경과
 		uint64			ElapsedNs() const;
 		uint64			ElapsedUs() const;
 		uint64			ElapsedMs() const;
 		uint64			ElapsedSec() const;
 
+		// per-thread time cached once per executor loop pass, for code that tolerates
+		// being a loop pass stale (timers, throttles, flush intervals). 0 before the first update.
+		uint64			UpdateLoopNow() const;
+		uint64			LoopNowNs() const;
 
 		FractionalTick NowFractionalTick() const;
 		FractionalTick ElapsedFractionalTick() const;
 
+		eClockSource	GetSource() const { return m_cal.source; }
+		uint64			GetTicksPerSec() const { return m_cal.hz; }
 
 		template<class Dur>
 		Dur NowChrono() const
@@ -46,43 +74,53 @@ namespace jam::utils
 		}
 
 	private:
+		struct Calibration
+		{
+			eClockSource	source = eClockSource::QPC;
+			uint64			hz = 0;
+			uint64			mult = 0;		// (1e9 << MULT_SHIFT) / hz
+		};
+
+		static Calibration	Calibrate();
+		static uint64		ReadRawTicks(eClockSource source);
 
-		inline int64 ReadQpc() const
+		inline uint64 ReadTicks() const
 		{
-			LARGE_INTEGER counter;
-			::QueryPerformanceCounter(&counter);
-			return counter.QuadPart;
+#if JAM_CLOCK_TSC
+			if (m_cal.source == eClockSource::TSC)
+				return __rdtsc();
+#endif
+			return ReadRawTicks(m_cal.source);
 		}
 
-		inline uint64 QpcToNs(int64 counter) const
+		inline uint64 TicksToNs(uint64 ticks) const
 		{
-			assert(counter >= 0);                // ⼭ ׻ Ÿ 0 ̻̾ 
-			const uint64 c = static_cast<uint64>(counter);
-			const uint64 f = static_cast<uint64>(m_qpcFreq);
-			// (c * 1e9) / f   128-bit   
+#ifdef _MSC_VER
 			uint64 hi;
-			const uint64 lo = _umul128(c, 1'000'000'000ULL, &hi);
-			return _udiv128(hi, lo, f, nullptr); // () ȯ
+			const uint64 lo = _umul128(ticks, m_cal.mult, &hi);
+			return __shiftright128(lo, hi, MULT_SHIFT);
+#else
+			return static_cast<uint64>((static_cast<unsigned __int128>(ticks) * m_cal.mult) >> MULT_SHIFT);
+#endif
 		}
 
-
 		inline uint64 NowAbsNs() const
 		{
-			return QpcToNs(ReadQpc() - m_qpcAtBoot);
+			return TicksToNs(ReadTicks() - m_ticksAtBoot);
 		}
 
 		inline uint64 ElapsedAbsNs() const
 		{
-			return QpcToNs(ReadQpc() - m_qpcAtStart);
+			return TicksToNs(ReadTicks() - m_ticksAtStart);
 		}
 
 	private:
+		// declaration order matters: origin ticks are read with the calibrated source
+		Calibration	m_cal = Calibrate();
+		uint64		m_ticksAtBoot = ReadTicks();
+		uint64		m_ticksAtStart = m_ticksAtBoot;
 
-		int64	m_qpcFreq{ 0 };
-		int64	m_qpcAtBoot{ 0 };
-		int64	m_qpcAtStart{ 0 };
-
-		uint32	m_tickHz{ 0 };
-		uint64	m_tickInterval_ns{ 0_ns };
+		uint32		m_tickHz{ 0 };
+		uint64		m_tickInterval_ns{ 0_ns };
 	};
 }
\ No newline at end of file
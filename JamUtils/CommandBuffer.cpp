@@ -0,0 +1,92 @@
+#include "pch.h"
+#include "CommandBuffer.h"
+
+namespace jam::utils::exec
+{
+	CommandBuffer::~CommandBuffer()
+	{
+		for (Chunk& chunk : m_chunks)
+		{
+			uint32 offset = 0;
+			while (offset < chunk.used)
+			{
+				RecordHeader* header = reinterpret_cast<RecordHeader*>(chunk.data + offset);
+				header->discard(chunk.data + offset + sizeof(RecordHeader));
+				offset += header->size;
+			}
+			FreeChunk(chunk);
+		}
+
+		for (Chunk& chunk : m_spare)
+			FreeChunk(chunk);
+	}
+
+	void CommandBuffer::Apply(entt::registry& r)
+	{
+		if (IsEmpty())
+			return;
+
+		// records made while applying (e.g. from component hooks) land in a fresh chunk list: next Apply
+		{
+			LockGuard guard(m_lock);
+			m_applying.swap(m_chunks);
+			m_count.store(0, std::memory_order_relaxed);
+		}
+
+		for (Chunk& chunk : m_applying)
+		{
+			uint32 offset = 0;
+			while (offset < chunk.used)
+			{
+				RecordHeader* header = reinterpret_cast<RecordHeader*>(chunk.data + offset);
+				header->apply(r, chunk.data + offset + sizeof(RecordHeader));
+				offset += header->size;
+			}
+			chunk.used = 0;
+		}
+
+		{
+			LockGuard guard(m_lock);
+			for (Chunk& chunk : m_applying)
+			{
+				if (chunk.capacity == CHUNK_SIZE)
+					m_spare.push_back(chunk);
+				else
+					FreeChunk(chunk);
+			}
+		}
+		m_applying.clear();
+	}
+
+	uint8* CommandBuffer::Reserve(uint32 size)
+	{
+		if (m_chunks.empty() || m_chunks.back().capacity - m_chunks.back().used < size)
+			m_chunks.push_back(NewChunk(size));
+
+		Chunk& chunk = m_chunks.back();
+		uint8* ptr = chunk.data + chunk.used;
+		chunk.used += size;
+		return ptr;
+	}
+
+	CommandBuffer::Chunk CommandBuffer::NewChunk(uint32 minSize)
+	{
+		if (minSize <= CHUNK_SIZE && !m_spare.empty())
+		{
+			Chunk chunk = m_spare.back();
+			m_spare.pop_back();
+			return chunk;
+		}
+
+		Chunk chunk;
+		chunk.capacity = (std::max)(static_cast<uint32>(CHUNK_SIZE), minSize);
+		chunk.data = static_cast<uint8*>(memory::PoolAllocator::Alloc(static_cast<int32>(chunk.capacity), memory::eMemTag::ECS_STORE));
+		return chunk;
+	}
+
+	void CommandBuffer::FreeChunk(Chunk& chunk)
+	{
+		memory::PoolAllocator::Release(chunk.data);
+		chunk = Chunk{};
+	}
+}
@@ -0,0 +1,166 @@
+#pragma once
+
+namespace jam::utils::exec
+{
+	/*-------------------
+		CommandBuffer
+	--------------------*/
+
+	// Deferred registry changes as typed records packed into reused chunks: no per-command heap
+	// allocation or std::function. Any thread may record (a short lock per record); the shard thread
+	// applies everything in recording order with Apply(), after systems have run.
+	class CommandBuffer
+	{
+		enum : uint32
+		{
+			CHUNK_SIZE = 16 * 1024,
+			RECORD_ALIGN = 8
+		};
+
+		using ApplyFn = void(*)(entt::registry& r, void* payload);		// applies and destroys the payload
+		using DiscardFn = void(*)(void* payload);
+
+		struct RecordHeader
+		{
+			ApplyFn		apply;
+			DiscardFn	discard;		// buffer destroyed before Apply
+			uint32		size;			// header + payload, RECORD_ALIGN multiple
+		};
+
+		struct Chunk
+		{
+			uint8*		data = nullptr;
+			uint32		used = 0;
+			uint32		capacity = 0;
+		};
+
+	public:
+		CommandBuffer() = default;
+		~CommandBuffer();
+
+		CommandBuffer(const CommandBuffer&) = delete;
+		CommandBuffer& operator=(const CommandBuffer&) = delete;
+
+		// creates an entity with a whole component set in one record.
+		// out (optional) receives the entity; if it is already non-null when applied, nothing is created.
+		template<typename... C>
+		void CreateWith(entt::entity* out, C&&... components)
+		{
+			Record<CreateCmd<std::decay_t<C>...>>(out, std::forward<C>(components)...);
+		}
+
+		template<typename C>
+		void Emplace(entt::entity e, C&& component)
+		{
+			Record<EmplaceCmd<std::decay_t<C>>>(e, std::forward<C>(component));
+		}
+
+		template<typename... C>
+		void Remove(entt::entity e)
+		{
+			Record<RemoveCmd<C...>>(e);
+		}
+
+		void Destroy(entt::entity e)
+		{
+			Record<DestroyCmd>(e);
+		}
+
+		// shard thread
+		void		Apply(entt::registry& r);
+		bool		IsEmpty() const { return m_count.load(std::memory_order_relaxed) == 0; }
+
+	private:
+		template<typename... C>
+		struct CreateCmd
+		{
+			entt::entity*		out;
+			std::tuple<C...>	components;
+
+			CreateCmd(entt::entity* o, auto&&... c) : out(o), components(std::forward<decltype(c)>(c)...) {}
+
+			static void Apply(entt::registry& r, void* p)
+			{
+				CreateCmd& cmd = *static_cast<CreateCmd*>(p);
+				if (cmd.out == nullptr || *cmd.out == entt::null)
+				{
+					const entt::entity e = r.create();
+					if (cmd.out)
+						*cmd.out = e;
+					std::apply([&](auto&... c) { (r.emplace<std::decay_t<decltype(c)>>(e, std::move(c)), ...); }, cmd.components);
+				}
+				std::destroy_at(&cmd);
+			}
+		};
+
+		template<typename C>
+		struct EmplaceCmd
+		{
+			entt::entity		e;
+			C					component;
+
+			static void Apply(entt::registry& r, void* p)
+			{
+				EmplaceCmd& cmd = *static_cast<EmplaceCmd*>(p);
+				if (r.valid(cmd.e))
+					r.emplace_or_replace<C>(cmd.e, std::move(cmd.component));
+				std::destroy_at(&cmd);
+			}
+		};
+
+		template<typename... C>
+		struct RemoveCmd
+		{
+			entt::entity		e;
+
+			static void Apply(entt::registry& r, void* p)
+			{
+				RemoveCmd& cmd = *static_cast<RemoveCmd*>(p);
+				if (r.valid(cmd.e))
+					r.remove<C...>(cmd.e);
+			}
+		};
+
+		struct DestroyCmd
+		{
+			entt::entity		e;
+
+			static void Apply(entt::registry& r, void* p)
+			{
+				DestroyCmd& cmd = *static_cast<DestroyCmd*>(p);
+				if (r.valid(cmd.e))
+					r.destroy(cmd.e);
+			}
+		};
+
+		template<typename Cmd>
+		static void Discard(void* p) { std::destroy_at(static_cast<Cmd*>(p)); }
+
+		template<typename Cmd, typename... Args>
+		void Record(Args&&... args)
+		{
+			static_assert(alignof(Cmd) <= RECORD_ALIGN, "command payload over-aligned");
+			constexpr uint32 size = (static_cast<uint32>(sizeof(RecordHeader) + sizeof(Cmd)) + RECORD_ALIGN - 1) & ~(RECORD_ALIGN - 1);
+
+			LockGuard guard(m_lock);
+			uint8* ptr = Reserve(size);
+			RecordHeader* header = reinterpret_cast<RecordHeader*>(ptr);
+			header->apply = &Cmd::Apply;
+			header->discard = &Discard<Cmd>;
+			header->size = size;
+			new(ptr + sizeof(RecordHeader)) Cmd{ std::forward<Args>(args)... };
+			m_count.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		uint8*					Reserve(uint32 size);		// under m_lock
+		Chunk					NewChunk(uint32 minSize);	// under m_lock
+		static void				FreeChunk(Chunk& chunk);
+
+	private:
+		Mutex					m_lock;
+		std::vector<Chunk>		m_chunks;			// recording, in order
+		std::vector<Chunk>		m_spare;			// emptied by Apply, reused
+		std::vector<Chunk>		m_applying;			// shard thread only
+		Atomic<uint32>			m_count = 0;
+	};
+}
@@ -1,125 +1,333 @@
 #include "pch.h"
 #include "DeadLockProfiler.h"
+#include "LockStats.h"
+#include "Clock.h"
+#include <bit>
 
 namespace jam::utils::thrd
 {
+	/*--------------------
+		ThreadLockStack
+	---------------------*/
+
+	static constexpr int32 MAX_LOCK_DEPTH = 64;
+
+	struct LockStackEntry
+	{
+		int32			id;
+		LockStats*		stats;
+		uint64			beginNs;		// != 0 : this acquire is sampled
+		uint64			acquiredNs;
+	};
+
+	struct ThreadLockStack
+	{
+		LockStackEntry	entries[MAX_LOCK_DEPTH];
+		int32			depth = 0;
+		int32			skipped = 0;	// pushes beyond MAX_LOCK_DEPTH
+		uint32			epoch = 0;
+		uint32			sampleTick = 0;
+	};
+
+	static thread_local ThreadLockStack tl_LockStack;
+
+	static ThreadLockStack& CurrentStack(uint32 epoch)
+	{
+		// locks taken before the last Enable() are unknown to us: start over
+		ThreadLockStack& stack = tl_LockStack;
+		if (stack.epoch != epoch)
+		{
+			stack.depth = 0;
+			stack.skipped = 0;
+			stack.epoch = epoch;
+		}
+		return stack;
+	}
+
+	static const char* LockName(int32 id)
+	{
+		LockStats* stats = LockStatsRegistry::Instance().FindById(id);
+		return stats ? stats->name : "?";
+	}
+
 	/*--------------------
 		DeadLockProfiler
 	---------------------*/
 
-	void DeadLockProfiler::PushLock(const char* name)
+	void DeadLockProfiler::Enable(const LockProfilerConfig& config)
+	{
+		m_sampleRate.store((std::max)(config.sampleRate, 1u));
+		m_crashOnCycle.store(config.crashOnCycle);
+		m_epoch.fetch_add(1);
+		m_enabled.store(true);
+	}
+
+	void DeadLockProfiler::Disable()
+	{
+		m_enabled.store(false);
+	}
+
+	void DeadLockProfiler::PushLock(LockStats* stats)
 	{
-		LockGuard guard(m_lock);
+		ThreadLockStack& stack = CurrentStack(m_epoch.load(std::memory_order_relaxed));
+		const int32 lockId = stats->id;
 
-		// ̵ ãų ߱Ѵ.
-		int32 lockId = 0;
+		// 잡고 있는 락이 있었다면
+		if (stack.depth > 0)
+		{
+			// 기존에 발견되지 않은 케이스라면 데드락 여부 다시 확인한다.
+			const int32 prevId = stack.entries[stack.depth - 1].id;
+			if (lockId != prevId && !HasEdge(prevId, lockId))
+				RecordEdge(prevId, lockId);
+		}
 
-		auto findIt = m_nameToId.find(name);
-		if (findIt == m_nameToId.end())
+		if (stack.depth == MAX_LOCK_DEPTH)
 		{
-			lockId = static_cast<int32>(m_nameToId.size());
-			m_nameToId[name] = lockId;
-			m_idToName[lockId] = name;
+			stack.skipped++;
+			return;
 		}
-		else
+
+		const bool sampled = (++stack.sampleTick % m_sampleRate.load(std::memory_order_relaxed)) == 0;
+
+		LockStackEntry& entry = stack.entries[stack.depth++];
+		entry.id = lockId;
+		entry.stats = stats;
+		entry.beginNs = sampled ? Clock::Instance().NowNs() : 0;
+		entry.acquiredNs = 0;
+	}
+
+	void DeadLockProfiler::OnAcquired()
+	{
+		ThreadLockStack& stack = tl_LockStack;
+		if (stack.depth == 0 || stack.skipped > 0)
+			return;
+
+		LockStackEntry& entry = stack.entries[stack.depth - 1];
+		if (entry.beginNs == 0)
+			return;
+
+		entry.acquiredNs = Clock::Instance().NowNs();
+		entry.stats->RecordSampledWait(entry.acquiredNs - entry.beginNs);
+	}
+
+	void DeadLockProfiler::PopLock(LockStats* stats)
+	{
+		ThreadLockStack& stack = CurrentStack(m_epoch.load(std::memory_order_relaxed));
+
+		if (stack.skipped > 0)
 		{
-			lockId = findIt->second;
+			stack.skipped--;
+			return;
+		}
+
+		// taken while the profiler was off
+		if (stack.depth == 0)
+			return;
+
+		int32 index = stack.depth - 1;
+		if (stack.entries[index].id != stats->id)
+		{
+#if _DEBUG
+			CRASH("INVALID_UNLOCK");
+#endif
+			while (index >= 0 && stack.entries[index].id != stats->id)
+				index--;
+			if (index < 0)
+				return;
 		}
 
-		//  ִ  ־ٸ
-		if (tl_LockStack.empty() == false)
+		const LockStackEntry entry = stack.entries[index];
+		for (int32 i = index; i < stack.depth - 1; i++)
+			stack.entries[i] = stack.entries[i + 1];
+		stack.depth--;
+
+		if (entry.acquiredNs != 0)
+			entry.stats->RecordSampledHold(Clock::Instance().NowNs() - entry.acquiredNs);
+	}
+
+	std::string DeadLockProfiler::ExportGraph() const
+	{
+		std::string dot = "digraph locks {\n";
+
+		for (int32 from = 0; from < MAX_LOCK_IDS; from++)
 		{
-			//  ߰ߵ  ̽   ٽ ȮѴ.
-			const int32 prevId = tl_LockStack.top();
-			if (lockId != prevId)
+			for (int32 word = 0; word < EDGE_WORDS; word++)
 			{
-				xset<int32>& history = m_lockHistory[prevId];
-				if (history.find(lockId) == history.end())
+				uint64 bits = m_edges[from][word].load(std::memory_order_relaxed);
+				while (bits)
 				{
-					history.insert(lockId);
-					CheckCycle();
+					const int32 to = word * 64 + std::countr_zero(bits);
+					bits &= bits - 1;
+
+					dot += "\t\"";
+					dot += LockName(from);
+					dot += "\" -> \"";
+					dot += LockName(to);
+					dot += "\";\n";
 				}
 			}
 		}
 
-		tl_LockStack.push(lockId);
+		dot += "}\n";
+		return dot;
 	}
 
-	void DeadLockProfiler::PopLock(const char* name)
+	void DeadLockProfiler::Dump(int32 topN) const
 	{
-		LockGuard guard(m_lock);
+		int64 edgeCount = 0;
+		for (int32 from = 0; from < MAX_LOCK_IDS; from++)
+		{
+			for (int32 word = 0; word < EDGE_WORDS; word++)
+				edgeCount += std::popcount(m_edges[from][word].load(std::memory_order_relaxed));
+		}
 
-		if (tl_LockStack.empty())
-			CRASH("MULTIPLE_UNLOCK");
+		LOG_INFO("[Lock] profiler {}, {} order edges", IsEnabled() ? "on" : "off", edgeCount);
+		LockStatsRegistry::Instance().Dump(topN);
+	}
 
-		int32 lockId = m_nameToId[name];
-		if (tl_LockStack.top() != lockId)
-			CRASH("INVALID_UNLOCK");
+	bool DeadLockProfiler::HasEdge(int32 from, int32 to) const
+	{
+		if (from >= MAX_LOCK_IDS || to >= MAX_LOCK_IDS)
+			return true;	// beyond the graph: treat as known, nothing to record
 
-		tl_LockStack.pop();
+		return (m_edges[from][to / 64].load(std::memory_order_relaxed) & (1ull << (to % 64))) != 0;
 	}
 
-	void DeadLockProfiler::CheckCycle()
+	void DeadLockProfiler::RecordEdge(int32 from, int32 to)
 	{
-		const int32 lockCount = static_cast<int32>(m_nameToId.size());
-		m_discoveredOrder = xvector<int32>(lockCount, -1);
-		m_discoveredCount = 0;
-		m_finished = xvector<bool>(lockCount, false);
-		m_parent = xvector<int32>(lockCount, -1);
+		const uint64 bit = 1ull << (to % 64);
+		if (m_edges[from][to / 64].fetch_or(bit, std::memory_order_relaxed) & bit)
+			return;		// another thread recorded it first
 
-		for (int32 lockId = 0; lockId < lockCount; lockId++)
-			Dfs(lockId);
+		// the locking thread only logs; CheckCycles does the search
+		m_edgeCount.fetch_add(1, std::memory_order_release);
 
-		m_discoveredOrder.clear();
-		m_finished.clear();
-		m_parent.clear();
+		const uint32 slot = m_edgeLogHead.fetch_add(1, std::memory_order_relaxed);
+		if (slot < EDGE_LOG_SIZE)
+			m_edgeLog[slot].store(static_cast<uint32>((from + 1) << 16 | (to + 1)), std::memory_order_release);
 	}
 
-	void DeadLockProfiler::Dfs(int32 here)
+	void DeadLockProfiler::CheckCycles()
 	{
-		if (m_discoveredOrder[here] != -1)
+		// an overlapping call has the log already
+		if (m_checkLock.try_lock() == false)
 			return;
 
-		m_discoveredOrder[here] = m_discoveredCount++;
+		// a slot reserved but not written yet waits for the next call
+		if (CheckPendingEdges() && m_edgeLogHead.load(std::memory_order_relaxed) > EDGE_LOG_SIZE)
+			CheckAllEdges();
 
-		auto findIt = m_lockHistory.find(here);
-		if (findIt == m_lockHistory.end())
+		m_checkLock.unlock();
+	}
+
+	bool DeadLockProfiler::CheckPendingEdges()
+	{
+		const uint32 head = (std::min)(m_edgeLogHead.load(std::memory_order_acquire), static_cast<uint32>(EDGE_LOG_SIZE));
+
+		std::vector<int32> path;
+		while (m_edgeLogTail < head)
 		{
-			m_finished[here] = true;
-			return;
+			const uint32 packed = m_edgeLog[m_edgeLogTail].load(std::memory_order_acquire);
+			if (packed == 0)
+				return false;	// slot reserved, not written yet
+
+			m_edgeLogTail++;
+
+			const int32 from = static_cast<int32>(packed >> 16) - 1;
+			const int32 to = static_cast<int32>(packed & 0xFFFF) - 1;
+
+			// new edge from -> to closes a cycle iff from is already reachable from to
+			if (FindPath(to, from, OUT path))
+				ReportCycle(from, to, path);
 		}
 
-		xset<int32>& nextSet = findIt->second;
-		for (int32 there : nextSet)
+		return true;
+	}
+
+	void DeadLockProfiler::CheckAllEdges()
+	{
+		// log full (thousands of distinct edges): new ones are only in the matrix, rescan it when it grew
+		const uint32 edgeCount = m_edgeCount.load(std::memory_order_acquire);
+		if (edgeCount == m_checkedEdgeCount)
+			return;
+
+		m_checkedEdgeCount = edgeCount;
+
+		std::vector<int32> path;
+		for (int32 from = 0; from < MAX_LOCK_IDS; from++)
 		{
-			if (m_discoveredOrder[there] == -1)
+			for (int32 word = 0; word < EDGE_WORDS; word++)
 			{
-				m_parent[there] = here;
-				Dfs(there);
-				continue;
+				uint64 bits = m_edges[from][word].load(std::memory_order_relaxed);
+				while (bits)
+				{
+					const int32 to = word * 64 + std::countr_zero(bits);
+					bits &= bits - 1;
+
+					if (FindPath(to, from, OUT path))
+						ReportCycle(from, to, path);
+				}
 			}
+		}
+	}
+
+	bool DeadLockProfiler::FindPath(int32 from, int32 to, OUT std::vector<int32>& path) const
+	{
+		std::vector<int32> parent(MAX_LOCK_IDS, -1);
+		std::vector<int32> queue;
 
-			if (m_discoveredOrder[here] < m_discoveredOrder[there])
-				continue;
+		parent[from] = from;
+		queue.push_back(from);
 
-			//  ƴϰ, Dfs(there)   ʾҴٸ, there here ̴. ( )
-			if (m_finished[there] == false)
+		for (size_t i = 0; i < queue.size(); i++)
+		{
+			const int32 here = queue[i];
+			if (here == to)
 			{
-				printf("%s -> %s\n", m_idToName[here], m_idToName[there]);
+				path.clear();
+				for (int32 now = to; now != from; now = parent[now])
+					path.push_back(now);
+				path.push_back(from);
+				std::reverse(path.begin(), path.end());
+				return true;
+			}
 
-				int32 now = here;
-				while (true)
+			for (int32 word = 0; word < EDGE_WORDS; word++)
+			{
+				uint64 bits = m_edges[here][word].load(std::memory_order_relaxed);
+				while (bits)
 				{
-					printf("%s -> %s\n", m_idToName[m_parent[now]], m_idToName[now]);
-					now = m_parent[now];
-					if (now == there)
-						break;
-				}
+					const int32 there = word * 64 + std::countr_zero(bits);
+					bits &= bits - 1;
 
-				CRASH("DEADLOCK_DETECTED")
+					if (parent[there] == -1)
+					{
+						parent[there] = here;
+						queue.push_back(there);
+					}
+				}
 			}
 		}
 
-		m_finished[here] = true;
+		return false;
+	}
+
+	void DeadLockProfiler::ReportCycle(int32 from, int32 to, const std::vector<int32>& path)
+	{
+		if (m_reportedCycles.insert(static_cast<uint64>(from) << 32 | static_cast<uint32>(to)).second == false)
+			return;
+
+		// from -> to -> ... -> from
+		std::string cycle = LockName(from);
+		for (int32 id : path)
+		{
+			cycle += " -> ";
+			cycle += LockName(id);
+		}
+
+		LOG_ERROR("[DeadLock] lock order cycle: {}", cycle);
+
+		if (m_crashOnCycle.load())
+			CRASH("DEADLOCK_DETECTED");
 	}
 }
@@ -3,30 +3,83 @@
 
 namespace jam::utils::thrd
 {
+	struct LockStats;
+
+	struct LockProfilerConfig
+	{
+		uint32		sampleRate = 64;		// hold/wait time measured on 1 of N acquires
+#if _DEBUG
+		bool		crashOnCycle = true;
+#else
+		bool		crashOnCycle = false;	// release: log the cycle once and keep running
+#endif
+	};
+
+	/*--------------------
+		DeadLockProfiler
+	---------------------*/
+
+	// Lock-order (A held while taking B) and hold/wait profiler, cheap enough for release builds.
+	// - Per-thread lock stack, no global lock on push/pop.
+	// - Order edges go into a lock-free bit matrix; a never-seen edge is also appended to an edge log.
+	//   The locking thread never searches the graph: CheckCycles drains the log off the lock path
+	//   (GlobalExecutor timer, lockCycleScanIntervalNs) and searches from each new edge only.
+	// - Enabled at runtime (on by default in _DEBUG).
 	class DeadLockProfiler
 	{
 		DECLARE_SINGLETON(DeadLockProfiler)
 
+		enum : int32
+		{
+			MAX_LOCK_IDS = 1024,
+			EDGE_WORDS = MAX_LOCK_IDS / 64,
+			EDGE_LOG_SIZE = 4096
+		};
+
 	public:
-		void										PushLock(const char* name);
-		void										PopLock(const char* name);
-		void										CheckCycle();
+		void										Enable(const LockProfilerConfig& config = {});
+		void										Disable();
+		bool										IsEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
 
-	private:
-		void										Dfs(int32 here);
+		// called by Lock: PushLock before acquiring, OnAcquired after, PopLock on release
+		void										PushLock(LockStats* stats);
+		void										OnAcquired();
+		void										PopLock(LockStats* stats);
+
+		// off the lock path: check the edges logged since the last call for order cycles
+		void										CheckCycles();
+
+		std::string									ExportGraph() const;		// graphviz dot of every order edge seen
+		void										Dump(int32 topN = 16) const;	// lock graph size + top contended locks
 
 	private:
-		xumap<const char*, int32>					m_nameToId;
-		xumap<int32, const char*>					m_idToName;
-		xmap<int32, xset<int32>>					m_lockHistory;
+		void										RecordEdge(int32 from, int32 to);
+		bool										CheckPendingEdges();
+		void										CheckAllEdges();
+		bool										FindPath(int32 from, int32 to, OUT std::vector<int32>& path) const;
+		void										ReportCycle(int32 from, int32 to, const std::vector<int32>& path);
 
-		Mutex										m_lock;
+		bool										HasEdge(int32 from, int32 to) const;
 
 	private:
-		xvector<int32>								m_discoveredOrder;
-		int32										m_discoveredCount = 0;
-		xvector<bool>								m_finished;
-		xvector<int32>								m_parent;
+#if _DEBUG
+		Atomic<bool>								m_enabled{ true };
+#else
+		Atomic<bool>								m_enabled{ false };
+#endif
+		Atomic<uint32>								m_epoch = 1;				// bumps on Enable: stale thread stacks reset
+		Atomic<uint32>								m_sampleRate = LockProfilerConfig{}.sampleRate;
+		Atomic<bool>								m_crashOnCycle = LockProfilerConfig{}.crashOnCycle;
+
+		Atomic<uint64>								m_edges[MAX_LOCK_IDS][EDGE_WORDS] = {};
+
+		Atomic<uint32>								m_edgeLog[EDGE_LOG_SIZE] = {};	// (from+1) << 16 | (to+1)
+		Atomic<uint32>								m_edgeLogHead = 0;
+		uint32										m_edgeLogTail = 0;		// under m_checkLock
+		Atomic<uint32>								m_edgeCount = 0;
+		uint32										m_checkedEdgeCount = 0;	// under m_checkLock, once the log is full
+
+		Mutex										m_checkLock;
+		std::set<uint64>							m_reportedCycles;		// under m_checkLock
 	};
 }
-
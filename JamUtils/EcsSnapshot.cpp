@@ -0,0 +1,212 @@
+#include "pch.h"
+#include "EcsSnapshot.h"
+#include "GlobalExecutor.h"
+#include "Clock.h"
+
+namespace jam::utils::exec
+{
+	uint64 SnapshotSchema::Hash() const
+	{
+		uint64 h = 0xcbf29ce484222325ull ^ SNAPSHOT_VERSION;
+		for (const Section& s : m_sections)
+		{
+			h = (h ^ s.id) * 0x100000001b3ull;
+			h = (h ^ s.elemSize) * 0x100000001b3ull;
+		}
+		return h;
+	}
+
+	ShardSnapshot::ShardSnapshot(SnapshotSchema schema, std::filesystem::path path, uint32 shardIndex)
+		: m_schema(std::move(schema)), m_path(std::move(path)), m_shardIndex(shardIndex)
+	{
+	}
+
+	bool ShardSnapshot::Capture(const entt::registry& R, GlobalExecutor* io)
+	{
+		if (m_writing.exchange(true, std::memory_order_acquire))
+		{
+			m_skipped.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+
+		CaptureTo(R);
+
+		if (io == nullptr)
+		{
+			WriteFile();
+			m_writing.store(false, std::memory_order_release);
+			return true;
+		}
+
+		// blocking file IO: off the IO workers, one lane per file so its writes never reorder
+		const uint64 lane = std::filesystem::hash_value(m_path) | 1;	// 0 is BlockingPool::NO_LANE
+		io->PostBlocking(job::Job([self = shared_from_this()]()
+			{
+				self->WriteFile();
+				self->m_writing.store(false, std::memory_order_release);
+			}), lane);
+		return true;
+	}
+
+	bool ShardSnapshot::Save(const entt::registry& R)
+	{
+		// wait out a periodic write still in flight
+		while (m_writing.exchange(true, std::memory_order_acquire))
+			std::this_thread::yield();
+
+		CaptureTo(R);
+		const bool ok = WriteFile();
+		m_writing.store(false, std::memory_order_release);
+		return ok;
+	}
+
+	void ShardSnapshot::CaptureTo(const entt::registry& R)
+	{
+		const uint64 start = Clock::Instance().NowNs();
+
+		m_staging.clear();		// keeps capacity: no allocation once warmed up
+		SnapshotWriter w(m_staging);
+
+		const size_t headerAt = w.Reserve(sizeof(SnapshotHeader));
+		for (const SnapshotSchema::Section& s : m_schema.Sections())
+		{
+			const size_t sectionAt = w.Reserve(sizeof(SnapshotSectionHeader));
+			w.Align();
+			const size_t bodyAt = w.Offset();
+
+			uint32 count = 0;
+			s.save(R, w, count);
+			w.Align();
+
+			SnapshotSectionHeader sh = {};
+			sh.id = s.id;
+			sh.elemSize = s.elemSize;
+			sh.count = count;
+			sh.bytes = w.Offset() - bodyAt;
+			::memcpy(w.At(sectionAt), &sh, sizeof(sh));
+		}
+
+		SnapshotHeader header = {};
+		header.magic = SNAPSHOT_MAGIC;
+		header.version = SNAPSHOT_VERSION;
+		header.schemaHash = m_schema.Hash();
+		header.payloadSize = w.Offset() - sizeof(SnapshotHeader);
+		header.savedNowNs = start;
+		header.sectionCount = static_cast<uint32>(m_schema.Sections().size());
+		header.shardIndex = m_shardIndex;
+		::memcpy(w.At(headerAt), &header, sizeof(header));
+
+		m_lastCaptureNs.store(Clock::Instance().NowNs() - start, std::memory_order_relaxed);
+	}
+
+	bool ShardSnapshot::WriteFile()
+	{
+		const uint64 start = Clock::Instance().NowNs();
+
+		SnapshotHeader* header = reinterpret_cast<SnapshotHeader*>(m_staging.data());
+		header->checksum = Checksum(m_staging.data() + sizeof(SnapshotHeader), header->payloadSize);
+
+		std::filesystem::path tmp = m_path;
+		tmp += ".tmp";
+
+		{
+			sys::MappedFile file;
+			if (!file.Create(tmp, m_staging.size()))
+			{
+				LOG_ERROR("snapshot: cannot create {}", tmp.string());
+				return false;
+			}
+			::memcpy(file.Data(), m_staging.data(), m_staging.size());
+			if (!file.Flush())
+			{
+				LOG_ERROR("snapshot: flush failed {}", tmp.string());
+				return false;
+			}
+		}
+
+		std::error_code ec;
+		std::filesystem::rename(tmp, m_path, ec);
+		if (ec)
+		{
+			LOG_ERROR("snapshot: rename to {} failed: {}", m_path.string(), ec.message());
+			return false;
+		}
+
+		m_lastWriteNs.store(Clock::Instance().NowNs() - start, std::memory_order_relaxed);
+		return true;
+	}
+
+	bool ShardSnapshot::Restore(entt::registry& R, OUT uint32& entityCount)
+	{
+		entityCount = 0;
+
+		sys::MappedFile file;
+		if (!file.Open(m_path))
+			return false;
+
+		if (file.Size() < sizeof(SnapshotHeader))
+			return false;
+
+		SnapshotHeader header;
+		::memcpy(&header, file.Data(), sizeof(header));
+		if (header.magic != SNAPSHOT_MAGIC || header.version != SNAPSHOT_VERSION)
+		{
+			LOG_WARN("snapshot: {} has an unknown format", m_path.string());
+			return false;
+		}
+		if (header.schemaHash != m_schema.Hash() || header.sectionCount != m_schema.Sections().size())
+		{
+			LOG_WARN("snapshot: {} was written with another schema", m_path.string());
+			return false;
+		}
+		if (header.payloadSize != file.Size() - sizeof(SnapshotHeader)
+			|| header.checksum != Checksum(file.Data() + sizeof(SnapshotHeader), header.payloadSize))
+		{
+			LOG_WARN("snapshot: {} is truncated or corrupt", m_path.string());
+			return false;
+		}
+
+		SnapshotLoadContext ctx;
+		ctx.timeShiftNs = static_cast<int64>(Clock::Instance().NowNs()) - static_cast<int64>(header.savedNowNs);
+
+		SnapshotReader r(file.Data(), file.Size(), sizeof(SnapshotHeader));
+		for (const SnapshotSchema::Section& s : m_schema.Sections())
+		{
+			SnapshotSectionHeader sh;
+			if (!r.Read(sh) || sh.id != s.id || sh.elemSize != s.elemSize)
+			{
+				R.clear();
+				return false;
+			}
+			r.Align();
+
+			const size_t bodyAt = r.Offset();
+			if (!s.load(R, r, sh.count, ctx) || r.Failed())
+			{
+				LOG_ERROR("snapshot: section {} of {} failed to load", s.name, m_path.string());
+				R.clear();		// nothing half-restored
+				return false;
+			}
+			r.Seek(bodyAt + sh.bytes);
+		}
+
+		entityCount = ctx.created;
+		return true;
+	}
+
+	uint64 ShardSnapshot::Checksum(const uint8* data, size_t size)
+	{
+		// FNV-1a over 8-byte words, tail bytewise
+		uint64 h = 0xcbf29ce484222325ull;
+		size_t i = 0;
+		for (; i + sizeof(uint64) <= size; i += sizeof(uint64))
+		{
+			uint64 word;
+			::memcpy(&word, data + i, sizeof(word));
+			h = (h ^ word) * 0x100000001b3ull;
+		}
+		for (; i < size; ++i)
+			h = (h ^ data[i]) * 0x100000001b3ull;
+		return h;
+	}
+}
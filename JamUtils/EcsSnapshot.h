@@ -0,0 +1,288 @@
+#pragma once
+#include "MappedFile.h"
+
+namespace jam::utils::exec
+{
+	class GlobalExecutor;
+
+	inline constexpr uint32 SNAPSHOT_MAGIC = 0x504E534A;		// "JSNP"
+	inline constexpr uint32 SNAPSHOT_VERSION = 1;
+	inline constexpr uint32 SNAPSHOT_ALIGN = 16;				// every column starts on this boundary (file offset)
+
+	// file = header, then per section: section header + body
+	struct SnapshotHeader
+	{
+		uint32		magic;
+		uint32		version;
+		uint64		schemaHash;
+		uint64		checksum;			// of everything after the header
+		uint64		payloadSize;
+		uint64		savedNowNs;			// Clock::NowNs at capture, restored timestamps are rebased on it
+		uint32		sectionCount;
+		uint32		shardIndex;
+	};
+
+	struct SnapshotSectionHeader
+	{
+		uint32		id;
+		uint32		elemSize;			// component columns; 0 for encoded sections
+		uint32		count;
+		uint32		reserved;
+		uint64		bytes;				// body, SNAPSHOT_ALIGN multiple
+	};
+
+	static_assert(sizeof(SnapshotHeader) % SNAPSHOT_ALIGN == 0);
+
+	/*----------------------------------
+		SnapshotWriter / SnapshotReader
+	-----------------------------------*/
+
+	class SnapshotWriter
+	{
+	public:
+		explicit SnapshotWriter(xvector<uint8>& out) : m_out(out) {}
+
+		size_t		Reserve(size_t size)
+		{
+			const size_t offset = m_out.size();
+			m_out.resize(offset + size);
+			return offset;
+		}
+
+		void		Append(const void* data, size_t size)
+		{
+			const size_t offset = Reserve(size);
+			if (size)
+				::memcpy(m_out.data() + offset, data, size);
+		}
+		void		Align() { m_out.resize((m_out.size() + SNAPSHOT_ALIGN - 1) & ~size_t(SNAPSHOT_ALIGN - 1)); }
+
+		template<typename T>
+		void		Write(const T& value)
+		{
+			static_assert(std::is_trivially_copyable_v<T>);
+			Append(&value, sizeof(T));
+		}
+
+		void		WriteBytes(const void* data, uint32 size)
+		{
+			Write(size);
+			Append(data, size);
+		}
+
+		size_t		Offset() const { return m_out.size(); }
+		uint8*		At(size_t offset) { return m_out.data() + offset; }
+
+	private:
+		xvector<uint8>&		m_out;
+	};
+
+	// Bounds-checked view over a mapped snapshot. Offsets are file offsets, so Align() matches the writer.
+	class SnapshotReader
+	{
+	public:
+		SnapshotReader(const uint8* base, size_t size, size_t offset) : m_base(base), m_size(size), m_offset(offset) {}
+
+		const uint8* Take(size_t size)
+		{
+			if (m_failed || size > m_size - m_offset)
+			{
+				m_failed = true;
+				return nullptr;
+			}
+			const uint8* p = m_base + m_offset;
+			m_offset += size;
+			return p;
+		}
+
+		template<typename T>
+		const T*	TakeArray(uint32 count) { return reinterpret_cast<const T*>(Take(size_t(count) * sizeof(T))); }
+
+		template<typename T>
+		bool		Read(OUT T& value)
+		{
+			static_assert(std::is_trivially_copyable_v<T>);
+			const uint8* p = Take(sizeof(T));
+			if (p)
+				::memcpy(&value, p, sizeof(T));
+			return p != nullptr;
+		}
+
+		const uint8* ReadBytes(OUT uint32& size) { return Read(size) ? Take(size) : nullptr; }
+
+		void		Align() { m_offset = (std::min)(m_size, (m_offset + SNAPSHOT_ALIGN - 1) & ~size_t(SNAPSHOT_ALIGN - 1)); }
+		void		Seek(size_t offset) { m_offset = (std::min)(offset, m_size); }
+		size_t		Offset() const { return m_offset; }
+		bool		Failed() const { return m_failed; }
+
+	private:
+		const uint8*		m_base;
+		size_t				m_size;
+		size_t				m_offset;
+		bool				m_failed = false;
+	};
+
+	struct SnapshotLoadContext
+	{
+		int64								timeShiftNs = 0;		// now - savedNowNs
+		uint32								created = 0;
+		xumap<entt::entity, entt::entity>	remap;					// only ids the registry could not reuse
+
+		// Clock::NowNs based timestamp of the old process -> this process (0 stays "unset")
+		uint64 Rebase(uint64 ns) const
+		{
+			if (ns == 0)
+				return 0;
+			const int64 v = static_cast<int64>(ns) + timeShiftNs;
+			return v > 0 ? static_cast<uint64>(v) : 1;
+		}
+
+		// entity of the new registry for a saved id, created on first sight
+		entt::entity Resolve(entt::registry& R, entt::entity saved)
+		{
+			if (auto it = remap.find(saved); it != remap.end())
+				return it->second;
+			if (R.valid(saved))
+				return saved;
+
+			const entt::entity e = R.create(saved);
+			++created;
+			if (e != saved)
+				remap.emplace(saved, e);
+			return e;
+		}
+	};
+
+	/*--------------------
+		SnapshotSchema
+	---------------------*/
+
+	// What a shard snapshot contains, in restore order. Plain components are stored as columns
+	// (entity ids, then the raw component array); anything else is an encoded section with its own codec.
+	// Section ids are hashes of the given names, so renaming a type does not invalidate old files.
+	class SnapshotSchema
+	{
+	public:
+		using SaveFn = void(*)(const entt::registry& R, SnapshotWriter& w, OUT uint32& count);
+		using LoadFn = bool(*)(entt::registry& R, SnapshotReader& r, uint32 count, SnapshotLoadContext& ctx);
+
+		struct Section
+		{
+			uint32			id = 0;
+			uint32			elemSize = 0;
+			const char*		name = "";
+			SaveFn			save = nullptr;
+			LoadFn			load = nullptr;
+		};
+
+		// Fixup runs on each loaded copy before it is emplaced (rebase timestamps, drop handles...)
+		template<typename C, void(*Fixup)(C&, const SnapshotLoadContext&) = nullptr>
+		SnapshotSchema& AddComponent(const char* name)
+		{
+			static_assert(std::is_trivially_copyable_v<C> && !std::is_empty_v<C>, "column components must be plain data; use AddSection");
+			static_assert(alignof(C) <= SNAPSHOT_ALIGN);
+
+			m_sections.push_back(Section{ entt::hashed_string::value(name), static_cast<uint32>(sizeof(C)), name, &SaveColumn<C>, &LoadColumn<C, Fixup> });
+			return *this;
+		}
+
+		SnapshotSchema& AddSection(const char* name, SaveFn save, LoadFn load)
+		{
+			m_sections.push_back(Section{ entt::hashed_string::value(name), 0, name, save, load });
+			return *this;
+		}
+
+		uint64								Hash() const;
+		const std::vector<Section>&			Sections() const { return m_sections; }
+
+	private:
+		template<typename C>
+		static void SaveColumn(const entt::registry& R, SnapshotWriter& w, OUT uint32& count)
+		{
+			const auto* storage = R.storage<C>();		// null until the first emplace
+			count = storage ? static_cast<uint32>(storage->size()) : 0;
+			if (count == 0)
+				return;
+
+			const size_t ids = w.Reserve(size_t(count) * sizeof(entt::entity));
+			w.Align();
+			const size_t comps = w.Reserve(size_t(count) * sizeof(C));
+
+			// packed storage order: sequential reads, sequential writes
+			entt::entity* outIds = reinterpret_cast<entt::entity*>(w.At(ids));
+			C* outComps = reinterpret_cast<C*>(w.At(comps));
+			for (auto [e, c] : storage->each())
+			{
+				*outIds++ = e;
+				::memcpy(outComps++, &c, sizeof(C));
+			}
+		}
+
+		template<typename C, void(*Fixup)(C&, const SnapshotLoadContext&)>
+		static bool LoadColumn(entt::registry& R, SnapshotReader& r, uint32 count, SnapshotLoadContext& ctx)
+		{
+			const entt::entity* ids = r.TakeArray<entt::entity>(count);
+			r.Align();
+			const uint8* comps = r.Take(size_t(count) * sizeof(C));
+			if (ids == nullptr || comps == nullptr)
+				return false;
+
+			for (uint32 i = 0; i < count; ++i)
+			{
+				C c;
+				::memcpy(&c, comps + size_t(i) * sizeof(C), sizeof(C));
+				if constexpr (Fixup != nullptr)
+					Fixup(c, ctx);
+				R.emplace_or_replace<C>(ctx.Resolve(R, ids[i]), std::move(c));
+			}
+			return true;
+		}
+
+	private:
+		std::vector<Section>				m_sections;
+	};
+
+	/*-------------------
+		ShardSnapshot
+	--------------------*/
+
+	// Snapshot file of one shard registry.
+	// Capture() is the only part on the shard tick: it copies the columns into a reused staging buffer.
+	// Checksum, mapping the file and flushing run on the blocking pool; the file is written to "<path>.tmp"
+	// and renamed, so a crash mid-write leaves the previous snapshot intact.
+	class ShardSnapshot : public std::enable_shared_from_this<ShardSnapshot>
+	{
+	public:
+		ShardSnapshot(SnapshotSchema schema, std::filesystem::path path, uint32 shardIndex);
+
+		// shard thread. false (nothing captured) while the previous write is still running
+		bool						Capture(const entt::registry& R, GlobalExecutor* io);
+		// shard thread, blocking: capture and write, for a planned restart
+		bool						Save(const entt::registry& R);
+		// shard thread, into an empty registry. false if the file is missing, corrupt or of another schema
+		bool						Restore(entt::registry& R, OUT uint32& entityCount);
+
+		const std::filesystem::path& GetPath() const { return m_path; }
+		uint64						GetSkippedCount() const { return m_skipped.load(std::memory_order_relaxed); }
+		uint64						GetLastCaptureNs() const { return m_lastCaptureNs.load(std::memory_order_relaxed); }	// duration
+		uint64						GetLastWriteNs() const { return m_lastWriteNs.load(std::memory_order_relaxed); }		// duration
+
+	private:
+		void						CaptureTo(const entt::registry& R);
+		bool						WriteFile();
+
+		static uint64				Checksum(const uint8* data, size_t size);
+
+	private:
+		SnapshotSchema				m_schema;
+		std::filesystem::path		m_path;
+		uint32						m_shardIndex = 0;
+
+		xvector<uint8>				m_staging;			// owned by the writer job while m_writing
+		Atomic<bool>				m_writing = false;
+
+		Atomic<uint64>				m_skipped = 0;
+		Atomic<uint64>				m_lastCaptureNs = 0;
+		Atomic<uint64>				m_lastWriteNs = 0;
+	};
+}
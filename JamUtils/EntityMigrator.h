@@ -0,0 +1,115 @@
+#pragma once
+
+namespace jam::utils::exec
+{
+	/*------------------
+		EntityParcel
+	-------------------*/
+
+	// One entity's components, moved out of a shard registry on the source thread and emplaced
+	// into another shard's registry on the destination thread.
+	class EntityParcel
+	{
+		struct ItemBase
+		{
+			virtual ~ItemBase() = default;
+			virtual void	Apply(entt::registry& R, entt::entity e) = 0;
+		};
+
+		template<typename Fn>
+		struct Item : ItemBase
+		{
+			Fn				fn;
+
+			explicit Item(Fn&& f) : fn(std::move(f)) {}
+			void			Apply(entt::registry& R, entt::entity e) override { fn(R, e); }
+		};
+
+	public:
+		// fn(registry&, entity): destination thread, in Add order
+		template<typename Fn>
+		void			Add(Fn&& fn) { m_items.push_back(std::make_unique<Item<std::decay_t<Fn>>>(std::forward<Fn>(fn))); }
+
+		void			Apply(entt::registry& R, entt::entity e)
+		{
+			for (auto& item : m_items)
+				item->Apply(R, e);
+		}
+
+		bool			IsEmpty() const { return m_items.empty(); }
+
+	private:
+		std::vector<Uptr<ItemBase>>		m_items;
+	};
+
+	/*--------------------
+		EntityMigrator
+	---------------------*/
+
+	// Per-shard list of the component types that follow an entity to another shard
+	// (ShardExecutor::Rebalance). Unregistered components stay behind and die with the source
+	// entity. Packers run in registration order, so register a component before anything that
+	// depends on it being present when emplaced.
+	class EntityMigrator
+	{
+	public:
+		using PackFn	= void(*)(entt::registry& R, entt::entity e, EntityParcel& parcel);
+		using AdoptFn	= void(*)(entt::registry& R, entt::entity e);
+		using PinFn		= bool(*)(const entt::registry& R, entt::entity e);
+
+		// plain component: moved by value
+		template<typename C>
+		void			Register() { Register(&PackComponent<C>); }
+		void			Register(PackFn pack) { m_packers.push_back(pack); }
+
+		// destination thread, once every component of a migrated entity is in place
+		void			OnAdopted(AdoptFn fn) { m_adopted.push_back(fn); }
+
+		// entities holding C stay on their shard whatever their key
+		template<typename C>
+		void			Pin() { m_pins.push_back([](const entt::registry& R, entt::entity e) { return R.all_of<C>(e); }); }
+
+		bool			IsEmpty() const { return m_packers.empty(); }
+		bool			IsPinned(const entt::registry& R, entt::entity e) const
+		{
+			for (PinFn pin : m_pins)
+				if (pin(R, e))
+					return true;
+			return false;
+		}
+
+		// source thread; the caller destroys e afterwards
+		EntityParcel	Pack(entt::registry& R, entt::entity e) const
+		{
+			EntityParcel parcel;
+			for (PackFn pack : m_packers)
+				pack(R, e, parcel);
+			return parcel;
+		}
+
+		void			Adopt(entt::registry& R, entt::entity e) const
+		{
+			for (AdoptFn fn : m_adopted)
+				fn(R, e);
+		}
+
+		template<typename C>
+		static void		PackComponent(entt::registry& R, entt::entity e, EntityParcel& parcel)
+		{
+			if constexpr (std::is_empty_v<C>)
+			{
+				if (R.all_of<C>(e))
+					parcel.Add([](entt::registry& to, entt::entity dst) { to.emplace_or_replace<C>(dst); });
+			}
+			else if (C* c = R.try_get<C>(e))
+			{
+				parcel.Add([v = std::move(*c)](entt::registry& to, entt::entity dst) mutable { to.emplace_or_replace<C>(dst, std::move(v)); });
+			}
+		}
+
+	private:
+		std::vector<PackFn>		m_packers;
+		std::vector<AdoptFn>	m_adopted;
+		std::vector<PinFn>		m_pins;
+	};
+}
@@ -0,0 +1,238 @@
+#pragma once
+
+namespace jam::utils::exec
+{
+	struct EventBusConfig
+	{
+		uint32		ringCapacity = 1024;		// initial slots per event type, rounded up to a power of two
+	};
+
+	// member function pointer -> owning class
+	template<typename Fn>
+	struct MemberFnClass;
+
+	template<typename C, typename R, typename A>
+	struct MemberFnClass<R(C::*)(A)> { using type = C; };
+
+	/*---------------
+		EventRing
+	----------------*/
+
+	// FIFO of one event type. Sized once from EventBusConfig; a full ring doubles instead of dropping,
+	// and the growth is counted so the config can be raised. Shard thread only.
+	template<typename Ev>
+	class EventRing
+	{
+	public:
+		EventRing() = default;
+		~EventRing()
+		{
+			Clear();
+			Free(m_slots);
+		}
+
+		EventRing(const EventRing&) = delete;
+		EventRing& operator=(const EventRing&) = delete;
+
+		void Init(uint32 capacity)
+		{
+			ASSERT_CRASH(m_slots == nullptr);
+			m_capacity = std::bit_ceil((std::max)(capacity, 2u));
+			m_slots = Alloc(m_capacity);
+		}
+
+		void Push(Ev&& ev)
+		{
+			if (m_tail - m_head == m_capacity)
+				Grow();
+			new(&m_slots[m_tail & (m_capacity - 1)]) Ev(std::move(ev));
+			++m_tail;
+		}
+
+		Ev* Back() { return (m_tail == m_head) ? nullptr : &m_slots[(m_tail - 1) & (m_capacity - 1)]; }
+
+		Ev Pop()
+		{
+			Ev& slot = m_slots[m_head & (m_capacity - 1)];
+			Ev ev(std::move(slot));
+			std::destroy_at(&slot);
+			++m_head;
+			return ev;
+		}
+
+		void Clear()
+		{
+			while (m_head != m_tail)
+				Pop();
+		}
+
+		uint32		Size() const { return m_tail - m_head; }
+		uint32		Capacity() const { return m_capacity; }
+		uint32		GetGrowCount() const { return m_growCount; }
+		uint64		GetMergedCount() const { return m_mergedCount; }
+		void		AddMerged() { ++m_mergedCount; }
+
+		void*		handler = nullptr;		// bound by EventBus::Bind
+
+	private:
+		static Ev* Alloc(uint32 count)
+		{
+			return static_cast<Ev*>(memory::PoolAllocator::Alloc(static_cast<int32>(count * sizeof(Ev)), memory::eMemTag::ECS_STORE));
+		}
+
+		static void Free(Ev* slots)
+		{
+			if (slots)
+				memory::PoolAllocator::Release(slots);
+		}
+
+		void Grow()
+		{
+			const uint32 capacity = m_capacity * 2;
+			Ev* slots = Alloc(capacity);
+
+			const uint32 size = Size();
+			for (uint32 i = 0; i < size; ++i)
+			{
+				Ev& from = m_slots[(m_head + i) & (m_capacity - 1)];
+				new(&slots[i]) Ev(std::move(from));
+				std::destroy_at(&from);
+			}
+
+			Free(m_slots);
+			m_slots = slots;
+			m_capacity = capacity;
+			m_head = 0;
+			m_tail = size;
+			++m_growCount;
+		}
+
+	private:
+		Ev*			m_slots = nullptr;
+		uint32		m_capacity = 0;
+		uint32		m_head = 0;				// free-running, masked on access
+		uint32		m_tail = 0;
+		uint32		m_growCount = 0;
+		uint64		m_mergedCount = 0;
+	};
+
+	/*--------------
+		EventBus
+	---------------*/
+
+	// Replaces entt::dispatcher for a closed set of event types: one ring per type, no type-erased
+	// pools or delegates. Drain() visits the types in list order, so the order is part of the design
+	// (an event posted to a later type during Drain is delivered in the same pass).
+	//
+	// Routing is resolved at compile time. For each Ev, ADL must find
+	//     constexpr auto EventRoute(std::type_identity<Ev>) { return &Handler::Fn; }
+	// and Bind<Ev>(Handler*) supplies the instance. Events without a bound handler are dropped.
+	//
+	// An event type with `bool Merge(const Ev& next)` is coalesced: Post() first offers the new event
+	// to the last queued one of the same type, so runs of counter events cost one slot.
+	template<typename... Events>
+	class EventBus
+	{
+	public:
+		explicit EventBus(const EventBusConfig& config = {})
+		{
+			std::apply([&](auto&... ring) { (ring.Init(config.ringCapacity), ...); }, m_rings);
+		}
+
+		template<typename Ev>
+		void Post(Ev&& ev)
+		{
+			using E = std::remove_cvref_t<Ev>;
+			EventRing<E>& ring = std::get<EventRing<E>>(m_rings);
+
+			if constexpr (requires(E& a, const E& b) { { a.Merge(b) } -> std::convertible_to<bool>; })
+			{
+				if (E* back = ring.Back(); back && back->Merge(ev))
+				{
+					ring.AddMerged();
+					return;
+				}
+			}
+
+			E copy(std::forward<Ev>(ev));
+			ring.Push(std::move(copy));
+		}
+
+		template<typename Ev, typename Handler>
+		void Bind(Handler* handler)
+		{
+			using Route = decltype(EventRoute(std::type_identity<Ev>{}));
+			static_assert(std::is_same_v<typename MemberFnClass<Route>::type, Handler>, "handler type does not match EventRoute");
+			std::get<EventRing<Ev>>(m_rings).handler = handler;
+		}
+
+		void Drain()
+		{
+			std::apply([](auto&... ring) { (DrainRing(ring), ...); }, m_rings);
+		}
+
+		template<typename Ev>
+		const EventRing<Ev>& Ring() const { return std::get<EventRing<Ev>>(m_rings); }
+
+	private:
+		template<typename Ev>
+		static void DrainRing(EventRing<Ev>& ring)
+		{
+			constexpr auto route = EventRoute(std::type_identity<Ev>{});
+			using Handler = typename MemberFnClass<std::remove_const_t<decltype(route)>>::type;
+
+			// only what is queued now; handlers may post more of the same type for the next Drain
+			uint32 count = ring.Size();
+			if (ring.handler == nullptr)
+			{
+				while (count-- > 0)
+					ring.Pop();
+				return;
+			}
+
+			Handler* handler = static_cast<Handler*>(ring.handler);
+			while (count-- > 0)
+			{
+				// moved out first: the handler may post into (and grow) this ring
+				Ev ev = ring.Pop();
+				(handler->*route)(ev);
+			}
+		}
+
+	private:
+		std::tuple<EventRing<Events>...>	m_rings;
+	};
+
+	/*------------------
+		EventBusSlot
+	-------------------*/
+
+	// Type-erased owner of a shard's EventBus, so ShardLocal does not depend on the event set
+	// (JamNet installs its bus at RegisterNetEcs).
+	class EventBusSlot
+	{
+	public:
+		template<typename Bus>
+		Bus& Install(const EventBusConfig& config)
+		{
+			ASSERT_CRASH(m_bus == nullptr);
+			auto bus = memory::MakeShared<Bus>(config);
+			m_bus = bus;
+			m_drain = [](void* p) { static_cast<Bus*>(p)->Drain(); };
+			return *bus;
+		}
+
+		template<typename Bus>
+		Bus& Get() { return *static_cast<Bus*>(m_bus.get()); }
+
+		void Drain()
+		{
+			if (m_drain)
+				m_drain(m_bus.get());
+		}
+
+	private:
+		Sptr<void>				m_bus;
+		void					(*m_drain)(void*) = nullptr;
+	};
+}
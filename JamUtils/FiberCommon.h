@@ -46,7 +46,7 @@ namespace jam::utils::thrd
 		std::atomic<int>  m_cancelCode{ static_cast<int>(eCancelCode::NONE) };
 	};
 
-	//  
+	// 프로파일 샘플
 	struct ProfileSample
 	{
 		uint64 stepCount = 0;
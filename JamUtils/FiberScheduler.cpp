@@ -35,9 +35,9 @@ namespace jam::utils::thrd
 	{
 		const uint32 id = m_nextId++;
 
-		Fiber* f = FiberPool::Pop();
-		*f = Fiber{};
-		
+		// record in the pool under the FIBER tag; the stack itself is OS memory (CreateFiberEx)
+		Fiber* f = memory::xnew<Fiber, memory::eMemTag::FIBER>();
+
 		f->id			= id;
 		f->name			= desc.name;
 		f->reserve		= desc.stackReserve ? desc.stackReserve : kDefReserve;
@@ -88,7 +88,7 @@ namespace jam::utils::thrd
 			f->deadline_ns = deadline_ns;
 			m_sleepPQ.push({ deadline_ns, f->id });
 		}
-		m_backend.SwitchTo(m_main); // 簳Ǹ Ʒ ̾
+		m_backend.SwitchTo(m_main); // 재개되면 아래로 이어짐
 		return (f->resume == eResumeCode::SIGNALED);
 	}
 
@@ -150,7 +150,7 @@ namespace jam::utils::thrd
 	{
 		static thread_local std::unique_ptr<moodycamel::ProducerToken> tl_spawnPtok;
 		if (!tl_spawnPtok)
-			tl_spawnPtok = std::make_unique<moodycamel::ProducerToken>(m_spawnInbox);	// resumeInbox  spawnInbox  о  producer token  ǳ??
+			tl_spawnPtok = std::make_unique<moodycamel::ProducerToken>(m_spawnInbox);	// resumeInbox 와 spawnInbox 의 구분없이 같은 producer token을 만들어도 되나??
 
 		m_spawnInbox.enqueue(*tl_spawnPtok, SpawnMsg{ std::move(fn), desc });
 	}
@@ -187,15 +187,15 @@ namespace jam::utils::thrd
 
 	void FiberScheduler::Poll(int32 budget, uint64 now_ns)
 	{
-		const uint64 pollStart_ns = Clock::Instance().NowNs();
+		const uint64 pollStart_ns = now_ns;
 
-		// 0) ιڽ  ó
+		// 0) 인박스 먼저 처리
 		DrainInbox();
 
-		// 1) Ÿ̸/ŸӾƿ 
+		// 1) 타이머/타임아웃 기상
 		WakeupTimed(now_ns);
 
-		// 2) ready  (budget ŭ)
+		// 2) ready 실행 (budget 만큼)
 		int steps = 0;
 		while (steps < budget && !m_readyPQ.empty()) 
 		{
@@ -208,18 +208,18 @@ namespace jam::utils::thrd
 
 			Fiber* f = it->second;
 
-			// READY ƴϰų(߰  ٲ), ̹ ٸ pop Һ stale Ʈ ŵ
+			// READY가 아니거나(중간에 상태 바뀜), 이미 다른 pop에서 소비된 stale 엔트리라면 스킵
 			if (f->state != eFiberState::READY || !f->inReadyQ)
 				continue;
 
-			//    Ʈ  ࿡ Һ
+			// ★ 이제 이 엔트리는 이 실행에서 소비됨
 			f->inReadyQ = false;
 
 			BindFls(f);
 			m_currentId = id;
 			StartRun(f);
 
-			m_backend.SwitchTo(f->ctx); // ̹     Yield/Suspend/Terminate   
+			m_backend.SwitchTo(f->ctx); // 파이버 한 스텝 실행 → Yield/Suspend/Terminate 시 메인 복귀
 
 			EndRun(f);
 			m_currentId = 0;
@@ -231,14 +231,15 @@ namespace jam::utils::thrd
 				m_backend.DestroyFiber(f->ctx);
 				Fiber* dead = f;
 				m_fibers.erase(id);
-				FiberPool::Push(dead);
+				memory::xdelete(dead);
 			}
 		}
 
-		// 3)    ð     
-		WakeupTimed(Clock::Instance().NowNs());
+		// 3) 실행 중 경과된 시간 기준으로 한 번 더 기상
+		if (steps > 0)
+			WakeupTimed(Clock::Instance().UpdateLoopNow());
 
-		// 3) ιڽ    (Ͻá)
+		// 3) 인박스 한 번 더 비우기(레이턴시↓)
 		DrainInbox();
 		const uint64 pollEnd_ns = Clock::Instance().NowNs();
 		m_profile.lastPollCost_ns = pollEnd_ns - pollStart_ns;
@@ -268,7 +269,7 @@ namespace jam::utils::thrd
 		self->BindFls(f);
 
 		try {
-			f->entry(); //  ڵ
+			f->entry(); // 사용자 코드
 		}
 		catch (const std::exception& e) {
 			self->OnFiberException(id, e.what());
@@ -289,7 +290,7 @@ namespace jam::utils::thrd
 
 		Fiber* f = it->second;
 		if (f->state == eFiberState::READY && f->inReadyQ)
-			return; // ̹ ť 
+			return; // 이미 큐에 있음
 
 		f->state = eFiberState::READY;
 		f->inReadyQ = true;
@@ -391,7 +392,7 @@ namespace jam::utils::thrd
 					auto w = m_waitMap.find(f->awaitKey);
 					if (w != m_waitMap.end() && w->second == id)
 					{
-						m_waitMap.erase(w);        // ŸӾƿ  
+						m_waitMap.erase(w);        // 타임아웃으로 소유 제거
 					}
 					f->resume = eResumeCode::TIMEOUT;
 					f->awaitKey = 0;
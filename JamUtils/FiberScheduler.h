@@ -28,7 +28,7 @@ namespace jam::utils::thrd
 		uint32      SpawnFiber(FiberFn fn, const FiberDesc& desc = {});
 		void        YieldFiber();
 		void        SleepUntil(uint64 wakeup_ns);
-		bool        Suspend(AwaitKey key, uint64 deadline_ns); // true=, false=ŸӾƿ/
+		bool        Suspend(AwaitKey key, uint64 deadline_ns); // true=정상, false=타임아웃/취소
 
         // inside
 		bool        Resume(AwaitKey key);
@@ -142,9 +142,6 @@ namespace jam::utils::thrd
         };
 
 
-        using FiberPool = jam::utils::memory::ObjectPool<Fiber>;
-
-
 
         static VOID WINAPI          Trampoline(void* p);
 
@@ -190,7 +187,7 @@ namespace jam::utils::thrd
 
         ProfileSample                                                       m_profile = {};
 
-        // ⺻  ũ
+        // 기본 스택 크기
         static constexpr size_t kDefReserve = 512 * 1024;
         static constexpr size_t kDefCommit = 128 * 1024;
 	};
@@ -4,13 +4,25 @@
 #include "ShardDirectory.h"
 #include "ShardExecutor.h"
 #include "ShardEndpoint.h"
+#include "ShardTLS.h"
+#include "DeadLockProfiler.h"
+#include <latch>
 
 
 namespace jam::utils::exec
 {
+	static constexpr int32 IO_PARK_TIMEOUT_MS = 100;		// safety net; wakeups are explicit
+	static constexpr int32 MAX_ASSISTS_PER_ROUND = 8;
+	static constexpr uint32 MAX_STEAL_BATCH = 32;
+
+	// set on IO worker threads: Post from inside the pool goes to the local deque
+	static thread_local GlobalExecutor*	tl_IoExecutor = nullptr;
+	static thread_local int32			tl_IoIndex = -1;
+
 	GlobalExecutor::GlobalExecutor(const GlobalExecutorConfig& config)
 		: m_config(config)
 	{
+		m_blocking = std::make_unique<BlockingPool>(m_config.blockingCfg);
 	}
 
 	GlobalExecutor::~GlobalExecutor()
@@ -40,12 +52,30 @@ namespace jam::utils::exec
 
 		m_directory->Start();
 
+		// every IoWorker exists before any thread runs: thieves index m_workers freely
 		m_workers.reserve(m_config.layout.io);
 		for (int32 i = 0; i < m_config.layout.io; ++i)
-			m_workers.emplace_back(&GlobalExecutor::WorkerLoop, this);
+			m_workers.push_back(std::make_unique<IoWorker>());
+		for (int32 i = 0; i < m_config.layout.io; ++i)
+			m_workers[i]->thread = std::thread(&GlobalExecutor::WorkerLoop, this, i);
 
 		if (m_config.layout.timers > 0)
 			m_timerThread = std::thread(&GlobalExecutor::TimerLoop, this);
+
+		m_blocking->Start();
+
+		if (m_config.memoryReportIntervalNs > 0)
+			ScheduleMemoryReport();
+
+		if (m_config.lockCycleScanIntervalNs > 0)
+			ScheduleLockCycleScan();
+
+		if (m_config.autoTune)
+		{
+			m_tuner = std::make_unique<AutoTuner>(m_config.autoTuneCfg);
+			m_lastTuneNs = Clock::Instance().NowNs();
+			ScheduleAutoTune();
+		}
 	}
 
 	void GlobalExecutor::Stop()
@@ -54,28 +84,45 @@ namespace jam::utils::exec
 			return;
 
 		m_directory->StopAll();
+		m_blocking->Stop();
 
-		m_offload.enqueue(job::Job([] {}));
 		m_timerCv.notify_all();
-		m_assist.enqueue(UINT32_MAX);
+		for (auto& worker : m_workers)
+			worker->wake.release();
 	}
 
 	void GlobalExecutor::Join()
 	{
 		m_directory->JoinAll();
 
-		for (auto& t : m_workers)
-			if (t.joinable()) t.join();
+		for (auto& worker : m_workers)
+			if (worker->thread.joinable()) worker->thread.join();
 
 		m_workers.clear();
 
 		if (m_timerThread.joinable())
 			m_timerThread.join();
+
+		m_blocking->Join();
 	}
 
 	void GlobalExecutor::Post(job::Job job)
 	{
-		m_offload.enqueue(std::move(job));
+		if (tl_IoExecutor == this)
+		{
+			IoWorker& self = *m_workers[tl_IoIndex];
+			{
+				LockGuard guard(self.lock);
+				self.local.push_back(std::move(job));
+			}
+			self.localSize.fetch_add(1, std::memory_order_relaxed);
+		}
+		else
+		{
+			m_injection.enqueue(std::move(job));
+		}
+
+		WakeOne();
 	}
 
 	void GlobalExecutor::PostAfter(job::Job job, uint64 delay_ns)
@@ -87,50 +134,430 @@ namespace jam::utils::exec
 		m_timerCv.notify_one();
 	}
 
+	Sptr<ShardExecutor> GlobalExecutor::AddShard(const ShardInitFn& init)
+	{
+		ASSERT_CRASH(ShardTLS::GetCurrent() == nullptr);
+
+		LockGuard guard(m_resizeLock);
+		if (!m_running.load())
+			return nullptr;
+
+		auto shard = m_directory->CreateShard();
+		if (init)
+			init(*shard);
+		shard->Start();
+
+		const auto existing = m_directory->Shards();
+		m_directory->AppendShard(shard);
+		RebalanceAll(existing);
+
+		LOG_INFO("executor: shard {} added, {} shards", shard->GetIndex(), m_directory->Size());
+		return shard;
+	}
+
+	bool GlobalExecutor::RemoveShard()
+	{
+		ASSERT_CRASH(ShardTLS::GetCurrent() == nullptr);
+
+		LockGuard guard(m_resizeLock);
+		if (!m_running.load() || m_directory->Size() <= 1)
+			return false;
+
+		// 1) no new routing: the table without it is published, its slot drains
+		Sptr<ShardExecutor> retiring = m_directory->DetachLastShard();
+
+		// 2) hand-over on its own thread
+		RebalanceAll({ retiring });
+
+		// 3) forwarded ready entries, ingress and shard jobs run out
+		Clock& clock = Clock::Instance();
+		const uint64 deadline = clock.NowNs() + m_config.shardDrainTimeout_ns;
+		while (!retiring->IsDrained() && clock.NowNs() < deadline)
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+		if (!retiring->IsDrained())
+			LOG_WARN("executor: shard {} stopped with work still queued", retiring->GetIndex());
+
+		retiring->Stop();
+		retiring->Join();
+
+		LOG_INFO("executor: shard {} removed, {} shards", retiring->GetIndex(), m_directory->Size());
+		return true;
+	}
+
+	/*---- scatter / gather ----*/
+
+	void ScatterJoin::Wait() const
+	{
+		ASSERT_CRASH(!ShardTLS::IsShardThread());
+		m_done.wait(false, std::memory_order_acquire);
+	}
+
+	void ScatterJoin::Finish()
+	{
+		m_done.store(true, std::memory_order_release);
+		m_done.notify_all();
+	}
+
+	struct GlobalExecutor::ScatterTask
+	{
+		Sptr<ShardDirectory>				directory;
+		uint32								pieces = 0;
+		ScatterPieceFn						piece;
+		ScatterDoneFn						done;
+		Sptr<ScatterJoin>					join;
+
+		Atomic<uint32>						next{ 0 };
+		Atomic<uint32>						remaining{ 0 };
+
+		void FinishPiece()
+		{
+			if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			{
+				if (done)
+					done();
+				join->Finish();
+			}
+		}
+	};
+
+	// piece i goes to shard i % count, or the next running one after it
+	static Sptr<ShardExecutor> PieceShard(const ShardDirectory& dir, uint32 index)
+	{
+		const uint64 count = dir.Size();
+		for (uint64 i = 0; i < count; ++i)
+		{
+			Sptr<ShardExecutor> shard = dir.ShardAt((index + i) % count);
+			if (shard != nullptr && shard->IsRunning())
+				return shard;
+		}
+		return nullptr;
+	}
+
+	Sptr<ScatterJoin> GlobalExecutor::Scatter(uint32 pieces, ScatterPieceFn piece, ScatterDoneFn done, const ScatterOptions& opt)
+	{
+		return Scatter(pieces, std::move(piece), std::move(done), opt, memory::MakeShared<ScatterJoin>());
+	}
+
+	Sptr<ScatterJoin> GlobalExecutor::Scatter(uint32 pieces, ScatterPieceFn piece, ScatterDoneFn done, const ScatterOptions& opt, Sptr<ScatterJoin> join)
+	{
+		auto task = memory::MakeShared<ScatterTask>();
+		task->directory = m_directory;
+		task->pieces = (m_directory == nullptr || m_directory->Size() == 0) ? 0 : pieces;
+		task->piece = std::move(piece);
+		task->done = std::move(done);
+		task->join = join;
+		task->remaining.store(task->pieces, std::memory_order_relaxed);
+
+		if (task->pieces == 0)
+		{
+			if (task->done)
+				task->done();
+			join->Finish();
+			return join;
+		}
+
+		// the rest start as earlier ones finish
+		const uint32 initial = (opt.maxInFlight == 0) ? task->pieces : (std::min)(opt.maxInFlight, task->pieces);
+		for (uint32 i = 0; i < initial; ++i)
+			LaunchPiece(task);
+		return join;
+	}
+
+	void GlobalExecutor::LaunchPiece(const Sptr<ScatterTask>& task)
+	{
+		for (;;)
+		{
+			const uint32 index = task->next.fetch_add(1, std::memory_order_relaxed);
+			if (index >= task->pieces)
+				return;
+
+			// resolved now, not at Scatter: a retired shard's loop never comes back for it
+			Sptr<ShardExecutor> shard = PieceShard(*task->directory, index);
+			if (shard == nullptr)
+			{
+				// executor stopping: counted, not run, and the next piece takes this one's slot
+				LOG_WARN("scatter: no running shard, piece {} skipped", index);
+				task->FinishPiece();
+				continue;
+			}
+
+			shard->Submit(job::Job([task, shard, index]
+				{
+					// a throwing piece still counts, or the join would never complete
+					try { task->piece(*shard, index); }
+					catch (...) { LOG_WARN("scatter: piece {} threw on shard {}", index, shard->GetIndex()); }
+
+					LaunchPiece(task);
+					task->FinishPiece();
+				}));
+			return;
+		}
+	}
+
+	Sptr<ScatterJoin> GlobalExecutor::ForEachShard(std::function<void(ShardExecutor&)> fn, ScatterDoneFn done, const ScatterOptions& opt)
+	{
+		return Scatter(GetShardCount(), [fn = std::move(fn)](ShardExecutor& shard, uint32) { fn(shard); }, std::move(done), opt);
+	}
+
+	Sptr<ScatterJoin> GlobalExecutor::ParallelFor(uint64 begin, uint64 end, std::function<void(ShardExecutor&, uint64)> fn, ScatterDoneFn done, const ScatterOptions& opt)
+	{
+		const uint64 range = (end > begin) ? end - begin : 0;
+		const uint64 shards = (std::max)<uint64>(GetShardCount(), 1);
+		const uint64 grain = (opt.grain != 0) ? opt.grain : (std::max)<uint64>((range + shards - 1) / shards, 1);
+		const uint32 pieces = static_cast<uint32>((range + grain - 1) / grain);
+
+		return Scatter(pieces, [fn = std::move(fn), begin, end, grain](ShardExecutor& shard, uint32 piece)
+			{
+				const uint64 lo = begin + piece * grain;
+				const uint64 hi = (std::min)(end, lo + grain);
+				for (uint64 i = lo; i < hi; ++i)
+					fn(shard, i);
+			}, std::move(done), opt);
+	}
+
+	void GlobalExecutor::RebalanceAll(const std::vector<Sptr<ShardExecutor>>& shards)
+	{
+		std::latch done(static_cast<ptrdiff_t>(shards.size()));
+		for (const auto& shard : shards)
+		{
+			shard->Submit(job::Job([shard, dir = m_directory, &done]
+				{
+					shard->Rebalance(dir->Table());
+					done.count_down();
+				}));
+		}
+		done.wait();
+	}
+
 	void GlobalExecutor::RequestAssist(uint32 shardIndex)
 	{
 		m_assist.enqueue(shardIndex);
+		WakeOne();
 	}
 
+	void GlobalExecutor::ScheduleMemoryReport()
+	{
+		PostAfter(job::Job([weak = weak_from_this()]
+			{
+				auto self = weak.lock();
+				if (!self || !self->m_running.load())
+					return;
 
-	void GlobalExecutor::WorkerLoop()
+				memory::MemoryManager::Instance().DumpStats();
+				self->ScheduleMemoryReport();
+			}), m_config.memoryReportIntervalNs);
+	}
+
+	void GlobalExecutor::ScheduleAutoTune()
 	{
-		while (m_running.load())
+		PostAfter(job::Job([weak = weak_from_this()]
+			{
+				auto self = weak.lock();
+				if (!self || !self->m_running.load())
+					return;
+
+				const uint64 now_ns = Clock::Instance().NowNs();
+				self->m_tuner->Step(self->GetShards(), now_ns - self->m_lastTuneNs);
+				self->m_lastTuneNs = now_ns;
+				self->ScheduleAutoTune();
+			}), m_config.autoTuneCfg.period_ns);
+	}
+
+	void GlobalExecutor::ScheduleLockCycleScan()
+	{
+		PostAfter(job::Job([weak = weak_from_this()]
+			{
+				auto self = weak.lock();
+				if (!self || !self->m_running.load())
+					return;
+
+				// IO worker, never the locking thread
+				thrd::DeadLockProfiler::Instance().CheckCycles();
+				self->ScheduleLockCycleScan();
+			}), m_config.lockCycleScanIntervalNs);
+	}
+
+
+	void GlobalExecutor::WorkerLoop(int32 index)
+	{
+		tl_IoExecutor = this;
+		tl_IoIndex = index;
+
+		IoWorker& self = *m_workers[index];
+		moodycamel::ConsumerToken ctok(m_injection);
+		uint32 idleRounds = 0;
+
+		while (m_running.load(std::memory_order_relaxed))
 		{
-			// 1) ε
-			job::Job j([] {});
-			if (m_offload.wait_dequeue_timed(j, 1))
+			// 1) Assist 요청 처리
+			bool didWork = RunAssists();
+
+			// 2) 오프로딩 (local -> injection -> steal)
+			job::Job j;
+			if (PopLocal(self, j) || m_injection.try_dequeue(ctok, j) || Steal(index, j))
+			{
 				j.Execute();
+				didWork = true;
+			}
+
+			if (didWork)
+			{
+				idleRounds = 0;
+				continue;
+			}
+
+			if (++idleRounds < m_config.ioSpinRounds)
+			{
+				std::this_thread::yield();
+				continue;
+			}
+
+			idleRounds = 0;
+			Park(self);
+		}
+
+		tl_IoExecutor = nullptr;
+		tl_IoIndex = -1;
+	}
+
+	bool GlobalExecutor::RunAssists()
+	{
+		uint32 shardIdx = UINT32_MAX;
+		int32 count = 0;
+		while (count < MAX_ASSISTS_PER_ROUND && m_assist.try_dequeue(shardIdx))
+		{
+			if (auto shard = GetShard(shardIdx))
+			{
+				// 짧게 한 번만 보조
+				ShardTuning& tuning = shard->Tuning();
+				shard->AssistDrainOnce(tuning.assistMailboxes.load(std::memory_order_relaxed), tuning.assistBudget.load(std::memory_order_relaxed));
+			}
+			++count;
+		}
+		return count > 0;
+	}
+
+	bool GlobalExecutor::PopLocal(IoWorker& self, OUT job::Job& job)
+	{
+		if (self.localSize.load(std::memory_order_relaxed) == 0)
+			return false;
+
+		LockGuard guard(self.lock);
+		if (self.local.empty())
+			return false;
+
+		job = std::move(self.local.back());
+		self.local.pop_back();
+		self.localSize.fetch_sub(1, std::memory_order_relaxed);
+		return true;
+	}
+
+	bool GlobalExecutor::Steal(int32 index, OUT job::Job& job)
+	{
+		const int32 count = static_cast<int32>(m_workers.size());
+		IoWorker& self = *m_workers[index];
+
+		for (int32 n = 1; n < count; ++n)
+		{
+			IoWorker& victim = *m_workers[(index + n) % count];
+			if (victim.localSize.load(std::memory_order_relaxed) == 0)
+				continue;
+
+			// take half of the victim's queue (oldest first), run one, keep the rest
+			std::array<job::Job, MAX_STEAL_BATCH> batch;
+			uint32 taken = 0;
+			{
+				LockGuard guard(victim.lock);
+				const uint32 want = (std::min)(static_cast<uint32>((victim.local.size() + 1) / 2), MAX_STEAL_BATCH);
+				for (; taken < want; ++taken)
+				{
+					batch[taken] = std::move(victim.local.front());
+					victim.local.pop_front();
+				}
+				victim.localSize.fetch_sub(taken, std::memory_order_relaxed);
+			}
+
+			if (taken == 0)
+				continue;
 
-			// 2) Assist û ó
-			uint32 shardIdx = UINT32_MAX;
-			while (m_assist.try_dequeue(shardIdx))
+			job = std::move(batch[0]);
+
+			if (taken > 1)
 			{
-				if (!m_running.load() || shardIdx == UINT32_MAX)
-					break;
-				if (auto shard = GetShard(shardIdx))
 				{
-					// ª   
-					shard->AssistDrainOnce(/*maxMailboxes*/ 16, /*budgetPerMailbox*/ 16);
+					LockGuard guard(self.lock);
+					for (uint32 i = 1; i < taken; ++i)
+						self.local.push_back(std::move(batch[i]));
 				}
+				self.localSize.fetch_add(taken - 1, std::memory_order_relaxed);
+			}
+			return true;
+		}
+		return false;
+	}
+
+	bool GlobalExecutor::HasPendingWork() const
+	{
+		if (m_injection.size_approx() > 0 || m_assist.size_approx() > 0)
+			return true;
+
+		for (const auto& worker : m_workers)
+			if (worker->localSize.load(std::memory_order_relaxed) > 0)
+				return true;
+
+		return false;
+	}
+
+	void GlobalExecutor::Park(IoWorker& self)
+	{
+		// tokens left by a wakeup that lost the race with our own timeout
+		while (self.wake.try_acquire()) {}
+
+		// publish "parked" before the last look at the queues; producers enqueue then check
+		self.parked.store(true);
+		m_parkedCount.fetch_add(1);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		if (m_running.load() && !HasPendingWork())
+			self.wake.try_acquire_for(std::chrono::milliseconds(IO_PARK_TIMEOUT_MS));
+
+		// whoever flips parked back owns the count
+		if (self.parked.exchange(false))
+			m_parkedCount.fetch_sub(1);
+	}
+
+	void GlobalExecutor::WakeOne()
+	{
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (m_parkedCount.load(std::memory_order_relaxed) == 0)
+			return;
+
+		for (auto& worker : m_workers)
+		{
+			if (worker->parked.load(std::memory_order_relaxed) && worker->parked.exchange(false))
+			{
+				m_parkedCount.fetch_sub(1);
+				worker->wake.release();
+				return;
 			}
 		}
 	}
 
 	void GlobalExecutor::TimerLoop()
 	{
-		using namespace std::chrono; //  (steady_clock, nanoseconds)
+		using namespace std::chrono; // 편의 (steady_clock, nanoseconds)
 
 		std::unique_lock lk(m_timerMutex);
 
 		while (m_running.load())
 		{
-			//    (Ǵ ) 
+			// 아이템 생길 때까지 (또는 종료까지) 대기
 			m_timerCv.wait(lk, [this] { return !m_running.load() || !m_timedItems.empty(); });
 			if (!m_running.load()) break;
 			if (m_timedItems.empty()) continue;
 
-			//   ̸ Ÿ̸  (pq: top  ̸ due )
+			// 현재 가장 이른 타이머 선정 (pq: top이 가장 이른 due여야 함)
 			TimedItem top = m_timedItems.top();
 			m_timedItems.pop();
 
@@ -141,40 +568,40 @@ namespace jam::utils::exec
 			{
 				const uint64 now_ns = Clock::Instance().NowNs();
 				if (now_ns >= target_ns)
-					break; //  ð 
+					break; // 만료 시각 도달
 
 				const uint64 wait_ns = target_ns - now_ns;
 				const auto   deadline = steady_clock::now() + nanoseconds(wait_ns);
 
-				//  or " ̸ due" ϸ 
+				// 종료 or "더 이른 due"가 도착하면 깨어남
 				const bool woke = m_timerCv.wait_until(lk, deadline, [this, target_ns] {
 					if (!m_running.load()) return true;
-					// pq  ʰ,   ִ target  ̸ due °?
+					// pq가 비지 않고, 현재 잡고 있는 target보다 더 이른 due가 생겼는가?
 					return !m_timedItems.empty() && (m_timedItems.top().due_ns < target_ns);
 					});
 
 				if (!m_running.load()) break;
 
-				//  ̸ Ÿ̸Ӱ ߴٸ,   ִ top ǵ 缱
+				// 더 이른 타이머가 도착했다면, 지금 들고 있던 top을 되돌리고 재선택
 				if (woke && !m_timedItems.empty() && m_timedItems.top().due_ns < target_ns) {
-					m_timedItems.push(std::move(top)); // ǵ
+					m_timedItems.push(std::move(top)); // 되돌리기
 					reschedule = true;
-					break; // ٱ    top ̴´
+					break; // 바깥 루프로 나가 새 top을 뽑는다
 				}
 
-				// ۸ ũ̸ while ư  ð ٽ 
+				// 스퍼리어스 웨이크업이면 while로 돌아가 남은 시간을 다시 계산
 			}
 
 			if (!m_running.load()) break;
 
 			if (reschedule) {
-				//  ̸ ׸ , ٱ  ٽ top 
+				// 더 이른 항목이 있으니, 바깥 루프에서 다시 top을 뽑자
 				continue;
 			}
 
-			//   ð   Ǯ (Ǵ Ŀ ť ε)
+			// 이제 실행할 시간 → 락 풀고 실행(또는 워커 큐로 오프로드)
 			lk.unlock();
-			Post(std::move(top.job)); // TODO: ۷ι Ŀ vs   
+			Post(std::move(top.job)); // TODO: 글로벌 워커 vs 샤드 중 선택
 			lk.lock();
 		}
 	}
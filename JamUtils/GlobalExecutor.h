@@ -1,10 +1,12 @@
 #pragma once
-#include "concurrentqueue/blockingconcurrentqueue.h"
 #include "concurrentqueue/concurrentqueue.h"
+#include <semaphore>
+#include <optional>
 #include "Job.h"
 #include "ShardExecutor.h"
 #include "ShardDirectory.h"
 #include "CoreTopology.h"
+#include "BlockingPool.h"
 
 
 namespace jam::utils::exec
@@ -17,12 +19,59 @@ namespace jam::utils::exec
 		sys::CoreLayout			layout;
 		sys::AutoLayoutConfig	layoutCfg;
 
-		// ڵ Ʃ(ɼ): ť /  Ÿ    
-		bool   autoTune = false;
+		// 자동 튜닝(옵션): 큐 길이/지연 기반으로 런타임 조정할 때 사용 가능
+		bool					autoTune = false;
+		AutoTuneConfig			autoTuneCfg;
 
 		ShardExecutorConfig		shardCfg;
 
 		uint64					capacity = 1 << 16;
+
+		uint32					ioSpinRounds = 64;				// empty polls before an IO worker parks
+
+		uint64					memoryReportIntervalNs = 0;		// 0 = off, else MemoryManager::DumpStats period
+		uint64					lockCycleScanIntervalNs = 100'000'000_ns;	// DeadLockProfiler::CheckCycles period; 0 = off
+
+		uint64					shardDrainTimeout_ns = 5'000'000'000_ns;	// RemoveShard: wait for the retiring queues
+
+		BlockingPoolConfig		blockingCfg;		// PostBlocking threads, apart from the IO workers
+	};
+
+	/*---- scatter / gather : pieces of one operation, each on a shard's thread ----*/
+
+	struct ScatterOptions
+	{
+		uint32		maxInFlight = 0;	// pieces queued or running at once; 0 = all
+		uint64		grain = 0;			// ParallelFor: indices per piece; 0 = one piece per shard
+	};
+
+	// completion of a scatter: poll, block, or give the call a done callback instead
+	class ScatterJoin
+	{
+		friend class GlobalExecutor;
+
+	public:
+		bool		IsDone() const { return m_done.load(std::memory_order_acquire); }
+		// never from a shard thread: its own piece could be queued behind the wait
+		void		Wait() const;
+
+	protected:
+		void		Finish();
+
+		Atomic<bool>		m_done{ false };
+	};
+
+	template<typename R>
+	class ScatterResult : public ScatterJoin
+	{
+		friend class GlobalExecutor;
+
+	public:
+		const R&	Get() const { Wait(); return m_value; }
+
+	private:
+		std::vector<std::optional<R>>	m_parts;	// by piece, reduced in piece order
+		R								m_value{};
 	};
 
 	class GlobalExecutor : public std::enable_shared_from_this<GlobalExecutor>
@@ -37,34 +86,99 @@ namespace jam::utils::exec
 		void				Stop();
 		void				Join();	
 
+		// short non-blocking offload on the IO workers, which also serve shard assists
 		void				Post(job::Job job);
 		void				PostAfter(job::Job job, uint64 delay_ns);
 
+		// anything that may block (file, DNS, backends): the elastic pool. same non-zero laneKey:
+		// one at a time, in order. BlockingPool::Offload routes a completion back to the caller
+		void				PostBlocking(job::Job job, uint64 laneKey = BlockingPool::NO_LANE) { m_blocking->Post(std::move(job), laneKey); }
+		BlockingPool&		GetBlockingPool() { return *m_blocking; }
+
 		void				RequestAssist(uint32 shardIndex);
 
+		uint32				GetIoWorkerCount() const { return static_cast<uint32>(m_workers.size()); }
+
 		// shard/endpoint
 		uint32				GetShardCount() const { return m_directory ? static_cast<uint32>(m_directory->Size()) : 0; }
 		Sptr<ShardExecutor> GetShard(uint32 index) const { return m_directory ? m_directory->ShardAt(index) : nullptr; }
-		std::vector<Sptr<ShardExecutor>>& GetShards() { return m_directory->Shards(); }
+		std::vector<Sptr<ShardExecutor>> GetShards() const { return m_directory->Shards(); }
+
+		// live resize, from a control thread (never a shard thread: both wait on the shards).
+		// Routing is a jump consistent hash, so only the keys of the new / retiring shard move.
+		//  - AddShard: init runs before the shard starts (register ECS modules), then every shard
+		//    hands the keys that now pick the new one over to it
+		//  - RemoveShard: retires the highest index. routing stops, its keyed mailboxes, entities and
+		//    group tables go to their new owners, its queues run out, then its thread is joined.
+		//    false with a single shard left
+		using ShardInitFn = std::function<void(ShardExecutor&)>;
+		Sptr<ShardExecutor>	AddShard(const ShardInitFn& init = {});
+		bool				RemoveShard();
 
 		Sptr<ShardDirectory> GetDirectory() const { return m_directory; }
 
+		// scatter / gather. piece i runs on shard (i % shard count) as a shard job; done, if given,
+		// runs once on the thread that finishes the last piece, before the join completes.
+		// The shard is resolved when the piece launches: one removed or stopped meanwhile is passed
+		// over for the next running one, and a stopping shard runs the pieces already queued on it.
+		// With no shard running a piece is skipped (logged), so the join always completes.
+		using ScatterPieceFn = std::function<void(ShardExecutor& shard, uint32 piece)>;
+		using ScatterDoneFn = std::function<void()>;
+		Sptr<ScatterJoin>	Scatter(uint32 pieces, ScatterPieceFn piece, ScatterDoneFn done = {}, const ScatterOptions& opt = {});
+
+		// fn once on every shard (broadcasts, saves, metric collection)
+		Sptr<ScatterJoin>	ForEachShard(std::function<void(ShardExecutor&)> fn, ScatterDoneFn done = {}, const ScatterOptions& opt = {});
+
+		// map on every shard, then reduce(acc, part) in shard order starting from init
+		template<typename R, typename MapFn, typename ReduceFn>
+		Sptr<ScatterResult<R>> MapReduce(MapFn map, ReduceFn reduce, R init = {}, std::function<void(const R&)> done = {}, const ScatterOptions& opt = {});
+
+		// fn(shard, i) for i in [begin, end), split in contiguous pieces spread over the shards
+		Sptr<ScatterJoin>	ParallelFor(uint64 begin, uint64 end, std::function<void(ShardExecutor&, uint64)> fn, ScatterDoneFn done = {}, const ScatterOptions& opt = {});
+
 	private:
-		void				WorkerLoop();
+		struct ScatterTask;
+		Sptr<ScatterJoin>	Scatter(uint32 pieces, ScatterPieceFn piece, ScatterDoneFn done, const ScatterOptions& opt, Sptr<ScatterJoin> join);
+		static void			LaunchPiece(const Sptr<ScatterTask>& task);
+
+		struct IoWorker
+		{
+			Mutex						lock;
+			xdeque<job::Job>			local;				// owner pushes/pops back, thieves take the front
+			Atomic<uint32>				localSize = 0;
+			std::counting_semaphore<>	wake{ 0 };
+			Atomic<bool>				parked = false;
+			std::thread					thread;
+		};
+
+		void				WorkerLoop(int32 index);
 		void				TimerLoop();
+		void				ScheduleMemoryReport();
+		void				ScheduleAutoTune();
+		void				ScheduleLockCycleScan();
+
+		void				RebalanceAll(const std::vector<Sptr<ShardExecutor>>& shards);
+
+		bool				RunAssists();
+		bool				PopLocal(IoWorker& self, OUT job::Job& job);
+		bool				Steal(int32 index, OUT job::Job& job);
+		bool				HasPendingWork() const;
+		void				Park(IoWorker& self);
+		void				WakeOne();
 
 	private:
 		GlobalExecutorConfig									m_config;
 		Atomic<bool>											m_running{ false };
 
-		// offload (MPMC)	
-		moodycamel::BlockingConcurrentQueue<job::Job>			m_offload;	// todo: Why BlockingQ ?
+		// offload: injection queue for posts from outside the pool (MPMC)
+		moodycamel::ConcurrentQueue<job::Job>					m_injection;
 
-		// assist (MPMC)
+		// assist (MPMC), served before any offload job
 		moodycamel::ConcurrentQueue<uint32>						m_assist;	// shard index
 
 		// worker
-		std::vector<std::thread>								m_workers;
+		std::vector<Uptr<IoWorker>>								m_workers;
+		Atomic<int32>											m_parkedCount{ 0 };
 
 		// timer
 		std::thread												m_timerThread;
@@ -87,5 +201,40 @@ namespace jam::utils::exec
 		std::priority_queue<TimedItem, std::vector<TimedItem>, TimedCmp>	m_timedItems;
 
 		Sptr<ShardDirectory>									m_directory;
+		Mutex													m_resizeLock;
+
+		Uptr<BlockingPool>										m_blocking;
+
+		// auto-tune: one step at a time, on an IO worker
+		Uptr<AutoTuner>											m_tuner;
+		uint64													m_lastTuneNs = 0;
 	};
+
+
+
+	template<typename R, typename MapFn, typename ReduceFn>
+	inline Sptr<ScatterResult<R>> GlobalExecutor::MapReduce(MapFn map, ReduceFn reduce, R init, std::function<void(const R&)> done, const ScatterOptions& opt)
+	{
+		auto result = memory::MakeShared<ScatterResult<R>>();
+		const uint32 pieces = GetShardCount();
+		result->m_parts.resize(pieces);
+
+		// each piece writes its own slot; the last one to finish reduces
+		Scatter(pieces,
+			[result, map](ShardExecutor& shard, uint32 piece) { result->m_parts[piece].emplace(map(shard)); },
+			[result, reduce, init, done]()
+			{
+				R acc = init;
+				for (std::optional<R>& part : result->m_parts)
+				{
+					if (part)
+						acc = reduce(std::move(acc), std::move(*part));
+				}
+				result->m_value = std::move(acc);
+				if (done)
+					done(result->m_value);
+			},
+			opt, result);
+		return result;
+	}
 }
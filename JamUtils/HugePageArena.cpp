@@ -0,0 +1,196 @@
+#include "pch.h"
+#include "HugePageArena.h"
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#endif
+
+namespace jam::utils::memory
+{
+	static int64 AlignUp(int64 value, int64 alignment)
+	{
+		return (value + alignment - 1) & ~(alignment - 1);
+	}
+
+#ifdef _WIN32
+	static bool EnableLockMemoryPrivilege()
+	{
+		HANDLE token = nullptr;
+		if (!::OpenProcessToken(::GetCurrentProcess(), TOKEN_ADJUST_PRIVILEGES | TOKEN_QUERY, &token))
+			return false;
+
+		TOKEN_PRIVILEGES privileges = {};
+		privileges.PrivilegeCount = 1;
+		privileges.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+
+		// AdjustTokenPrivileges succeeds even when nothing was granted: check GetLastError
+		const bool granted = ::LookupPrivilegeValue(nullptr, SE_LOCK_MEMORY_NAME, &privileges.Privileges[0].Luid)
+			&& ::AdjustTokenPrivileges(token, FALSE, &privileges, 0, nullptr, nullptr)
+			&& ::GetLastError() == ERROR_SUCCESS;
+
+		::CloseHandle(token);
+		return granted;
+	}
+#endif
+
+
+	HugePageArena::~HugePageArena()
+	{
+		for (const Region& region : m_regions)
+			UnmapRegion(region);
+	}
+
+	void HugePageArena::Init(bool useHugePages)
+	{
+		LockGuard guard(m_lock);
+
+		m_useHugePages = useHugePages;
+
+#ifdef _WIN32
+		if (m_useHugePages)
+			m_useHugePages = ::GetLargePageMinimum() != 0 && EnableLockMemoryPrivilege();
+#endif
+		m_enabled.store(true, std::memory_order_release);
+	}
+
+	void* HugePageArena::Alloc(int64 size, int64 alignment)
+	{
+		// not enabled (yet): callers fall back to the heap
+		if (!IsEnabled())
+			return nullptr;
+
+		LockGuard guard(m_lock);
+
+		while (m_current < m_regions.size())
+		{
+			Region& region = m_regions[m_current];
+
+			const int64 offset = AlignUp(region.used, alignment);
+			if (offset + size <= region.size)
+			{
+				region.used = offset + size;
+				return region.base + offset;
+			}
+
+			m_current++;
+		}
+
+		Region region;
+		if (!MapRegion(AlignUp(size, HUGE_PAGE_SIZE), OUT region))
+			return nullptr;
+
+		region.used = size;
+		m_regions.push_back(region);
+		m_current = m_regions.size() - 1;
+
+		return region.base;
+	}
+
+	void HugePageArena::Prefault(int64 bytes)
+	{
+		if (!IsEnabled())
+			return;
+
+		LockGuard guard(m_lock);
+
+		for (int64 mapped = 0; mapped < bytes; mapped += HUGE_PAGE_SIZE)
+		{
+			Region region;
+			if (!MapRegion(HUGE_PAGE_SIZE, OUT region))
+				return;
+
+			Touch(region);
+			m_regions.push_back(region);
+		}
+	}
+
+	bool HugePageArena::Contains(const void* ptr) const
+	{
+		LockGuard guard(m_lock);
+
+		const uint8* p = static_cast<const uint8*>(ptr);
+		for (const Region& region : m_regions)
+		{
+			if (p >= region.base && p < region.base + region.size)
+				return true;
+		}
+		return false;
+	}
+
+	bool HugePageArena::MapRegion(int64 size, OUT Region& region)
+	{
+		region = {};
+
+#ifdef _WIN32
+		if (m_useHugePages)
+		{
+			const int64 largePage = static_cast<int64>(::GetLargePageMinimum());
+			const int64 hugeSize = AlignUp(size, largePage);
+
+			if (void* base = ::VirtualAlloc(nullptr, hugeSize, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE))
+			{
+				region = { .base = static_cast<uint8*>(base), .size = hugeSize, .huge = true };
+			}
+		}
+
+		if (region.base == nullptr)
+		{
+			void* base = ::VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+			if (base == nullptr)
+				return false;
+
+			region = { .base = static_cast<uint8*>(base), .size = size };
+		}
+#else
+		if (m_useHugePages)
+		{
+			void* base = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+			if (base != MAP_FAILED)
+				region = { .base = static_cast<uint8*>(base), .size = size, .huge = true };
+		}
+
+		if (region.base == nullptr)
+		{
+			// over-map so the region can start on a 2 MB boundary (THP only backs aligned ranges)
+			const int64 span = size + HUGE_PAGE_SIZE;
+			void* raw = ::mmap(nullptr, span, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			if (raw == MAP_FAILED)
+				return false;
+
+			uint8* begin = static_cast<uint8*>(raw);
+			uint8* base = reinterpret_cast<uint8*>(AlignUp(reinterpret_cast<int64>(begin), HUGE_PAGE_SIZE));
+			if (base > begin)
+				::munmap(begin, base - begin);
+			if (base + size < begin + span)
+				::munmap(base + size, (begin + span) - (base + size));
+
+			if (m_useHugePages)
+				::madvise(base, size, MADV_HUGEPAGE);
+
+			region = { .base = base, .size = size };
+		}
+#endif
+
+		m_mappedBytes.fetch_add(region.size, std::memory_order_relaxed);
+		if (region.huge)
+			m_hugeBytes.fetch_add(region.size, std::memory_order_relaxed);
+
+		return true;
+	}
+
+	void HugePageArena::UnmapRegion(const Region& region)
+	{
+#ifdef _WIN32
+		::VirtualFree(region.base, 0, MEM_RELEASE);
+#else
+		::munmap(region.base, region.size);
+#endif
+	}
+
+	void HugePageArena::Touch(const Region& region)
+	{
+		// one write per 4 KB page is enough to fault the whole region in
+		for (int64 offset = 0; offset < region.size; offset += 4096)
+			reinterpret_cast<volatile uint8*>(region.base)[offset] = 0;
+	}
+}
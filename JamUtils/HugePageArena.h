@@ -0,0 +1,58 @@
+#pragma once
+
+namespace jam::utils::memory
+{
+	inline constexpr int64 HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+	/*--------------------
+		HugePageArena
+	---------------------*/
+
+	// Bump allocator over 2 MB regions for memory that is pooled and never handed back
+	// (MemoryPool blocks, SendBufferChunks). Fewer, larger pages -> fewer TLB misses.
+	// - Windows : VirtualAlloc(MEM_LARGE_PAGES), needs SeLockMemoryPrivilege
+	// - Linux   : mmap(MAP_HUGETLB), else 2 MB aligned mmap + madvise(MADV_HUGEPAGE)
+	// Falls back to normal pages silently; GetHugeBytes() tells what was actually obtained.
+	// Regions are unmapped only when the arena is destroyed.
+	class HugePageArena
+	{
+		struct Region
+		{
+			uint8*		base = nullptr;
+			int64		size = 0;
+			int64		used = 0;
+			bool		huge = false;
+		};
+
+	public:
+		HugePageArena() = default;
+		~HugePageArena();
+
+		HugePageArena(const HugePageArena&) = delete;
+		HugePageArena& operator=(const HugePageArena&) = delete;
+
+		void			Init(bool useHugePages);
+		void*			Alloc(int64 size, int64 alignment);		// nullptr before Init or if the OS refuses
+		void			Prefault(int64 bytes);					// map + touch ahead of first use
+		bool			Contains(const void* ptr) const;
+
+		bool			IsEnabled() const { return m_enabled.load(std::memory_order_acquire); }
+		int64			GetMappedBytes() const { return m_mappedBytes.load(std::memory_order_relaxed); }
+		int64			GetHugeBytes() const { return m_hugeBytes.load(std::memory_order_relaxed); }
+
+	private:
+		bool			MapRegion(int64 size, OUT Region& region);
+		static void		UnmapRegion(const Region& region);
+		static void		Touch(const Region& region);
+
+	private:
+		mutable Mutex				m_lock;				// slow path only (pool growth)
+		std::vector<Region>			m_regions;			// not xvector: this sits under MemoryManager
+		size_t						m_current = 0;
+
+		Atomic<bool>				m_enabled = false;		// may turn on after pools already hold the arena
+		bool						m_useHugePages = false;
+		Atomic<int64>				m_mappedBytes = 0;
+		Atomic<int64>				m_hugeBytes = 0;
+	};
+}
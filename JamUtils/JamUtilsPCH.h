@@ -32,6 +32,7 @@
 #include "MemoryPool.h"
 #include "MemoryManager.h"
 #include "ObjectPool.h"
+#include "RefCounted.h"
 
 #include "Logger.h"
 
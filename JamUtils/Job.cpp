@@ -1,4 +1,61 @@
 #include "pch.h"
 #include "Job.h"
+#include "Clock.h"
 
+namespace jam::utils::job
+{
+	Job& Job::operator=(const Job& other)
+	{
+		if (this == &other)
+			return *this;
 
+		m_callback = other.m_callback;
+		m_coalesceKey = other.m_coalesceKey;
+		ClearTiming();
+		CopyTiming(other);
+		return *this;
+	}
+
+	Job& Job::operator=(Job&& other) noexcept
+	{
+		if (this == &other)
+			return *this;
+
+		m_callback = std::move(other.m_callback);
+		m_coalesceKey = other.m_coalesceKey;
+		ClearTiming();
+		m_timing = std::exchange(other.m_timing, nullptr);
+		return *this;
+	}
+
+	Job& Job::ExpireAfter(uint64 ttl_ns)
+	{
+		Timing().deadline_ns = Clock::Instance().NowNs() + ttl_ns;
+		return *this;
+	}
+
+	Job& Job::EscalateAfter(uint64 age_ns)
+	{
+		Timing().escalateAt_ns = Clock::Instance().NowNs() + age_ns;
+		return *this;
+	}
+
+	Job::TimingBlock& Job::Timing()
+	{
+		if (m_timing == nullptr)
+			m_timing = memory::xnew<TimingBlock, memory::eMemTag::JOB>();
+		return *m_timing;
+	}
+
+	void Job::CopyTiming(const Job& other)
+	{
+		if (other.m_timing != nullptr)
+			m_timing = memory::xnew<TimingBlock, memory::eMemTag::JOB>(*other.m_timing);
+	}
+
+	void Job::ClearTiming()
+	{
+		if (m_timing != nullptr)
+			memory::xdelete(std::exchange(m_timing, nullptr));
+	}
+}
@@ -30,12 +30,18 @@ namespace jam::utils::job
         using CallbackType = std::function<void()>;
 
         Job() = default;
+        ~Job() { ClearTiming(); }
 
-        //  callable ޴ ⺻ 
-        template<class F>
+        Job(const Job& other) : m_callback(other.m_callback), m_coalesceKey(other.m_coalesceKey) { CopyTiming(other); }
+        Job(Job&& other) noexcept : m_callback(std::move(other.m_callback)), m_timing(std::exchange(other.m_timing, nullptr)), m_coalesceKey(other.m_coalesceKey) {}
+        Job& operator=(const Job& other);
+        Job& operator=(Job&& other) noexcept;
+
+        // 어떤 callable도 받는 기본 생성자 (a Job itself is copied, not wrapped)
+        template<class F, std::enable_if_t<!std::is_same_v<std::decay_t<F>, Job>, int> = 0>
         Job(F&& f) : m_callback(std::forward<F>(f)) {}
 
-        // Լ ε (owner :  )
+        // 멤버함수 바인딩 (owner를 강소유: 실행 보장)
         template<class T, class MemFn, class... Args,
             std::enable_if_t<std::is_member_function_pointer_v<MemFn>, int> = 0>
         Job(std::shared_ptr<T> owner, MemFn mf, Args&&... args) {
@@ -47,7 +53,7 @@ namespace jam::utils::job
                 };
         }
 
-        // Լ ε (owner :  ̸  )
+        // 멤버함수 바인딩 (owner를 약소유: 종료 중이면 실행 생략)
         template<class T, class MemFn, class... Args>
         static Job Weak(std::weak_ptr<T> owner, MemFn mf, Args&&... args) {
             auto tup = std::make_tuple(std::forward<Args>(args)...);
@@ -57,20 +63,55 @@ namespace jam::utils::job
                         (s.get()->*mf)(std::forward<decltype(a)>(a)...);
                         }, tup);
                 }
-                // else: 
+                // else: 드랍
                 });
         }
 
-        //  ó å:   ȣ
+        // Optional latency metadata, absolute Clock::NowNs times (0 = unset), kept in a side block so
+        // plain jobs stay a callback and a pointer. Relative forms are converted when tagged, i.e. at
+        // post time, so a job forwarded to another mailbox keeps its age.
+        //  - expiry: best-effort work (position updates, pings, flush requests) that is worthless
+        //    when late; the mailbox drops it unexecuted past its deadline.
+        //  - escalation: urgent work (disconnects, handshakes) posted to a NORMAL mailbox; once it has
+        //    waited this long, the mailbox is serviced from the CTRL lane.
+        Job& ExpireAt(uint64 deadline_ns) { Timing().deadline_ns = deadline_ns; return *this; }
+        Job& ExpireAfter(uint64 ttl_ns);
+        Job& EscalateAfter(uint64 age_ns);
+
+        bool IsTimed() const { return m_timing != nullptr; }
+
+        bool   IsExpired(uint64 now_ns) const { return m_timing && m_timing->deadline_ns != 0 && now_ns > m_timing->deadline_ns; }
+        uint64 GetDeadlineNs() const { return m_timing ? m_timing->deadline_ns : 0; }
+        uint64 GetEscalateAtNs() const { return m_timing ? m_timing->escalateAt_ns : 0; }
+
+        // Mailbox::PostCoalesced: the key whose pending flag clears when the job leaves the mailbox
+        static constexpr uint8 NO_COALESCE = 0xFF;
+        void   SetCoalesceKey(uint8 key) { m_coalesceKey = key; }
+        uint8  GetCoalesceKey() const { return m_coalesceKey; }
+
+        // 예외 처리 정책: 샤드 루프 보호용
         void Execute() noexcept {
             try { if (m_callback) m_callback(); }
             catch (...) {
-                // TODO: α/Ʈ.  忡 Ű  
+                // TODO: 로그/메트릭. 릴리즈 빌드에서는 삼키는 게 안전
             }
         }
 
+    private:
+        struct TimingBlock
+        {
+            uint64   deadline_ns = 0;
+            uint64   escalateAt_ns = 0;
+        };
+
+        TimingBlock& Timing();
+        void         CopyTiming(const Job& other);
+        void         ClearTiming();
+
     private:
         CallbackType m_callback;
+        TimingBlock* m_timing = nullptr;        // pool block, timed jobs only
+        uint8        m_coalesceKey = NO_COALESCE;
     };
 
 }
@@ -0,0 +1,49 @@
+#pragma once
+
+namespace jam::utils::thrd
+{
+	/*----------------
+		LocalQueue
+	-----------------*/
+
+	// Single-thread FIFO: no atomics, no locks. A vector with a read cursor; it rewinds whenever
+	// it runs empty, so a queue that keeps draining reuses one allocation (std::deque on MSVC
+	// allocates a block per element for anything over 16 bytes).
+	template<typename T>
+	class LocalQueue
+	{
+	public:
+		template<typename... Args>
+		void		Push(Args&&... args) { m_items.emplace_back(std::forward<Args>(args)...); }
+
+		bool		TryPop(OUT T& out)
+		{
+			if (m_head == m_items.size())
+				return false;
+
+			out = std::move(m_items[m_head++]);
+			if (m_head == m_items.size())
+			{
+				m_items.clear();
+				m_head = 0;
+			}
+			return true;
+		}
+
+		bool		IsEmpty() const { return m_head == m_items.size(); }
+		uint64		Size() const { return m_items.size() - m_head; }
+
+		// drops every element matching pred, keeping the order of the rest
+		template<typename Pred>
+		void		EraseIf(Pred&& pred)
+		{
+			m_items.erase(m_items.begin(), m_items.begin() + m_head);
+			m_head = 0;
+			std::erase_if(m_items, std::forward<Pred>(pred));
+		}
+
+	private:
+		xvector<T>		m_items;
+		size_t			m_head = 0;
+	};
+}
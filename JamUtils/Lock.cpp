@@ -1,16 +1,101 @@
 #include "pch.h"
 #include "Lock.h"
+#include "LockStats.h"
 #include "DeadLockProfiler.h"
+#include "Clock.h"
+
+#ifdef _WIN32
+#pragma comment(lib, "Synchronization.lib")		// WaitOnAddress
+#else
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 namespace jam::utils::thrd
 {
-	void Lock::WriteLock(const char* name)
+	// read locks held by this thread (any Lock): such a reader must not yield to a waiting
+	// writer, the writer may be waiting for exactly this thread
+	static thread_local int32 tl_ReadLockDepth = 0;
+
+	static void CpuRelax()
+	{
+#ifdef _WIN32
+		YieldProcessor();
+#else
+		__builtin_ia32_pause();
+#endif
+	}
+
+	static void WaitOnFlag(Atomic<uint32>& flag, uint32 expected, uint32 timeoutMs)
+	{
+#ifdef _WIN32
+		::WaitOnAddress(&flag, &expected, sizeof(uint32), timeoutMs);
+#else
+		timespec timeout = { .tv_sec = timeoutMs / 1000, .tv_nsec = (timeoutMs % 1000) * 1'000'000 };
+		::syscall(SYS_futex, reinterpret_cast<uint32*>(&flag), FUTEX_WAIT_PRIVATE, expected, &timeout, nullptr, 0);
+#endif
+	}
+
+	static void CheckTimeout(uint64 beginNs, uint64 timeoutMs)
 	{
 #if _DEBUG
-		DeadLockProfiler::Instance().PushLock(name);
+		if (Clock::Instance().NowNs() - beginNs >= timeoutMs * 1'000'000)
+			CRASH("LOCK_TIMEOUT");
 #endif
+	}
+
+
+	void Lock::WriteLock(const char* name)
+	{
+		DeadLockProfiler& profiler = DeadLockProfiler::Instance();
+		if (profiler.IsEnabled() == false)
+		{
+			AcquireWrite(name);
+			return;
+		}
+
+		// order edge is recorded before blocking, so a real deadlock is still reported
+		profiler.PushLock(Stats(name));
+		AcquireWrite(name);
+		profiler.OnAcquired();
+	}
 
-		//  尡 ϰ ִٸ  .
+	void Lock::WriteUnlock(const char* name)
+	{
+		DeadLockProfiler& profiler = DeadLockProfiler::Instance();
+		if (profiler.IsEnabled())
+			profiler.PopLock(Stats(name));
+
+		ReleaseWrite();
+	}
+
+	void Lock::ReadLock(const char* name)
+	{
+		DeadLockProfiler& profiler = DeadLockProfiler::Instance();
+		if (profiler.IsEnabled() == false)
+		{
+			AcquireRead(name);
+			return;
+		}
+
+		profiler.PushLock(Stats(name));
+		AcquireRead(name);
+		profiler.OnAcquired();
+	}
+
+	void Lock::ReadUnlock(const char* name)
+	{
+		DeadLockProfiler& profiler = DeadLockProfiler::Instance();
+		if (profiler.IsEnabled())
+			profiler.PopLock(Stats(name));
+
+		ReleaseRead();
+	}
+
+	void Lock::AcquireWrite(const char* name)
+	{
+		// 동일한 쓰레드가 소유하고 있다면 무조건 성공.
 		const uint32 lockThreadId = (m_lockFlag.load() & WRITE_THREAD_MASK) >> 16;
 		if (tl_ThreadId == lockThreadId)
 		{
@@ -18,82 +103,156 @@ namespace jam::utils::thrd
 			return;
 		}
 
-		// ƹ   ϰ   , ؼ  ´.
-		const int64 beginTick = ::GetTickCount64();
+		// 아무도 소유 및 공유하고 있지 않을 때, 경합해서 소유권을 얻는다.
 		const uint32 desired = ((tl_ThreadId << 16) & WRITE_THREAD_MASK);
+		uint32 expected = EMPTY_FLAG;
+		if (m_lockFlag.compare_exchange_strong(OUT expected, desired))
+		{
+			m_writeCount++;
+			return;
+		}
+
+		const uint64 beginNs = Clock::Instance().NowNs();
+		bool didPark = false;
+		uint32 spinCount = 0;
 		while (true)
 		{
-			for (uint32 spinCount = 0; spinCount < MAX_SPIN_COUNT; spinCount++)
+			expected = m_lockFlag.load();
+			if ((expected & (WRITE_THREAD_MASK | READ_COUNT_MASK)) == 0)
 			{
-				uint32 expected = EMPTY_FLAG;
-				if (m_lockFlag.compare_exchange_strong(OUT expected, desired))
-				{
-					m_writeCount++;
-					return;
-				}
+				// PARKED stays set so the remaining sleepers are woken by our unlock
+				if (m_lockFlag.compare_exchange_weak(OUT expected, desired | (expected & PARKED_FLAG)))
+					break;
+				continue;
 			}
 
-			if (::GetTickCount64() - beginTick >= ACQUIRE_TIMEOUT_TICK)
-				CRASH("LOCK_TIMEOUT");
+			// writer preference: new readers back off from here on
+			if ((expected & WRITER_WAITING_FLAG) == 0)
+				expected = m_lockFlag.fetch_or(WRITER_WAITING_FLAG) | WRITER_WAITING_FLAG;
+
+			if (spinCount < MAX_SPIN_COUNT)
+			{
+				spinCount++;
+				CpuRelax();
+				continue;
+			}
 
-			std::this_thread::yield();
+			didPark |= Park(expected);
+			CheckTimeout(beginNs, ACQUIRE_TIMEOUT_MS);
 		}
+
+		m_writeCount++;
+		Stats(name)->RecordWait(Clock::Instance().NowNs() - beginNs, didPark);
 	}
 
-	void Lock::WriteUnlock(const char* name)
+	void Lock::ReleaseWrite()
 	{
-#if _DEBUG
-		DeadLockProfiler::Instance().PopLock(name);
-#endif
-
-		// ReadLock  Ǯ  WriteUnlock Ұ.
+		// ReadLock 다 풀기 전에는 WriteUnlock 불가능.
 		if ((m_lockFlag.load() & READ_COUNT_MASK) != 0)
 			CRASH("INVALID_UNLOCK_ORDER");
 
 		const int32 lockCount = --m_writeCount;
 		if (lockCount == 0)
-			m_lockFlag.store(EMPTY_FLAG);
+		{
+			if (m_lockFlag.exchange(EMPTY_FLAG) & PARKED_FLAG)
+				WakeAll();
+		}
 	}
 
-	void Lock::ReadLock(const char* name)
+	void Lock::AcquireRead(const char* name)
 	{
-#if _DEBUG
-		DeadLockProfiler::Instance().PushLock(name);
-#endif
-
-		//  尡 ϰ ִٸ  .
+		// 동일한 쓰레드가 소유하고 있다면 무조건 성공.
 		const uint32 lockThreadId = (m_lockFlag.load() & WRITE_THREAD_MASK) >> 16;
 		if (tl_ThreadId == lockThreadId)
 		{
 			m_lockFlag.fetch_add(1);
+			tl_ReadLockDepth++;
 			return;
 		}
 
-		// ƹ ϰ    ؼ  īƮ ø.
-		const int64 beginTick = ::GetTickCount64();
+		// 아무도 소유하고 있지 않을 때 경합해서 공유 카운트를 올린다.
+		const uint32 blockMask = (tl_ReadLockDepth > 0) ? WRITE_THREAD_MASK : (WRITE_THREAD_MASK | WRITER_WAITING_FLAG);
+
+		uint32 expected = m_lockFlag.load();
+		if ((expected & blockMask) == 0 && m_lockFlag.compare_exchange_strong(OUT expected, expected + 1))
+		{
+			tl_ReadLockDepth++;
+			return;
+		}
+
+		const uint64 beginNs = Clock::Instance().NowNs();
+		bool didPark = false;
+		uint32 spinCount = 0;
 		while (true)
 		{
-			for (uint32 spinCount = 0; spinCount < MAX_SPIN_COUNT; spinCount++)
+			expected = m_lockFlag.load();
+			if ((expected & blockMask) == 0)
 			{
-				uint32 expected = (m_lockFlag.load() & READ_COUNT_MASK);
-				if (m_lockFlag.compare_exchange_strong(OUT expected, expected + 1))
-					return;
+				if (m_lockFlag.compare_exchange_weak(OUT expected, expected + 1))
+					break;
+				continue;
 			}
 
-			if (::GetTickCount64() - beginTick >= ACQUIRE_TIMEOUT_TICK)
-				CRASH("LOCK_TIMEOUT");
+			if (spinCount < MAX_SPIN_COUNT)
+			{
+				spinCount++;
+				CpuRelax();
+				continue;
+			}
 
-			std::this_thread::yield();
+			didPark |= Park(expected);
+			CheckTimeout(beginNs, ACQUIRE_TIMEOUT_MS);
 		}
+
+		tl_ReadLockDepth++;
+		Stats(name)->RecordWait(Clock::Instance().NowNs() - beginNs, didPark);
 	}
 
-	void Lock::ReadUnlock(const char* name)
+	void Lock::ReleaseRead()
 	{
-#if _DEBUG
-		DeadLockProfiler::Instance().PopLock(name);
+		const uint32 prev = m_lockFlag.fetch_sub(1);
+		if ((prev & READ_COUNT_MASK) == 0)
+			CRASH("MULTIPLE_UNLOCK");
+
+		tl_ReadLockDepth--;
+
+		// last reader out wakes whoever parked (typically a writer)
+		if ((prev & READ_COUNT_MASK) == 1 && (prev & PARKED_FLAG))
+		{
+			m_lockFlag.fetch_and(~PARKED_FLAG);
+			WakeAll();
+		}
+	}
+
+	bool Lock::Park(uint32 observed)
+	{
+		// flag the sleeper on the exact value we saw busy; if the word moved, just retry
+		const uint32 parkedValue = observed | PARKED_FLAG;
+		if ((observed & PARKED_FLAG) == 0 && !m_lockFlag.compare_exchange_strong(OUT observed, parkedValue))
+			return false;
+
+		// returns at once if the word is no longer parkedValue; the timeout only bounds the _DEBUG watchdog
+		WaitOnFlag(m_lockFlag, parkedValue, PARK_TIMEOUT_MS);
+		return true;
+	}
+
+	void Lock::WakeAll()
+	{
+#ifdef _WIN32
+		::WakeByAddressAll(&m_lockFlag);
+#else
+		::syscall(SYS_futex, reinterpret_cast<uint32*>(&m_lockFlag), FUTEX_WAKE_PRIVATE, INT32_MAX, nullptr, nullptr, 0);
 #endif
+	}
 
-		if ((m_lockFlag.fetch_sub(1) & READ_COUNT_MASK) == 0)
-			CRASH("MULTIPLE_UNLOCK");
+	LockStats* Lock::Stats(const char* name)
+	{
+		LockStats* stats = m_stats.load(std::memory_order_acquire);
+		if (stats == nullptr)
+		{
+			stats = LockStatsRegistry::Instance().Find(name);
+			m_stats.store(stats, std::memory_order_release);
+		}
+		return stats;
 	}
 }
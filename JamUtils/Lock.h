@@ -2,24 +2,35 @@
 
 namespace jam::utils::thrd
 {
+	struct LockStats;
+
     /*----------------
-	    RW SpinLock
+	    RW Lock
 	-----------------*/
 
 	/*--------------------------------------------
-	[WWWWWWWW][WWWWWWWW][RRRRRRRR][RRRRRRRR]
+	[WWWWWWWW][WWWWWWWW][WPRRRRRR][RRRRRRRR]
 	W : WriteFlag (Exclusive Lock Owner ThreadId)
+	W : WriterWaiting (writer preference: new readers back off)
+	P : Parked (someone sleeps on the flag, unlock must wake)
 	R : ReadFlag (Shared Lock Count)
 	---------------------------------------------*/
 
+	// Adaptive: short pause-spin, then parks on the flag word itself
+	// (WaitOnAddress on Windows, futex on Linux) instead of spinning/yielding.
+	// Contention is recorded per lock name in LockStatsRegistry; lock order and
+	// sampled hold times go to DeadLockProfiler when it is enabled.
     class Lock
     {
         enum : uint32
         {
-            ACQUIRE_TIMEOUT_TICK = 10000,
-            MAX_SPIN_COUNT = 5000,
+            ACQUIRE_TIMEOUT_MS = 10000,     // _DEBUG only: deadlock watchdog
+            PARK_TIMEOUT_MS = 100,
+            MAX_SPIN_COUNT = 64,
             WRITE_THREAD_MASK = 0xFFFF'0000,
-            READ_COUNT_MASK = 0x0000'FFFF,
+            WRITER_WAITING_FLAG = 0x0000'8000,
+            PARKED_FLAG = 0x0000'4000,
+            READ_COUNT_MASK = 0x0000'3FFF,
             EMPTY_FLAG = 0x0000'0000
         };
 
@@ -29,9 +40,20 @@ namespace jam::utils::thrd
         void            ReadLock(const char* name);
         void            ReadUnlock(const char* name);
 
+    private:
+        void            AcquireWrite(const char* name);
+        void            ReleaseWrite();
+        void            AcquireRead(const char* name);
+        void            ReleaseRead();
+
+        bool            Park(uint32 observed);
+        void            WakeAll();
+        LockStats*      Stats(const char* name);
+
     private:
         Atomic<uint32>  m_lockFlag = EMPTY_FLAG;
         uint16          m_writeCount = 0;
+        Atomic<LockStats*>  m_stats = nullptr;     // resolved on first contention
     };
 
     /*----------------
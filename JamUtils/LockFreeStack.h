@@ -0,0 +1,89 @@
+#pragma once
+
+namespace jam::utils::memory
+{
+	/*--------------------
+		LockFreeStack
+	---------------------*/
+
+	/*--------------------------------------------
+	[TTTTTTTT][TTTTTTTT][PPPPPPPP]...[PPPPPPPP]
+	T : ABA Tag (16 bit)
+	P : Node Pointer (48 bit, user-space address)
+	---------------------------------------------*/
+
+	// Intrusive Treiber stack replacing SLIST_HEADER.
+	// Only a 64-bit CAS is needed, so it works the same on Windows and Linux.
+	// Popped nodes must stay readable (pools never return memory while alive).
+	template<typename T, T* T::* Link>
+	class LockFreeStack
+	{
+		static_assert(sizeof(void*) == 8, "LockFreeStack requires 64-bit pointers");
+
+		enum : uint64
+		{
+			PTR_MASK = 0x0000'FFFF'FFFF'FFFF,
+			TAG_SHIFT = 48,
+			TAG_ONE = 1ull << TAG_SHIFT
+		};
+
+	public:
+		void		Push(T* node) { PushChain(node, node); }
+
+		// first..last already linked through Link: one CAS publishes the whole chain
+		void PushChain(T* first, T* last)
+		{
+			uint64 head = m_head.load(std::memory_order_relaxed);
+			while (true)
+			{
+				last->*Link = Unpack(head);
+				if (m_head.compare_exchange_weak(head, Pack(first, head), std::memory_order_release, std::memory_order_relaxed))
+					return;
+			}
+		}
+
+		T* Pop()
+		{
+			uint64 head = m_head.load(std::memory_order_acquire);
+			while (true)
+			{
+				T* top = Unpack(head);
+				if (top == nullptr)
+					return nullptr;
+
+				if (m_head.compare_exchange_weak(head, Pack(top->*Link, head), std::memory_order_acquire, std::memory_order_acquire))
+				{
+					top->*Link = nullptr;
+					return top;
+				}
+			}
+		}
+
+		T* PopAll()
+		{
+			uint64 head = m_head.load(std::memory_order_acquire);
+			while (!m_head.compare_exchange_weak(head, Pack(nullptr, head), std::memory_order_acquire, std::memory_order_acquire))
+			{
+			}
+			return Unpack(head);
+		}
+
+		bool		IsEmpty() const { return Unpack(m_head.load(std::memory_order_relaxed)) == nullptr; }
+
+	private:
+		static T* Unpack(uint64 head)
+		{
+			return reinterpret_cast<T*>(head & PTR_MASK);
+		}
+
+		static uint64 Pack(T* node, uint64 prevHead)
+		{
+			const uint64 ptr = reinterpret_cast<uint64>(node);
+			ASSERT_CRASH((ptr & ~PTR_MASK) == 0);
+			return ((prevHead & ~PTR_MASK) + TAG_ONE) | ptr;
+		}
+
+	private:
+		Atomic<uint64>		m_head{ 0 };
+	};
+}
@@ -0,0 +1,122 @@
+#include "pch.h"
+#include "LockStats.h"
+
+namespace jam::utils::thrd
+{
+	static void UpdateMax(Atomic<uint64>& target, uint64 value)
+	{
+		uint64 prev = target.load(std::memory_order_relaxed);
+		while (value > prev && !target.compare_exchange_weak(prev, value, std::memory_order_relaxed))
+		{
+		}
+	}
+
+	void LockStats::RecordWait(uint64 waitNs, bool didPark)
+	{
+		contended.fetch_add(1, std::memory_order_relaxed);
+		if (didPark)
+			parked.fetch_add(1, std::memory_order_relaxed);
+
+		totalWaitNs.fetch_add(waitNs, std::memory_order_relaxed);
+
+		UpdateMax(maxWaitNs, waitNs);
+
+		int32 bucket = 0;
+		for (uint64 v = waitNs; v > 1 && bucket < LOCK_WAIT_BUCKETS - 1; v >>= 1)
+			bucket++;
+
+		waitHistogram[bucket].fetch_add(1, std::memory_order_relaxed);
+	}
+
+	void LockStats::RecordSampledWait(uint64 waitNs)
+	{
+		sampledAcquires.fetch_add(1, std::memory_order_relaxed);
+		sampledWaitNs.fetch_add(waitNs, std::memory_order_relaxed);
+	}
+
+	void LockStats::RecordSampledHold(uint64 holdNs)
+	{
+		sampledHolds.fetch_add(1, std::memory_order_relaxed);
+		sampledHoldNs.fetch_add(holdNs, std::memory_order_relaxed);
+		UpdateMax(maxHoldNs, holdNs);
+	}
+
+	LockStats* LockStatsRegistry::Find(const char* name)
+	{
+		LockGuard guard(m_lock);
+
+		Uptr<LockStats>& stats = m_stats[name];
+		if (stats == nullptr)
+		{
+			stats = std::make_unique<LockStats>();
+			stats->name = name;
+			stats->id = static_cast<int32>(m_byId.size());
+			m_byId.push_back(stats.get());
+		}
+		return stats.get();
+	}
+
+	LockStats* LockStatsRegistry::FindById(int32 id) const
+	{
+		LockGuard guard(m_lock);
+
+		if (id < 0 || id >= static_cast<int32>(m_byId.size()))
+			return nullptr;
+		return m_byId[id];
+	}
+
+	std::vector<LockStatsSnapshot> LockStatsRegistry::Snapshot() const
+	{
+		std::vector<LockStatsSnapshot> result;
+
+		{
+			LockGuard guard(m_lock);
+			result.reserve(m_stats.size());
+
+			for (const auto& [name, stats] : m_stats)
+			{
+				LockStatsSnapshot& snap = result.emplace_back();
+				snap.name = name;
+				snap.contended = stats->contended.load(std::memory_order_relaxed);
+				snap.parked = stats->parked.load(std::memory_order_relaxed);
+				snap.totalWaitNs = stats->totalWaitNs.load(std::memory_order_relaxed);
+				snap.maxWaitNs = stats->maxWaitNs.load(std::memory_order_relaxed);
+				for (int32 i = 0; i < LOCK_WAIT_BUCKETS; i++)
+					snap.waitHistogram[i] = stats->waitHistogram[i].load(std::memory_order_relaxed);
+				snap.sampledAcquires = stats->sampledAcquires.load(std::memory_order_relaxed);
+				snap.sampledWaitNs = stats->sampledWaitNs.load(std::memory_order_relaxed);
+				snap.sampledHolds = stats->sampledHolds.load(std::memory_order_relaxed);
+				snap.sampledHoldNs = stats->sampledHoldNs.load(std::memory_order_relaxed);
+				snap.maxHoldNs = stats->maxHoldNs.load(std::memory_order_relaxed);
+			}
+		}
+
+		std::sort(result.begin(), result.end(), [](const LockStatsSnapshot& a, const LockStatsSnapshot& b)
+			{
+				return a.totalWaitNs > b.totalWaitNs;
+			});
+
+		return result;
+	}
+
+	void LockStatsRegistry::Dump(int32 topN) const
+	{
+		const std::vector<LockStatsSnapshot> snapshot = Snapshot();
+
+		const int32 count = (std::min)(topN, static_cast<int32>(snapshot.size()));
+		for (int32 i = 0; i < count; i++)
+		{
+			const LockStatsSnapshot& snap = snapshot[i];
+			const uint64 avgNs = snap.contended ? snap.totalWaitNs / snap.contended : 0;
+
+			LOG_INFO("[Lock] {} contended {} parked {} wait total {} us avg {} ns max {} ns",
+				snap.name, snap.contended, snap.parked, snap.totalWaitNs / 1000, avgNs, snap.maxWaitNs);
+
+			if (snap.sampledHolds > 0)
+			{
+				LOG_INFO("[Lock] {} sampled: wait avg {} ns, hold avg {} ns max {} ns",
+					snap.name, snap.sampledWaitNs / (std::max)(snap.sampledAcquires, uint64(1)), snap.sampledHoldNs / snap.sampledHolds, snap.maxHoldNs);
+			}
+		}
+	}
+}
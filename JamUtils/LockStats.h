@@ -0,0 +1,71 @@
+#pragma once
+
+namespace jam::utils::thrd
+{
+	inline constexpr int32 LOCK_WAIT_BUCKETS = 32;		// bucket i : wait in [2^i, 2^(i+1)) ns
+
+	/*---------------
+		LockStats
+	----------------*/
+
+	// Contention record of one lock name (typeid(this).name() of the owner).
+	// Contention fields are only touched when an acquire misses its first try.
+	struct LockStats
+	{
+		const char*		name = nullptr;
+		int32			id = -1;					// dense index, DeadLockProfiler graph node
+
+		Atomic<uint64>	contended = 0;				// acquires that had to retry
+		Atomic<uint64>	parked = 0;					// ... and ended up sleeping
+		Atomic<uint64>	totalWaitNs = 0;
+		Atomic<uint64>	maxWaitNs = 0;
+		Atomic<uint64>	waitHistogram[LOCK_WAIT_BUCKETS] = {};
+
+		// 1/N sampled by DeadLockProfiler, contended or not
+		Atomic<uint64>	sampledAcquires = 0;
+		Atomic<uint64>	sampledWaitNs = 0;
+		Atomic<uint64>	sampledHolds = 0;
+		Atomic<uint64>	sampledHoldNs = 0;
+		Atomic<uint64>	maxHoldNs = 0;
+
+		void			RecordWait(uint64 waitNs, bool didPark);
+		void			RecordSampledWait(uint64 waitNs);
+		void			RecordSampledHold(uint64 holdNs);
+	};
+
+	struct LockStatsSnapshot
+	{
+		const char*		name = nullptr;
+		uint64			contended = 0;
+		uint64			parked = 0;
+		uint64			totalWaitNs = 0;
+		uint64			maxWaitNs = 0;
+		uint64			waitHistogram[LOCK_WAIT_BUCKETS] = {};
+		uint64			sampledAcquires = 0;
+		uint64			sampledWaitNs = 0;
+		uint64			sampledHolds = 0;
+		uint64			sampledHoldNs = 0;
+		uint64			maxHoldNs = 0;
+	};
+
+	/*-----------------------
+		LockStatsRegistry
+	------------------------*/
+
+	class LockStatsRegistry
+	{
+		DECLARE_SINGLETON(LockStatsRegistry)
+
+	public:
+		LockStats*							Find(const char* name);		// creates on first use, never freed
+		LockStats*							FindById(int32 id) const;
+
+		std::vector<LockStatsSnapshot>		Snapshot() const;			// sorted by totalWaitNs, descending
+		void								Dump(int32 topN = 16) const;
+
+	private:
+		mutable Mutex						m_lock;
+		std::unordered_map<const char*, Uptr<LockStats>>	m_stats;
+		std::vector<LockStats*>				m_byId;
+	};
+}
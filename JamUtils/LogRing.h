@@ -0,0 +1,208 @@
+#pragma once
+
+namespace jam::utils
+{
+	inline constexpr uint32 LOG_RING_SIZE = 256 * 1024;		// per producer thread, power of two
+	inline constexpr uint32 MAX_LOG_STRING = 1024;			// longer string arguments are cut
+
+	/*--------------
+		LogSite
+	---------------*/
+
+	// One per LOG_* call site (function-local static). Its address is the id of the record.
+	struct LogSite
+	{
+		spdlog::level::level_enum	level;
+		const char*					file;
+		int32						line;
+		uint64						intervalNs = 0;			// rate limit, 0 = every call
+
+		Atomic<uint64>				nextAllowedNs = 0;
+		Atomic<uint32>				suppressed = 0;
+
+		bool TryPass(uint64 now_ns, OUT uint32& suppressedCount)
+		{
+			uint64 next = nextAllowedNs.load(std::memory_order_relaxed);
+			if (now_ns < next || nextAllowedNs.compare_exchange_strong(next, now_ns + intervalNs, std::memory_order_relaxed) == false)
+			{
+				suppressed.fetch_add(1, std::memory_order_relaxed);
+				return false;
+			}
+			suppressedCount = suppressed.exchange(0, std::memory_order_relaxed);
+			return true;
+		}
+	};
+
+	using LogFormatFn = void(*)(std::string_view format, const uint8* args, fmt::memory_buffer& out);
+
+	// Fixed header of a ring entry, raw arguments follow.
+	struct LogRecord
+	{
+		enum : uint32 { RECORD = 0, PAD = 1 };		// PAD: skip to the ring start
+
+		uint32			size;
+		uint32			kind;
+		const LogSite*	site;
+		LogFormatFn		format;
+		const char*		formatData;
+		uint32			formatSize;
+		uint32			suppressed;
+		uint64			time_ns;
+	};
+
+	/*-------------
+		LogArg
+	--------------*/
+
+	// How an argument is copied into the ring and read back on the logger thread.
+	// Trivially copyable values go in as bytes, strings as length + chars.
+	template<typename T>
+	struct LogArg
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "log arguments must be trivially copyable or strings");
+
+		using Stored = T;
+
+		static uint32 Size(const T&) { return sizeof(T); }
+
+		static void Encode(uint8*& dst, const T& value)
+		{
+			::memcpy(dst, &value, sizeof(T));
+			dst += sizeof(T);
+		}
+
+		static Stored Decode(const uint8*& src)
+		{
+			T value;
+			::memcpy(&value, src, sizeof(T));
+			src += sizeof(T);
+			return value;
+		}
+	};
+
+	struct LogStringArg
+	{
+		using Stored = std::string_view;		// points into the ring, valid while formatting
+
+		static uint32 Length(std::string_view s) { return static_cast<uint32>((std::min)(s.size(), size_t(MAX_LOG_STRING))); }
+
+		static uint32 Size(std::string_view s) { return sizeof(uint32) + Length(s); }
+
+		static void Encode(uint8*& dst, std::string_view s)
+		{
+			const uint32 len = Length(s);
+			::memcpy(dst, &len, sizeof(uint32));
+			::memcpy(dst + sizeof(uint32), s.data(), len);
+			dst += sizeof(uint32) + len;
+		}
+
+		static Stored Decode(const uint8*& src)
+		{
+			uint32 len;
+			::memcpy(&len, src, sizeof(uint32));
+			const char* data = reinterpret_cast<const char*>(src + sizeof(uint32));
+			src += sizeof(uint32) + len;
+			return std::string_view(data, len);
+		}
+	};
+
+	struct LogCStringArg : LogStringArg
+	{
+		static std::string_view View(const char* s) { return s ? std::string_view(s) : std::string_view("(null)"); }
+
+		static uint32 Size(const char* s) { return LogStringArg::Size(View(s)); }
+		static void Encode(uint8*& dst, const char* s) { LogStringArg::Encode(dst, View(s)); }
+	};
+
+	template<> struct LogArg<const char*> : LogCStringArg {};
+	template<> struct LogArg<char*> : LogCStringArg {};
+	template<> struct LogArg<std::string_view> : LogStringArg {};
+	template<typename Traits, typename Alloc>
+	struct LogArg<std::basic_string<char, Traits, Alloc>> : LogStringArg {};
+
+	template<typename... Args>
+	void FormatLogArgs(std::string_view format, const uint8* src, fmt::memory_buffer& out)
+	{
+		// braced init: decoded left to right
+		std::tuple<typename LogArg<Args>::Stored...> values{ LogArg<Args>::Decode(src)... };
+		std::apply([&](auto&... v)
+			{
+				fmt::vformat_to(fmt::appender(out), format, fmt::make_format_args(v...));
+			}, values);
+	}
+
+	/*-------------
+		LogRing
+	--------------*/
+
+	// Single producer (owner thread) / single consumer (logger thread) byte ring.
+	// Entries never wrap: a PAD entry fills the tail end instead.
+	class LogRing
+	{
+	public:
+		LogRing(uint32 threadId) : m_threadId(threadId) {}
+
+		// producer
+		uint8* Reserve(uint32 size)
+		{
+			const uint64 head = m_head.load(std::memory_order_relaxed);
+			const uint32 pos = static_cast<uint32>(head & (LOG_RING_SIZE - 1));
+			const uint32 contiguous = LOG_RING_SIZE - pos;
+			const uint32 need = (contiguous < size) ? contiguous + size : size;
+
+			if (need > LOG_RING_SIZE - (head - m_cachedTail))
+			{
+				m_cachedTail = m_tail.load(std::memory_order_acquire);
+				if (need > LOG_RING_SIZE - (head - m_cachedTail))
+					return nullptr;
+			}
+
+			if (contiguous < size)
+			{
+				LogRecord* pad = reinterpret_cast<LogRecord*>(m_buffer + pos);
+				pad->size = contiguous;
+				pad->kind = LogRecord::PAD;
+				m_pendingHead = head + contiguous;
+				return m_buffer;
+			}
+
+			m_pendingHead = head;
+			return m_buffer + pos;
+		}
+
+		void Commit(uint32 size) { m_head.store(m_pendingHead + size, std::memory_order_release); }
+
+		void AddDropped() { m_dropped.fetch_add(1, std::memory_order_relaxed); }
+		void Close() { m_closed.store(true, std::memory_order_release); }
+
+		// consumer
+		const LogRecord* Peek() const
+		{
+			const uint64 tail = m_tail.load(std::memory_order_relaxed);
+			if (tail == m_head.load(std::memory_order_acquire))
+				return nullptr;
+			return reinterpret_cast<const LogRecord*>(m_buffer + (tail & (LOG_RING_SIZE - 1)));
+		}
+
+		void Pop(uint32 size) { m_tail.store(m_tail.load(std::memory_order_relaxed) + size, std::memory_order_release); }
+
+		uint64 GetDropped() const { return m_dropped.load(std::memory_order_relaxed); }
+		bool IsClosed() const { return m_closed.load(std::memory_order_acquire); }
+		uint32 GetThreadId() const { return m_threadId; }
+
+	public:
+		uint64					droppedReported = 0;		// consumer only
+
+	private:
+		alignas(64) Atomic<uint64>	m_head = 0;
+		uint64					m_pendingHead = 0;
+		uint64					m_cachedTail = 0;
+		Atomic<uint64>			m_dropped = 0;
+
+		alignas(64) Atomic<uint64>	m_tail = 0;
+		Atomic<bool>			m_closed = false;
+		uint32					m_threadId = 0;
+
+		alignas(64) uint8		m_buffer[LOG_RING_SIZE];
+	};
+}
@@ -4,8 +4,28 @@
 
 namespace jam::utils
 {
+	struct LogRingOwner
+	{
+		LogRing*	ring = nullptr;
+
+		~LogRingOwner()
+		{
+			if (ring)
+				ring->Close();		// the logger thread frees it once drained
+		}
+	};
+
+	static thread_local LogRingOwner tl_LogRing;
+
+	static constexpr uint64 LOG_IDLE_SLEEP_MS = 1;
+	static constexpr uint64 LOG_FLUSH_INTERVAL_NS = 500'000'000;
+	static constexpr uint64 LOG_ANCHOR_INTERVAL_NS = 1'000'000'000;
+
 	void Logger::Init()
 	{
+		if (m_running.load())
+			return;
+
 		spdlog::set_pattern("[%Y-%m-%d %H:%M:%S.%e] [%n] [T%t] [%^%l%$] %v");
 
 		auto consoleSink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
@@ -15,9 +35,169 @@ namespace jam::utils
 
 		_logger = std::make_shared<spdlog::logger>("JamNet", sinks.begin(), sinks.end());
 		_logger->set_level(spdlog::level::trace);
+
+		m_wallAnchor = spdlog::log_clock::now();
+		m_nsAnchor = Clock::Instance().NowNs();
+
+		m_sync.store(false);
+		m_running.store(true);
+		m_thread = std::thread([this]() { DrainLoop(); });
 	}
 
 	void Logger::Shutdown()
 	{
+		if (m_running.exchange(false) == false)
+			return;
+
+		// anything logged from now on (other singletons' shutdown) goes straight to spdlog
+		m_sync.store(true);
+
+		if (m_thread.joinable())
+			m_thread.join();
+
+		// a record pushed by a thread that saw m_sync still false can land after the drain
+		// thread's last pass: pick it up here
+		std::vector<LogRing*> rings;
+		fmt::memory_buffer buffer;
+		if (DrainOnce(rings, buffer) > 0)
+			_logger->flush();
+	}
+
+	LogRing* Logger::LocalRing()
+	{
+		if (tl_LogRing.ring == nullptr)
+		{
+			LogRing* ring = new LogRing(static_cast<uint32>(spdlog::details::os::thread_id()));
+
+			Logger& logger = Instance();
+			LockGuard guard(logger.m_ringsLock);
+			logger.m_rings.push_back(ring);
+			tl_LogRing.ring = ring;
+		}
+		return tl_LogRing.ring;
+	}
+
+	void Logger::WriteSync(const LogSite& site, std::string_view text, uint32 suppressed)
+	{
+		if (_logger == nullptr)
+			return;
+
+		const spdlog::source_loc loc{ site.file, site.line, nullptr };
+		if (suppressed > 0)
+			_logger->log(loc, site.level, "{} (+{} suppressed)", text, suppressed);
+		else
+			_logger->log(loc, site.level, "{}", text);
+	}
+
+	void Logger::DrainLoop()
+	{
+		std::vector<LogRing*> rings;
+		fmt::memory_buffer buffer;
+		uint64 lastFlush_ns = Clock::Instance().NowNs();
+
+		while (true)
+		{
+			// read the flag first: whatever was committed before Shutdown is drained below
+			const bool stopping = (m_running.load() == false);
+
+			const uint32 written = DrainOnce(rings, buffer);
+
+			const uint64 now_ns = Clock::Instance().NowNs();
+			if (now_ns - m_nsAnchor >= LOG_ANCHOR_INTERVAL_NS)
+			{
+				m_wallAnchor = spdlog::log_clock::now();
+				m_nsAnchor = Clock::Instance().NowNs();
+			}
+
+			if (stopping)
+				break;
+
+			if (written > 0 && now_ns - lastFlush_ns >= LOG_FLUSH_INTERVAL_NS)
+			{
+				_logger->flush();
+				lastFlush_ns = now_ns;
+			}
+
+			if (written == 0)
+				std::this_thread::sleep_for(std::chrono::milliseconds(LOG_IDLE_SLEEP_MS));
+		}
+
+		_logger->flush();
+	}
+
+	uint32 Logger::DrainOnce(std::vector<LogRing*>& rings, fmt::memory_buffer& buffer)
+	{
+		{
+			LockGuard guard(m_ringsLock);
+			rings.assign(m_rings.begin(), m_rings.end());
+		}
+
+		uint32 written = 0;
+
+		for (LogRing* ring : rings)
+		{
+			const bool closed = ring->IsClosed();
+
+			while (const LogRecord* record = ring->Peek())
+			{
+				if (record->kind == LogRecord::RECORD)
+				{
+					Emit(*ring, *record, buffer);
+					++written;
+				}
+				ring->Pop(record->size);
+			}
+
+			const uint64 dropped = ring->GetDropped();
+			if (dropped != ring->droppedReported)
+			{
+				_logger->warn("[Log] thread {} dropped {} records (ring full)", ring->GetThreadId(), dropped - ring->droppedReported);
+				ring->droppedReported = dropped;
+			}
+
+			if (closed)
+			{
+				LockGuard guard(m_ringsLock);
+				m_rings.erase(std::find(m_rings.begin(), m_rings.end(), ring));
+				delete ring;
+			}
+		}
+
+		return written;
+	}
+
+	void Logger::Emit(const LogRing& ring, const LogRecord& record, fmt::memory_buffer& buffer)
+	{
+		const LogSite& site = *record.site;
+
+		buffer.clear();
+		try
+		{
+			record.format(std::string_view(record.formatData, record.formatSize),
+				reinterpret_cast<const uint8*>(&record) + sizeof(LogRecord), buffer);
+		}
+		catch (const fmt::format_error& e)
+		{
+			buffer.clear();
+			fmt::format_to(fmt::appender(buffer), "[Log] format error '{}' in '{}'", e.what(),
+				std::string_view(record.formatData, record.formatSize));
+		}
+
+		if (record.suppressed > 0)
+			fmt::format_to(fmt::appender(buffer), " (+{} suppressed)", record.suppressed);
+
+		// wrapping subtraction: records older than the anchor come out negative
+		const int64 sinceAnchor = static_cast<int64>(record.time_ns - m_nsAnchor);
+		const auto time = m_wallAnchor + std::chrono::duration_cast<spdlog::log_clock::duration>(std::chrono::nanoseconds(sinceAnchor));
+
+		spdlog::details::log_msg msg(time, spdlog::source_loc{ site.file, site.line, nullptr }, _logger->name(), site.level,
+			spdlog::string_view_t(buffer.data(), buffer.size()));
+		msg.thread_id = ring.GetThreadId();
+
+		for (const spdlog::sink_ptr& sink : _logger->sinks())
+		{
+			if (sink->should_log(site.level))
+				sink->log(msg);
+		}
 	}
-}
\ No newline at end of file
+}
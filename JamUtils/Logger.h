@@ -1,29 +1,140 @@
 #pragma once
+#include "Clock.h"
+#include "LogRing.h"
+
+// Calls below this level compile to nothing. Debug stays compiled in release so
+// packet-level logging can be switched on at runtime (Logger::SetLevel).
+#ifndef JAM_LOG_ACTIVE_LEVEL
+#ifdef _DEBUG
+#define JAM_LOG_ACTIVE_LEVEL SPDLOG_LEVEL_TRACE
+#else
+#define JAM_LOG_ACTIVE_LEVEL SPDLOG_LEVEL_DEBUG
+#endif
+#endif
 
 namespace jam::utils
 {
 	using spdlogRef = std::shared_ptr<spdlog::logger>;
 
+	// Asynchronous front end of spdlog.
+	// A call copies its format string pointer and raw arguments into a per-thread ring;
+	// the logger thread formats and hands them to the sinks. A full ring drops the record.
 	class Logger
 	{
 		DECLARE_SINGLETON(Logger)
 
 	public:
 		void			Init();
-		void			Shutdown();
+		void			Shutdown();			// drains, then later calls log synchronously
 
 		spdlogRef&		GetLogger() { return _logger; }
 
+		void			SetLevel(spdlog::level::level_enum level) { m_level.store(level, std::memory_order_relaxed); }
+
+		template<typename... Args>
+		void Write(LogSite& site, fmt::format_string<Args...> format, Args&&... args)
+		{
+			if (site.level < m_level.load(std::memory_order_relaxed))
+				return;
+
+			const uint64 now_ns = Clock::Instance().NowNs();
+
+			uint32 suppressed = 0;
+			if (site.intervalNs > 0 && site.TryPass(now_ns, OUT suppressed) == false)
+				return;
+
+			const std::string_view fmtView(format.get().data(), format.get().size());
+
+			if (m_sync.load(std::memory_order_relaxed))
+			{
+				WriteSync(site, fmt::vformat(fmtView, fmt::make_format_args(args...)), suppressed);
+				return;
+			}
+
+			const uint32 argSize = (0 + ... + LogArg<std::decay_t<Args>>::Size(args));
+			const uint32 size = (static_cast<uint32>(sizeof(LogRecord)) + argSize + 7) & ~7u;
+
+			LogRing* ring = LocalRing();
+			uint8* ptr = (size <= LOG_RING_SIZE / 2) ? ring->Reserve(size) : nullptr;
+			if (ptr == nullptr)
+			{
+				ring->AddDropped();
+				return;
+			}
+
+			LogRecord* record = reinterpret_cast<LogRecord*>(ptr);
+			record->size = size;
+			record->kind = LogRecord::RECORD;
+			record->site = &site;
+			record->format = &FormatLogArgs<std::decay_t<Args>...>;
+			record->formatData = fmtView.data();
+			record->formatSize = static_cast<uint32>(fmtView.size());
+			record->suppressed = suppressed;
+			record->time_ns = now_ns;
+
+			uint8* dst = ptr + sizeof(LogRecord);
+			(LogArg<std::decay_t<Args>>::Encode(dst, args), ...);
+
+			ring->Commit(size);
+		}
+
+	private:
+		static LogRing*	LocalRing();
+
+		void			WriteSync(const LogSite& site, std::string_view text, uint32 suppressed);
+		void			DrainLoop();
+		uint32			DrainOnce(std::vector<LogRing*>& rings, fmt::memory_buffer& buffer);
+		void			Emit(const LogRing& ring, const LogRecord& record, fmt::memory_buffer& buffer);
+
 	private:
 		spdlogRef		_logger;
+
+		Atomic<spdlog::level::level_enum>	m_level = spdlog::level::trace;
+		Atomic<bool>	m_running = false;
+		Atomic<bool>	m_sync = false;
+		std::thread		m_thread;
+
+		Mutex			m_ringsLock;
+		std::vector<LogRing*>	m_rings;
+
+		// record time (Clock ns) -> wall clock, re-anchored once a second by the logger thread
+		spdlog::log_clock::time_point	m_wallAnchor;
+		uint64			m_nsAnchor = 0;
 	};
 }
 
-#define LOG_TRACE(...) Logger::Instance().GetLogger()->trace(__VA_ARGS__)
-#define LOG_DEBUG(...) Logger::Instance().GetLogger()->debug(__VA_ARGS__)
-#define LOG_INFO(...)  Logger::Instance().GetLogger()->info(__VA_ARGS__)
-#define LOG_WARN(...)  Logger::Instance().GetLogger()->warn(__VA_ARGS__)
-#define LOG_ERROR(...) Logger::Instance().GetLogger()->error(__VA_ARGS__)
-#define LOG_CRITICAL(...) Logger::Instance().GetLogger()->critical(__VA_ARGS__)
-#define LOG_OFF(...) Logger::Instance().GetLogger()->off(__VA_ARGS__)
+#define JAM_LOG(level, intervalNs, ...)																\
+	do																								\
+	{																								\
+		static ::jam::utils::LogSite jamLogSite{ level, __FILE__, __LINE__, intervalNs };			\
+		::jam::utils::Logger::Instance().Write(jamLogSite, __VA_ARGS__);							\
+	} while (0)
+
+#if JAM_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_TRACE
+#define LOG_TRACE(...) JAM_LOG(spdlog::level::trace, 0, __VA_ARGS__)
+#else
+#define LOG_TRACE(...) (void)0
+#endif
+
+#if JAM_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_DEBUG
+#define LOG_DEBUG(...) JAM_LOG(spdlog::level::debug, 0, __VA_ARGS__)
+#define LOG_DEBUG_EVERY(intervalNs, ...) JAM_LOG(spdlog::level::debug, intervalNs, __VA_ARGS__)
+#else
+#define LOG_DEBUG(...) (void)0
+#define LOG_DEBUG_EVERY(intervalNs, ...) (void)0
+#endif
+
+#if JAM_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_INFO
+#define LOG_INFO(...)  JAM_LOG(spdlog::level::info, 0, __VA_ARGS__)
+#define LOG_INFO_EVERY(intervalNs, ...) JAM_LOG(spdlog::level::info, intervalNs, __VA_ARGS__)
+#else
+#define LOG_INFO(...) (void)0
+#define LOG_INFO_EVERY(intervalNs, ...) (void)0
+#endif
 
+#define LOG_WARN(...)  JAM_LOG(spdlog::level::warn, 0, __VA_ARGS__)
+#define LOG_WARN_EVERY(intervalNs, ...) JAM_LOG(spdlog::level::warn, intervalNs, __VA_ARGS__)
+#define LOG_ERROR(...) JAM_LOG(spdlog::level::err, 0, __VA_ARGS__)
+#define LOG_ERROR_EVERY(intervalNs, ...) JAM_LOG(spdlog::level::err, intervalNs, __VA_ARGS__)
+#define LOG_CRITICAL(...) JAM_LOG(spdlog::level::critical, 0, __VA_ARGS__)
+#define LOG_OFF(...) (void)0
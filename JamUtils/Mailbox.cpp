@@ -1,84 +1,237 @@
 #include "pch.h"
 #include "Mailbox.h"
 #include "ShardExecutor.h"
+#include "Clock.h"
+#include "ShardTLS.h"
 
 namespace jam::utils::exec
 {
-	Mailbox::Mailbox(uint32 id, Wptr<ShardExecutor> owner, eMailboxChannel channel)
-		: m_id(id), m_owner(std::move(owner)), m_consumerToken(m_queue), m_channel(channel)
+	Mailbox::Mailbox(uint32 id, Wptr<ShardExecutor> owner, uint64 routeKey)
+		: m_id(id), m_routeKey(routeKey)
 	{
+		m_ownerTag.store(owner.lock().get(), std::memory_order_relaxed);
+		m_owner.store(std::move(owner), std::memory_order_relaxed);
 	}
 
-	bool Mailbox::Post(job::Job job)
+	bool Mailbox::Post(job::Job&& job, eMailboxChannel lane)
 	{
-		bool expected = m_queue.enqueue(std::move(job));
-		if (expected)
-		{
-			const uint64 prev = m_size.fetch_add(1, std::memory_order_relaxed);
-			if (prev == 0)
-				NotifyReadyIfFirst();
-		}
-		return expected;
+		// same-shard: the owner's thread keeps to its local lanes while they hold anything, and
+		// enters them only when the shared lanes are empty, so it never overtakes its own posts
+		ShardExecutor* self = ShardTLS::GetExecutor();
+		if (self != nullptr && IsOwnedBy(self) && (m_localSize != 0 || m_size.load(std::memory_order_relaxed) == 0))
+			return PostLocal(self, std::move(job), lane);
+
+		if (!BeginPost())
+			return false;
+
+		if (job.IsTimed())
+			OnTimedPost(job, lane);
+
+		m_lanes[E2U(lane)].Push(std::move(job));
+		OnPosted(lane, 1);
+		EndPost();
+		return true;
+	}
+
+	bool Mailbox::PostCoalesced(uint8 key, job::Job&& job, eMailboxChannel lane)
+	{
+		ASSERT_CRASH(key < MAX_COALESCE_KEYS);
+		const uint64 bit = 1ull << key;
+
+		// already pending: a plain load, no write to the shared line
+		if (m_coalesced.load(std::memory_order_relaxed) & bit)
+			return true;
+		if (m_coalesced.fetch_or(bit, std::memory_order_acq_rel) & bit)
+			return true;
+
+		job.SetCoalesceKey(key);
+		if (Post(std::move(job), lane))
+			return true;
+
+		// refused (closed): the caller's fallback gets the job back, untagged
+		job.SetCoalesceKey(job::Job::NO_COALESCE);
+		m_coalesced.fetch_and(~bit, std::memory_order_release);
+		return false;
 	}
 
-	bool Mailbox::Post(const moodycamel::ProducerToken& token, job::Job job)
+	uint64 Mailbox::PostBulk(job::Job* job, uint64 count, eMailboxChannel lane)
 	{
-		bool expected = m_queue.enqueue(token, std::move(job));
-		if (expected)
+		ShardExecutor* self = ShardTLS::GetExecutor();
+		if (count > 0 && self != nullptr && IsOwnedBy(self) && (m_localSize != 0 || m_size.load(std::memory_order_relaxed) == 0))
 		{
-			const uint64 prev = m_size.fetch_add(1, std::memory_order_relaxed);
-			if (prev == 0)
-				NotifyReadyIfFirst();
+			uint64 n = 0;
+			while (n < count && PostLocal(self, std::move(job[n]), lane))
+				++n;
+			return n;
 		}
-		return expected;
+
+		if (count == 0 || !BeginPost())
+			return 0;
+
+		for (uint64 i = 0; i < count; ++i)
+		{
+			if (job[i].IsTimed())
+				OnTimedPost(job[i], lane);
+			m_lanes[E2U(lane)].Push(std::move(job[i]));
+		}
+
+		OnPosted(lane, count);
+		EndPost();
+		return count;
+	}
+
+	bool Mailbox::PostLocal(ShardExecutor* owner, job::Job&& job, eMailboxChannel lane)
+	{
+		// Close from another thread is only seen late: a job posted past it still runs, as on the
+		// shared path; reclaim waits for the local lanes anyway
+		if (m_closed.load(std::memory_order_relaxed))
+			return false;
+
+		if (job.IsTimed())
+			OnTimedPost(job, lane);
+
+		m_localLanes[E2U(lane)].Push(std::move(job));
+		++m_localSize;
+		if (TryMarkLocalReady(lane))
+			owner->NotifyLocalReady(this, lane);
+		return true;
 	}
 
-	uint64 Mailbox::PostBulk(const moodycamel::ProducerToken& token, job::Job* job, uint64 count)
+	void Mailbox::SpillLocal()
 	{
-		bool expected = m_queue.try_enqueue_bulk(token, job, count);
-		if (expected)
+		// behind whatever the shared lanes hold: none of it was posted by the owner after these
+		for (uint8 i = 0; i < E2U(eMailboxChannel::COUNT); ++i)
 		{
-			const uint64 prev = m_size.fetch_add(count, std::memory_order_relaxed);
-			if (prev == 0)
-				NotifyReadyIfFirst();
+			uint64 n = 0;
+			job::Job job;
+			while (m_localLanes[i].TryPop(job))
+			{
+				m_lanes[i].Push(std::move(job));
+				++n;
+			}
+
+			if (n > 0 && i == E2U(eMailboxChannel::CTRL))
+				m_ctrlSize.fetch_add(n, std::memory_order_relaxed);
+			if (n > 0)
+				m_size.fetch_add(n, std::memory_order_seq_cst);
+			m_localReady[i] = false;
 		}
-		return expected;
+		m_localSize = 0;
 	}
 
-	bool Mailbox::TryPop(OUT job::Job& job)
+	bool Mailbox::BeginPost()
 	{
-		if (m_queue.try_dequeue(m_consumerToken, job))
+		// seq_cst pairs with Close / IsReclaimable: either the post sees the close, or the
+		// reclaimer sees the post in flight (and after it, its size and ready ref)
+		m_posting.fetch_add(1, std::memory_order_seq_cst);
+		if (m_closed.load(std::memory_order_seq_cst))
 		{
-			m_size.fetch_sub(1, std::memory_order_relaxed);
-			return true;
+			EndPost();
+			return false;
 		}
-		return false;
+		return true;
 	}
 
-	uint64 Mailbox::TryPopBulk(job::Job* job, uint64 count)
+	bool Mailbox::IsReclaimable() const
 	{
-		uint64 n = m_queue.try_dequeue_bulk(m_consumerToken, job, count);
-		if (n > 0)
-			m_size.fetch_sub(n, std::memory_order_relaxed);
-		return n;
+		return m_closed.load(std::memory_order_seq_cst)
+			&& m_posting.load(std::memory_order_seq_cst) == 0
+			&& m_readyRefs.load(std::memory_order_acquire) == 0
+			&& m_size.load(std::memory_order_acquire) == 0
+			&& !m_processing.load(std::memory_order_acquire)
+			&& m_localSize == 0
+			&& !m_localReady[E2U(eMailboxChannel::CTRL)]
+			&& !m_localReady[E2U(eMailboxChannel::NORMAL)];
 	}
 
+	void Mailbox::BeginTransit()
+	{
+		m_ownerTag.store(nullptr, std::memory_order_release);
+		m_owner.store(Wptr<ShardExecutor>{}, std::memory_order_seq_cst);
 
+		// a post that loaded the old owner is still inside BeginPost/EndPost: let it finish, so the
+		// old shard sees every stale notification before it forwards its ready lists
+		while (m_posting.load(std::memory_order_seq_cst) != 0)
+			std::this_thread::yield();
+
+		// called on the old owner's thread: its same-shard jobs travel in the shared lanes
+		SpillLocal();
+	}
+
+	void Mailbox::EndTransit(ShardExecutor* owner, uint32 id)
+	{
+		m_id.store(id, std::memory_order_release);
+		m_ownerTag.store(owner, std::memory_order_release);
+		m_owner.store(owner->weak_from_this(), std::memory_order_seq_cst);
+	}
+
+	uint64 Mailbox::GetEscalateAt() const
+	{
+		const uint64 at = m_escalateAt_ns.load(std::memory_order_relaxed);
+		return at == NO_ESCALATION ? 0 : at;
+	}
+
+	bool Mailbox::TryPop(OUT job::Job& job, bool withLocal)
+	{
+		return TryPopBulk(&job, 1, withLocal) == 1;
+	}
+
+	void Mailbox::OnPosted(eMailboxChannel lane, uint64 count)
+	{
+		const uint64 prevCtrl = (lane == eMailboxChannel::CTRL) ? m_ctrlSize.fetch_add(count, std::memory_order_relaxed) : 1;
+		// seq_cst against EndTransit: either the new owner sees this size, or we see the new owner
+		const uint64 prev = m_size.fetch_add(count, std::memory_order_seq_cst);
+
+		// one notification per idle->busy; control work arriving behind queued normal work also
+		// takes the ctrl ready list (the stale normal entry then finds less, or nothing)
+		if (prev == 0 || prevCtrl == 0)
+		{
+			if (auto owner = GetOwner())
+				owner->NotifyReady(this, lane);
+		}
+	}
+
+
+	// acquire/release pair: the next consumer sees what the previous one left behind
+	// (lane cursors, job state), even when it runs on another thread
 	bool Mailbox::TryBeginConsume()
 	{
 		bool expected = false;
-		return m_processing.compare_exchange_strong(expected, true, std::memory_order_relaxed);
+		return m_processing.compare_exchange_strong(expected, true, std::memory_order_acquire, std::memory_order_relaxed);
 	}
 
 	void Mailbox::EndConsume()
 	{
-		m_processing.store(false, std::memory_order_relaxed);
+		m_processing.store(false, std::memory_order_release);
+	}
+
+	bool Mailbox::TakeEscalation(uint64 now_ns)
+	{
+		uint64 at = m_escalateAt_ns.load(std::memory_order_relaxed);
+		while (at <= now_ns)
+		{
+			if (m_escalateAt_ns.compare_exchange_weak(at, NO_ESCALATION, std::memory_order_relaxed))
+				return true;
+		}
+		return false;
 	}
 
-	void Mailbox::NotifyReadyIfFirst()
+	void Mailbox::OnTimedPost(job::Job& job, eMailboxChannel lane)
 	{
-		if (auto owner = m_owner.lock())
-			owner->NotifyReady(this);
+		const uint64 due = job.GetEscalateAtNs();
+		if (due == 0 || lane != eMailboxChannel::NORMAL)
+			return;
+
+		// keep the earliest due time; every time it moves earlier the shard gets a watch for it
+		uint64 prev = m_escalateAt_ns.load(std::memory_order_relaxed);
+		while (due < prev)
+		{
+			if (m_escalateAt_ns.compare_exchange_weak(prev, due, std::memory_order_relaxed))
+			{
+				if (auto owner = GetOwner())
+					owner->WatchEscalation(GetId(), due);
+				return;
+			}
+		}
 	}
 }
- 
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
-#include "concurrentqueue/concurrentqueue.h"
+#include "MpscQueue.h"
+#include "LocalQueue.h"
 #include "Job.h"
 #include "ShardSlot.h"
 
@@ -10,59 +11,193 @@ namespace jam::utils::exec
 
 
 
-	// Mailbox:  Һ(ShardExecutor ) Pop
+	// Mailbox: 단일 소비자(ShardExecutor 스레드)만 Pop
+	// One per session, two lanes: CTRL is always popped before NORMAL. Both lanes share one ready
+	// notification and one consumer guard. Each lane is an intrusive MPSC queue with pooled nodes,
+	// so an idle mailbox costs a few cache lines.
+	// Posts made on the owning shard's thread take a second pair of lanes that only that thread
+	// touches: no atomics, and a shard-local ready list instead of NotifyReady.
 	class Mailbox
 	{
 	public:
-		explicit Mailbox(uint32 id, Wptr<ShardExecutor> owner, eMailboxChannel channel = eMailboxChannel::NORMAL);
+		Mailbox(uint32 id, Wptr<ShardExecutor> owner, uint64 routeKey = 0);
 		~Mailbox() = default;
 
-		bool			Post(job::Job job);
-		bool			Post(const moodycamel::ProducerToken& token, job::Job job);
-		uint64			PostBulk(const moodycamel::ProducerToken& token, job::Job* job, uint64 count);
+		// false once closed; the job is then left untouched for the caller's fallback
+		bool			Post(job::Job&& job, eMailboxChannel lane = eMailboxChannel::NORMAL);
+		uint64			PostBulk(job::Job* job, uint64 count, eMailboxChannel lane = eMailboxChannel::NORMAL);
 
+		// idempotent requests ("flush E", "rescan E"): while a job with key is queued, another
+		// post with it is dropped and reported as accepted; the queued one runs against current
+		// state. The key is free again once that job is popped. key < MAX_COALESCE_KEYS
+		static constexpr uint8 MAX_COALESCE_KEYS = 64;
+		bool			PostCoalesced(uint8 key, job::Job&& job, eMailboxChannel lane = eMailboxChannel::NORMAL);
+		bool			IsCoalescePending(uint8 key) const { return (m_coalesced.load(std::memory_order_relaxed) & (1ull << key)) != 0; }
 
-		bool			TryPop(OUT job::Job& job);
-		uint64			TryPopBulk(OUT job::Job* job, uint64 count);
+
+		// withLocal: the owner shard's thread, which also takes the same-shard lanes
+		bool			TryPop(OUT job::Job& job, bool withLocal = false);
+		uint64			TryPopBulk(OUT job::Job* job, uint64 count, bool withLocal = false) { return TryPopBulk<job::Job*>(job, count, withLocal); }
 
 		template<typename OutputIt>
-		uint64			TryPopBulk(OUT OutputIt out, uint64 count);
+		uint64			TryPopBulk(OUT OutputIt out, uint64 count, bool withLocal = false);
 
 
 		bool			TryBeginConsume();
 		void			EndConsume();
 
+		// shared lanes only; the same-shard ones are HasLocalWork
 		bool			IsEmpty() const { return GetSizeApprox() == 0; }
 		uint64			GetSizeApprox() const { return m_size.load(std::memory_order_relaxed); }
-		uint32			GetId() const { return m_id; }
+		uint32			GetId() const { return m_id.load(std::memory_order_acquire); }
+		uint64			GetRouteKey() const { return m_routeKey; }		// 0: stays with its shard
 		bool			IsProcessing() const { return m_processing.load(std::memory_order_relaxed); }
 
-
-		eMailboxChannel GetMailboxChannel() const { return m_channel; }
+		// ready list to (re)queue on: CTRL while control work is pending
+		eMailboxChannel ReadyLane() const
+		{
+			return m_ctrlSize.load(std::memory_order_relaxed) > 0 ? eMailboxChannel::CTRL : eMailboxChannel::NORMAL;
+		}
+
+		// set when queued on the shard's ready list (queue wait metric)
+		void			MarkReady(uint64 now_ns) { m_readySince_ns.store(now_ns, std::memory_order_relaxed); }
+		uint64			GetReadySince() const { return m_readySince_ns.load(std::memory_order_relaxed); }
+
+		// deadline / escalation bookkeeping (see job::Job::ExpireAt, EscalateAfter)
+		bool			TakeEscalation(uint64 now_ns);		// due: disarms and returns true
+		void			ClearEscalation() { m_escalateAt_ns.store(NO_ESCALATION, std::memory_order_relaxed); }
+		void			AddExpired(uint64 count) { m_expired.fetch_add(count, std::memory_order_relaxed); }
+		uint64			GetExpiredCount() const { return m_expired.load(std::memory_order_relaxed); }
+
+		// removal (MailboxRegistry): posts after Close are refused, queued jobs still drain
+		void			Close() { m_closed.store(true, std::memory_order_seq_cst); }
+		bool			IsClosed() const { return m_closed.load(std::memory_order_relaxed); }
+
+		// one per entry on a ready list; the registry keeps a removed mailbox alive until none is left
+		void			AddReadyRef() { m_readyRefs.fetch_add(1, std::memory_order_relaxed); }
+		void			ReleaseReadyRef() { m_readyRefs.fetch_sub(1, std::memory_order_release); }
+		bool			IsReclaimable() const;		// owner shard thread
+
+		// same-shard lanes, owner shard thread only
+		bool			HasLocalWork() const { return m_localSize != 0; }
+		eMailboxChannel LocalReadyLane() const
+		{
+			return m_localLanes[E2U(eMailboxChannel::CTRL)].IsEmpty() ? eMailboxChannel::NORMAL : eMailboxChannel::CTRL;
+		}
+		// one entry per lane on the shard's local ready list: true when the caller must queue it
+		bool			TryMarkLocalReady(eMailboxChannel lane) { return !std::exchange(m_localReady[E2U(lane)], true); }
+		void			ClearLocalReady(eMailboxChannel lane) { m_localReady[E2U(lane)] = false; }
+		// set when queued on the shard's local ready list (queue wait metric, as MarkReady)
+		void			MarkLocalReady(uint64 now_ns) { m_localReadySince_ns = now_ns; }
+		uint64			GetLocalReadySince() const { return m_localReadySince_ns; }
+
+		// owning shard; null while handed over between shards (ShardExecutor::Rebalance)
+		Sptr<ShardExecutor>	GetOwner() const { return m_owner.load(std::memory_order_seq_cst).lock(); }
+		bool			IsOwnedBy(const ShardExecutor* shard) const { return m_ownerTag.load(std::memory_order_acquire) == shard; }
+
+		// hand-over: detach from the old owner (returns once no post still notifies it), then the
+		// new owner publishes the mailbox under its own id
+		void			BeginTransit();
+		void			EndTransit(ShardExecutor* owner, uint32 id);
+		uint64			GetEscalateAt() const;		// 0 = none armed
 
 	private:
-		void			NotifyReadyIfFirst();
+		bool			PostLocal(ShardExecutor* owner, job::Job&& job, eMailboxChannel lane);
+		void			SpillLocal();
+		bool			BeginPost();
+		void			EndPost() { m_posting.fetch_sub(1, std::memory_order_seq_cst); }
+		void			OnPosted(eMailboxChannel lane, uint64 count);
+		void			OnTimedPost(job::Job& job, eMailboxChannel lane);
+		void			OnTaken(const job::Job& job)
+		{
+			if (job.GetCoalesceKey() != job::Job::NO_COALESCE)
+				m_coalesced.fetch_and(~(1ull << job.GetCoalesceKey()), std::memory_order_release);
+		}
+
+		static constexpr uint64 NO_ESCALATION = ~0ull;
 
 	private:
-		uint32										m_id = 0;
-		Wptr<ShardExecutor>							m_owner;
-		moodycamel::ConcurrentQueue<job::Job>		m_queue; // MPSC
-		moodycamel::ConsumerToken					m_consumerToken;
-		Atomic<uint64>								m_size{ 0 };
+		Atomic<uint32>								m_id{ 0 };
+		uint64										m_routeKey = 0;
+		std::atomic<Wptr<ShardExecutor>>			m_owner;
+		Atomic<const ShardExecutor*>				m_ownerTag{ nullptr };		// identity only, never dereferenced
+		thrd::MpscQueue<job::Job>					m_lanes[E2U(eMailboxChannel::COUNT)];
+		Atomic<uint64>								m_size{ 0 };		// both lanes
+		Atomic<uint64>								m_ctrlSize{ 0 };
 		Atomic<bool>								m_processing{ false };
 
-		eMailboxChannel								m_channel;
+		Atomic<uint64>								m_escalateAt_ns{ NO_ESCALATION };	// earliest due escalation, NORMAL lane
+		Atomic<uint64>								m_expired{ 0 };
+		Atomic<uint64>								m_readySince_ns{ 0 };
+
+		Atomic<bool>								m_closed{ false };
+		Atomic<uint32>								m_posting{ 0 };		// posts past the closed check
+		Atomic<uint32>								m_readyRefs{ 0 };
+		Atomic<uint64>								m_coalesced{ 0 };		// one bit per coalesce key with a job queued
+
+		// owner shard thread only
+		thrd::LocalQueue<job::Job>					m_localLanes[E2U(eMailboxChannel::COUNT)];
+		uint64										m_localSize = 0;
+		bool										m_localReady[E2U(eMailboxChannel::COUNT)] = {};
+		uint64										m_localReadySince_ns = 0;
 	};
 
 
 
 	template<typename OutputIt>
-	inline uint64 Mailbox::TryPopBulk(OUT OutputIt out, uint64 count)
+	inline uint64 Mailbox::TryPopBulk(OUT OutputIt out, uint64 count, bool withLocal)
 	{
-		uint64 n = m_queue.try_dequeue_bulk(m_consumerToken, out, count);
-		if (n > 0)
-			m_size.fetch_sub(n, std::memory_order_relaxed);
+		uint64 n = 0;
+		uint64 shared = 0;
+		uint64 local = 0;
+		job::Job job;
+
+		// CTRL lane first; per lane the local jobs go ahead of the shared ones (Post never lets the
+		// owner's own posts sit in both)
+		if (withLocal)
+		{
+			auto& lane = m_localLanes[E2U(eMailboxChannel::CTRL)];
+			for (; n < count && lane.TryPop(job); ++n, ++local)
+			{
+				OnTaken(job);
+				*out++ = std::move(job);
+			}
+		}
+
+		if (m_ctrlSize.load(std::memory_order_relaxed) > 0)
+		{
+			auto& ctrl = m_lanes[E2U(eMailboxChannel::CTRL)];
+			for (; n < count && ctrl.TryPop(job); ++n, ++shared)
+			{
+				OnTaken(job);
+				*out++ = std::move(job);
+			}
+			if (shared > 0)
+				m_ctrlSize.fetch_sub(shared, std::memory_order_relaxed);
+		}
+
+		if (withLocal)
+		{
+			auto& lane = m_localLanes[E2U(eMailboxChannel::NORMAL)];
+			for (; n < count && lane.TryPop(job); ++n, ++local)
+			{
+				OnTaken(job);
+				*out++ = std::move(job);
+			}
+		}
+
+		auto& normal = m_lanes[E2U(eMailboxChannel::NORMAL)];
+		for (; n < count && normal.TryPop(job); ++n, ++shared)
+		{
+			OnTaken(job);
+			*out++ = std::move(job);
+		}
+
+		if (shared > 0)
+			m_size.fetch_sub(shared, std::memory_order_relaxed);
+		// owner-only counter: IO workers assisting (withLocal == false) never touch it
+		if (local > 0)
+			m_localSize -= local;
 		return n;
 	}
 }
-
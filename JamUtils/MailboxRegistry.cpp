@@ -0,0 +1,166 @@
+#include "pch.h"
+#include "MailboxRegistry.h"
+#include "Mailbox.h"
+
+namespace jam::utils::exec
+{
+	MailboxRegistry::~MailboxRegistry()
+	{
+		for (Atomic<Chunk*>& chunk : m_chunks)
+		{
+			if (Chunk* c = chunk.load(std::memory_order_acquire))
+				memory::xdelete(c);
+		}
+	}
+
+	uint32 MailboxRegistry::Acquire()
+	{
+		uint32 index = 0;
+		if (!PopFree(index))
+		{
+			index = m_nextIndex.fetch_add(1, std::memory_order_relaxed);
+			ASSERT_CRASH(index <= INDEX_MASK);
+		}
+
+		Slot& slot = EnsureSlot(index);
+		m_live.fetch_add(1, std::memory_order_relaxed);
+		return (slot.gen.load(std::memory_order_acquire) << INDEX_BITS) | index;
+	}
+
+	void MailboxRegistry::Publish(uint32 id, Sptr<Mailbox> mailbox)
+	{
+		Slot& slot = *SlotAt(IndexOf(id));
+		ASSERT_CRASH(slot.gen.load(std::memory_order_acquire) == GenOf(id));
+
+		Mailbox* raw = mailbox.get();
+		slot.owner = std::move(mailbox);
+		slot.mailbox.store(raw, std::memory_order_release);
+	}
+
+	Mailbox* MailboxRegistry::Find(uint32 id) const
+	{
+		const Slot* slot = SlotAt(IndexOf(id));
+		if (slot == nullptr || slot->gen.load(std::memory_order_acquire) != GenOf(id))
+			return nullptr;
+		return slot->mailbox.load(std::memory_order_acquire);
+	}
+
+	bool MailboxRegistry::Remove(uint32 id)
+	{
+		Slot* slot = SlotAt(IndexOf(id));
+		if (slot == nullptr)
+			return false;
+
+		// the generation bump is the removal: concurrent Finds with this id fail from here on
+		uint32 gen = GenOf(id);
+		uint32 next = (gen + 1) & GEN_MASK;
+		if (next == 0)
+			next = 1;
+		if (!slot->gen.compare_exchange_strong(gen, next, std::memory_order_acq_rel))
+			return false;
+
+		if (Mailbox* mb = slot->mailbox.exchange(nullptr, std::memory_order_acq_rel))
+			mb->Close();
+
+		m_live.fetch_sub(1, std::memory_order_relaxed);
+		m_retired.Push(IndexOf(id));
+		return true;
+	}
+
+	Sptr<Mailbox> MailboxRegistry::Detach(uint32 id)
+	{
+		Slot* slot = SlotAt(IndexOf(id));
+		if (slot == nullptr)
+			return nullptr;
+
+		uint32 gen = GenOf(id);
+		uint32 next = (gen + 1) & GEN_MASK;
+		if (next == 0)
+			next = 1;
+		if (!slot->gen.compare_exchange_strong(gen, next, std::memory_order_acq_rel))
+			return nullptr;
+
+		slot->mailbox.store(nullptr, std::memory_order_release);
+		Sptr<Mailbox> mb = std::move(slot->owner);
+
+		m_live.fetch_sub(1, std::memory_order_relaxed);
+		PushFree(IndexOf(id));
+		return mb;
+	}
+
+	void MailboxRegistry::Reclaim()
+	{
+		if (m_retired.IsEmpty() && m_draining.empty())
+			return;
+
+		uint32 index = 0;
+		while (m_retired.TryPop(index))
+			m_draining.push_back(index);
+
+		for (size_t i = 0; i < m_draining.size(); )
+		{
+			Slot& slot = *SlotAt(m_draining[i]);
+			if (slot.owner && !slot.owner->IsReclaimable())
+			{
+				++i;
+				continue;
+			}
+
+			slot.owner.reset();
+			PushFree(m_draining[i]);
+			m_draining[i] = m_draining.back();
+			m_draining.pop_back();
+		}
+	}
+
+	MailboxRegistry::Slot* MailboxRegistry::SlotAt(uint32 index) const
+	{
+		Chunk* chunk = m_chunks[index >> CHUNK_BITS].load(std::memory_order_acquire);
+		return chunk ? &chunk->slots[index & (CHUNK_SIZE - 1)] : nullptr;
+	}
+
+	MailboxRegistry::Slot& MailboxRegistry::EnsureSlot(uint32 index)
+	{
+		Atomic<Chunk*>& entry = m_chunks[index >> CHUNK_BITS];
+		Chunk* chunk = entry.load(std::memory_order_acquire);
+		if (chunk == nullptr)
+		{
+			// racing first users of a chunk: one wins, the others free theirs
+			Chunk* fresh = memory::xnew<Chunk>();
+			if (entry.compare_exchange_strong(chunk, fresh, std::memory_order_acq_rel))
+				chunk = fresh;
+			else
+				memory::xdelete(fresh);
+		}
+		return chunk->slots[index & (CHUNK_SIZE - 1)];
+	}
+
+	void MailboxRegistry::PushFree(uint32 index)
+	{
+		Slot& slot = *SlotAt(index);
+		uint64 head = m_freeHead.load(std::memory_order_relaxed);
+		uint64 next;
+		do
+		{
+			slot.nextFree.store(static_cast<uint32>(head), std::memory_order_relaxed);
+			next = ((head >> 32) + 1) << 32 | (index + 1);		// tag defeats ABA
+		} while (!m_freeHead.compare_exchange_weak(head, next, std::memory_order_release, std::memory_order_relaxed));
+	}
+
+	bool MailboxRegistry::PopFree(OUT uint32& index)
+	{
+		uint64 head = m_freeHead.load(std::memory_order_acquire);
+		while (static_cast<uint32>(head) != 0)
+		{
+			const uint32 top = static_cast<uint32>(head) - 1;
+			const uint32 link = SlotAt(top)->nextFree.load(std::memory_order_relaxed);
+			const uint64 next = ((head >> 32) + 1) << 32 | link;
+			if (m_freeHead.compare_exchange_weak(head, next, std::memory_order_acquire, std::memory_order_acquire))
+			{
+				index = top;
+				return true;
+			}
+		}
+		return false;
+	}
+}
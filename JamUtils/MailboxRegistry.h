@@ -0,0 +1,108 @@
+#pragma once
+#include "MpscQueue.h"
+
+namespace jam::utils::exec
+{
+	class Mailbox;
+
+	/*---------------------
+		MailboxRegistry
+	----------------------*/
+
+	// Generational slot array of a shard's mailboxes. id = slot index | generation << INDEX_BITS.
+	// Acquire/Remove run on any thread without a lock (free list = tagged Treiber stack), Find is
+	// wait-free. Remove makes the id stale at once and closes the mailbox; the slot (and the
+	// registry's reference) is recycled by the owning shard thread in Reclaim(), once the mailbox
+	// has drained and no ready list still points at it.
+	class MailboxRegistry
+	{
+		enum : uint32
+		{
+			INDEX_BITS	= 20,
+			GEN_BITS	= 32 - INDEX_BITS,
+			INDEX_MASK	= (1u << INDEX_BITS) - 1,
+			GEN_MASK	= (1u << GEN_BITS) - 1,
+			CHUNK_BITS	= 10,
+			CHUNK_SIZE	= 1u << CHUNK_BITS,
+			MAX_CHUNKS	= (1u << INDEX_BITS) / CHUNK_SIZE
+		};
+
+		struct Slot
+		{
+			Atomic<uint32>		gen = 1;				// generation of the live id (never 0)
+			Atomic<uint32>		nextFree = 0;			// free list link, index + 1
+			Atomic<Mailbox*>	mailbox = nullptr;		// null while reserved or removed
+			Sptr<Mailbox>		owner;					// Publish -> Reclaim
+		};
+
+		struct Chunk
+		{
+			std::array<Slot, CHUNK_SIZE>	slots;
+		};
+
+	public:
+		MailboxRegistry() = default;
+		~MailboxRegistry();
+
+		MailboxRegistry(const MailboxRegistry&) = delete;
+		MailboxRegistry& operator=(const MailboxRegistry&) = delete;
+
+		// any thread: reserve an id, construct the mailbox with it, then Publish
+		uint32				Acquire();
+		void				Publish(uint32 id, Sptr<Mailbox> mailbox);
+
+		// any thread. the pointer stays valid until the owner thread's next Reclaim()
+		Mailbox*			Find(uint32 id) const;
+
+		// any thread, idempotent. false if the id was already stale
+		bool				Remove(uint32 id);
+
+		// owner (shard) thread
+		void				Reclaim();
+
+		// owner thread: unregister without closing (hand-over to another shard). the slot is free at
+		// once; the mailbox keeps its own ready refs wherever it goes
+		Sptr<Mailbox>		Detach(uint32 id);
+
+		// owner thread: every published mailbox, fn(Mailbox*)
+		template<typename Fn>
+		void				ForEach(Fn&& fn) const;
+
+		uint32				GetLiveCount() const { return m_live.load(std::memory_order_relaxed); }
+
+		static uint32		IndexOf(uint32 id) { return id & INDEX_MASK; }
+		static uint32		GenOf(uint32 id) { return id >> INDEX_BITS; }
+
+	private:
+		Slot*				SlotAt(uint32 index) const;
+		Slot&				EnsureSlot(uint32 index);
+		void				PushFree(uint32 index);
+		bool				PopFree(OUT uint32& index);
+
+	private:
+		std::array<Atomic<Chunk*>, MAX_CHUNKS>		m_chunks{};
+		Atomic<uint32>								m_nextIndex = 0;		// never-used slots start here
+		Atomic<uint64>								m_freeHead = 0;			// tag << 32 | (index + 1), 0 = empty
+		Atomic<uint32>								m_live = 0;
+
+		thrd::MpscQueue<uint32>						m_retired;				// removed, awaiting Reclaim
+		std::vector<uint32>							m_draining;				// owner thread: retired, not drained yet
+	};
+
+	template<typename Fn>
+	void MailboxRegistry::ForEach(Fn&& fn) const
+	{
+		const uint32 end = (std::min)(m_nextIndex.load(std::memory_order_acquire), static_cast<uint32>(INDEX_MASK + 1));
+		for (uint32 index = 0; index < end; ++index)
+		{
+			const Slot* slot = SlotAt(index);
+			if (slot == nullptr)
+			{
+				index |= CHUNK_SIZE - 1;	// chunk not allocated yet
+				continue;
+			}
+			if (Mailbox* mb = slot->mailbox.load(std::memory_order_acquire))
+				fn(mb);
+		}
+	}
+}
@@ -0,0 +1,80 @@
+#include "pch.h"
+#include "MappedFile.h"
+
+
+namespace jam::utils::sys
+{
+	bool MappedFile::Create(const std::filesystem::path& path, uint64 size)
+	{
+		Close();
+		if (size == 0)
+			return false;
+
+		m_file = ::CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (m_file == INVALID_HANDLE_VALUE)
+			return false;
+
+		m_size = size;
+		return Map(PAGE_READWRITE, FILE_MAP_WRITE);
+	}
+
+	bool MappedFile::Open(const std::filesystem::path& path)
+	{
+		Close();
+
+		m_file = ::CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (m_file == INVALID_HANDLE_VALUE)
+			return false;
+
+		LARGE_INTEGER size = {};
+		if (!::GetFileSizeEx(m_file, &size) || size.QuadPart == 0)
+		{
+			Close();
+			return false;
+		}
+
+		m_size = static_cast<uint64>(size.QuadPart);
+		return Map(PAGE_READONLY, FILE_MAP_READ);
+	}
+
+	bool MappedFile::Map(DWORD protect, DWORD access)
+	{
+		// for PAGE_READWRITE the mapping size also extends the file
+		m_mapping = ::CreateFileMappingW(m_file, nullptr, protect, static_cast<DWORD>(m_size >> 32), static_cast<DWORD>(m_size), nullptr);
+		if (m_mapping == nullptr)
+		{
+			Close();
+			return false;
+		}
+
+		m_view = static_cast<uint8*>(::MapViewOfFile(m_mapping, access, 0, 0, 0));
+		if (m_view == nullptr)
+		{
+			Close();
+			return false;
+		}
+		return true;
+	}
+
+	bool MappedFile::Flush()
+	{
+		if (m_view == nullptr)
+			return false;
+		return ::FlushViewOfFile(m_view, 0) && ::FlushFileBuffers(m_file);
+	}
+
+	void MappedFile::Close()
+	{
+		if (m_view)
+			::UnmapViewOfFile(m_view);
+		if (m_mapping)
+			::CloseHandle(m_mapping);
+		if (m_file != INVALID_HANDLE_VALUE)
+			::CloseHandle(m_file);
+
+		m_view = nullptr;
+		m_mapping = nullptr;
+		m_file = INVALID_HANDLE_VALUE;
+		m_size = 0;
+	}
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include <filesystem>
+
+
+namespace jam::utils::sys
+{
+	/*----------------
+		MappedFile
+	-----------------*/
+
+	// Whole-file memory mapping (one view). Create() sizes a new file for writing, Open() maps an existing one read-only.
+	class MappedFile
+	{
+	public:
+		MappedFile() = default;
+		~MappedFile() { Close(); }
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		bool					Create(const std::filesystem::path& path, uint64 size);
+		bool					Open(const std::filesystem::path& path);
+		bool					Flush();		// view and file buffers down to disk
+		void					Close();
+
+		uint8*					Data() const { return m_view; }
+		uint64					Size() const { return m_size; }
+		bool					IsOpen() const { return m_view != nullptr; }
+
+	private:
+		bool					Map(DWORD protect, DWORD access);
+
+	private:
+		HANDLE					m_file = INVALID_HANDLE_VALUE;
+		HANDLE					m_mapping = nullptr;
+		uint8*					m_view = nullptr;
+		uint64					m_size = 0;
+	};
+}
@@ -1,55 +1,57 @@
 #include "pch.h"
 #include "MemoryManager.h"
 #include "MemoryPool.h"
+#include "ThreadCache.h"
 
 namespace jam::utils::memory
 {
 
-	void MemoryManager::Init()
+	void MemoryManager::Init(const MemoryConfig& config)
 	{
+		// the arena only on request: its regions are never handed back. pools hold it either way,
+		// so a later Init (ServiceConfig::memoryCfg) can still turn it on after startup
+		if (config.hugePages && !m_arena.IsEnabled())
+		{
+			m_arena.Init(true);
+			m_arena.Prefault(config.prefaultBytes);
+		}
+
+		// pools once: Init may run again at service start
+		if (!m_pools.empty())
+			return;
+
 		int32 size = 0;
 		int32 tableIndex = 0;
 
-		for (size = 32; size <= 1024; size += 32)
-		{
-			MemoryPool* pool = new MemoryPool(size);
-			m_pools.push_back(pool);
-
-			while (tableIndex <= size)
+		auto addPool = [&](int32 poolSize)
 			{
-				m_poolTable[tableIndex] = pool;
-				tableIndex++;
-			}
-		}
+				m_pools.push_back(new MemoryPool(poolSize, &m_arena));
 
-		for (; size <= 2048; size += 128)
-		{
-			MemoryPool* pool = new MemoryPool(size);
-			m_pools.push_back(pool);
+				const uint8 poolIndex = static_cast<uint8>(m_pools.size() - 1);
+				while (tableIndex <= poolSize)
+				{
+					m_poolIndexTable[tableIndex] = poolIndex;
+					tableIndex++;
+				}
+			};
 
-			while (tableIndex <= size)
-			{
-				m_poolTable[tableIndex] = pool;
-				tableIndex++;
-			}
-		}
+		for (size = 32; size <= 1024; size += 32)
+			addPool(size);
 
-		for (; size <= 4096; size += 256)
-		{
-			MemoryPool* pool = new MemoryPool(size);
-			m_pools.push_back(pool);
+		for (size = 1024 + 128; size <= 2048; size += 128)
+			addPool(size);
 
-			while (tableIndex <= size)
-			{
-				m_poolTable[tableIndex] = pool;
-				tableIndex++;
-			}
-		}
+		for (size = 2048 + 256; size <= 4096; size += 256)
+			addPool(size);
+
+		ASSERT_CRASH(m_pools.size() == POOL_COUNT && tableIndex == MAX_ALLOC_SIZE + 1);
 	}
 
 
 	void MemoryManager::Shutdown()
 	{
+		ThreadCache::ReleaseAll();
+
 		for (MemoryPool* pool : m_pools)
 			delete pool;
 
@@ -57,27 +59,30 @@ namespace jam::utils::memory
 	}
 
 
-	void* MemoryManager::Allocate(int32 size)
+	void* MemoryManager::Allocate(int32 size, eMemTag tag)
 	{
 		MemoryHeader* header = nullptr;
 		const int32 allocSize = size + sizeof(MemoryHeader);
+		ThreadCache* cache = ThreadCache::Current();
 
 #ifdef _STOMP
 		header = reinterpret_cast<MemoryHeader*>(StompAllocator::Alloc(allocSize));
 #else
 		if (allocSize > MAX_ALLOC_SIZE)
 		{
-			// ޸ Ǯ ִ ũ⸦  Ϲ Ҵ
-			header = reinterpret_cast<MemoryHeader*>(::_aligned_malloc(allocSize, SLIST_ALIGNMENT));
+			// 메모리 풀링 최대 크기를 벗어나면 일반 할당
+			header = reinterpret_cast<MemoryHeader*>(BaseAllocator::AlignedAlloc(allocSize, MEMORY_ALIGNMENT));
 		}
 		else
 		{
-			// ޸ Ǯ ´
-			header = m_poolTable[allocSize]->Pop();
+			// 메모리 풀에서 꺼내온다
+			const int32 poolIndex = m_poolIndexTable[allocSize];
+			header = cache ? cache->Alloc(poolIndex) : m_pools[poolIndex]->Pop();
 		}
 #endif	
 
-		return MemoryHeader::AttachHeader(header, allocSize);
+		Track(cache, allocSize, tag, +1);
+		return MemoryHeader::AttachHeader(header, allocSize, cache ? cache->GetId() : 0, tag);
 	}
 
 	void MemoryManager::Release(void* ptr)
@@ -87,20 +92,162 @@ namespace jam::utils::memory
 		const int32 allocSize = header->allocSize;
 		ASSERT_CRASH(allocSize > 0);
 
+		ThreadCache* cache = ThreadCache::Current();
+		Track(cache, allocSize, header->tag, -1);
+
 #ifdef _STOMP
 		StompAllocator::Release(header);
 #else
 		if (allocSize > MAX_ALLOC_SIZE)
 		{
-			// ޸ Ǯ ִ ũ⸦  Ϲ 
-			::_aligned_free(header);
+			// 메모리 풀링 최대 크기를 벗어나면 일반 해제
+			BaseAllocator::AlignedRelease(header);
 		}
 		else
 		{
-			// ޸ Ǯ ݳѴ
-			m_poolTable[allocSize]->Push(header);
+			// 메모리 풀에 반납한다
+			const int32 poolIndex = m_poolIndexTable[allocSize];
+			if (cache)
+				cache->Release(header, poolIndex);
+			else
+				m_pools[poolIndex]->Push(header);
 		}
 #endif	
 	}
 
+	MemoryPool* MemoryManager::GetPool(int32 poolIndex) const
+	{
+		if (poolIndex < 0 || poolIndex >= static_cast<int32>(m_pools.size()))
+			return nullptr;
+		return m_pools[poolIndex];
+	}
+
+	void MemoryManager::FreeBlock(MemoryHeader* header)
+	{
+		// arena regions stay mapped until process exit
+		if (m_arena.IsEnabled() && m_arena.Contains(header))
+			return;
+
+		BaseAllocator::AlignedRelease(header);
+	}
+
+	MemoryStats MemoryManager::GetStats() const
+	{
+		MemoryStats stats;
+		int64 classBytes[POOL_COUNT] = {};
+
+		auto accumulate = [&](const MemoryCounters& counters)
+			{
+				for (int32 i = 0; i < POOL_COUNT; i++)
+				{
+					stats.classes[i].liveBlocks += counters.classBlocks[i].load(std::memory_order_relaxed);
+					classBytes[i] += counters.classBytes[i].load(std::memory_order_relaxed);
+				}
+				for (int32 i = 0; i < MEM_TAG_COUNT; i++)
+				{
+					stats.tags[i].liveBlocks += counters.tagBlocks[i].load(std::memory_order_relaxed);
+					stats.tags[i].liveBytes += counters.tagBytes[i].load(std::memory_order_relaxed);
+				}
+			};
+
+		accumulate(m_sharedCounters);
+		ThreadCache::ForEach([&](const ThreadCache& cache) { accumulate(cache.GetCounters()); });
+
+		for (int32 i = 0; i < static_cast<int32>(m_pools.size()); i++)
+		{
+			const MemoryPool* pool = m_pools[i];
+			SizeClassStats& cls = stats.classes[i];
+
+			cls.blockSize = pool->GetAllocSize();
+			cls.reservedBlocks = pool->GetReserveCount();
+			cls.cachedBlocks = (std::max)(int64(0), pool->GetUseCount() - cls.liveBlocks);	// counters are sampled, not a snapshot
+			cls.peakBlocks = pool->GetPeakUseCount();
+			cls.wasteBytes = cls.liveBlocks * cls.blockSize - classBytes[i];
+		}
+
+		stats.bigLiveBlocks = m_bigLiveBlocks.load(std::memory_order_relaxed);
+		stats.bigLiveBytes = m_bigLiveBytes.load(std::memory_order_relaxed);
+		stats.bigPeakBytes = m_bigPeakBytes.load(std::memory_order_relaxed);
+		stats.bigTotalAllocs = m_bigTotalAllocs.load(std::memory_order_relaxed);
+
+		return stats;
+	}
+
+	void MemoryManager::DumpStats() const
+	{
+		const MemoryStats stats = GetStats();
+
+		int64 liveBytes = 0, cachedBytes = 0, reservedBytes = 0, wasteBytes = 0;
+
+		LOG_INFO("[Memory] {:>6} {:>10} {:>10} {:>10} {:>10} {:>12}", "size", "live", "cached", "reserved", "peak", "waste(B)");
+		for (const SizeClassStats& cls : stats.classes)
+		{
+			if (cls.peakBlocks == 0)
+				continue;
+
+			LOG_INFO("[Memory] {:>6} {:>10} {:>10} {:>10} {:>10} {:>12}",
+				cls.blockSize, cls.liveBlocks, cls.cachedBlocks, cls.reservedBlocks, cls.peakBlocks, cls.wasteBytes);
+
+			liveBytes += cls.liveBlocks * cls.blockSize;
+			cachedBytes += cls.cachedBlocks * cls.blockSize;
+			reservedBytes += cls.reservedBlocks * cls.blockSize;
+			wasteBytes += cls.wasteBytes;
+		}
+
+		LOG_INFO("[Memory] pooled  live {} B, cached {} B, reserved {} B, rounding waste {} B", liveBytes, cachedBytes, reservedBytes, wasteBytes);
+		LOG_INFO("[Memory] big     live {} ({} B), peak {} B, total allocs {}", stats.bigLiveBlocks, stats.bigLiveBytes, stats.bigPeakBytes, stats.bigTotalAllocs);
+		if (m_arena.IsEnabled())
+			LOG_INFO("[Memory] arena   mapped {} B, huge pages {} B", m_arena.GetMappedBytes(), m_arena.GetHugeBytes());
+
+		for (int32 i = 0; i < MEM_TAG_COUNT; i++)
+		{
+			const TagStats& tag = stats.tags[i];
+			if (tag.liveBlocks == 0)
+				continue;
+
+			LOG_INFO("[Memory] tag {:<12} live {} ({} B)", MemTagName(static_cast<eMemTag>(i)), tag.liveBlocks, tag.liveBytes);
+		}
+	}
+
+	void MemoryManager::Track(ThreadCache* cache, int32 allocSize, eMemTag tag, int64 sign)
+	{
+		// a cache's counters have a single writer; the shared set needs real RMW
+		const bool shared = (cache == nullptr);
+		MemoryCounters& counters = shared ? m_sharedCounters : cache->GetCounters();
+
+		auto add = [shared](Atomic<int64>& counter, int64 delta)
+			{
+				if (shared)
+					counter.fetch_add(delta, std::memory_order_relaxed);
+				else
+					MemoryCounters::Add(counter, delta);
+			};
+
+		if (allocSize <= MAX_ALLOC_SIZE)
+		{
+			const int32 poolIndex = m_poolIndexTable[allocSize];
+			add(counters.classBlocks[poolIndex], sign);
+			add(counters.classBytes[poolIndex], sign * allocSize);
+		}
+		else
+		{
+			m_bigLiveBlocks.fetch_add(sign, std::memory_order_relaxed);
+			const int64 bigBytes = m_bigLiveBytes.fetch_add(sign * allocSize, std::memory_order_relaxed) + sign * allocSize;
+
+			if (sign > 0)
+			{
+				m_bigTotalAllocs.fetch_add(1, std::memory_order_relaxed);
+
+				int64 peak = m_bigPeakBytes.load(std::memory_order_relaxed);
+				while (bigBytes > peak && !m_bigPeakBytes.compare_exchange_weak(peak, bigBytes, std::memory_order_relaxed))
+				{
+				}
+			}
+		}
+
+		const int32 tagIndex = E2U(tag);
+		add(counters.tagBlocks[tagIndex], sign);
+		add(counters.tagBytes[tagIndex], sign * allocSize);
+	}
+
 }
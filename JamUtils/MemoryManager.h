@@ -1,13 +1,20 @@
 #pragma once
 #include "Allocator.h"
+#include "MemoryStats.h"
+#include "HugePageArena.h"
 
 
 namespace jam::utils::memory
 {
 	class MemoryPool;
+	class ThreadCache;
+	struct MemoryHeader;
 
-	inline constexpr int32 POOL_COUNT = (1024 / 32) + (1024 / 128) + (2048 / 256);
-	inline constexpr int32 MAX_ALLOC_SIZE = 4096;
+	struct MemoryConfig
+	{
+		bool	hugePages = false;		// carve size classes out of 2 MB pages (falls back to 4 KB)
+		int64	prefaultBytes = 0;		// with hugePages: map + touch this much at Init (first-use page faults off the hot path)
+	};
 
 
 	class MemoryManager
@@ -15,23 +22,40 @@ namespace jam::utils::memory
 		DECLARE_SINGLETON(MemoryManager)
 
 	public:
-		void	Init();
+		void	Init(const MemoryConfig& config = {});
 		void	Shutdown();
 
-		void*	Allocate(int32 size);
+		void*	Allocate(int32 size, eMemTag tag = eMemTag::NONE);
 		void	Release(void* ptr);
 
+		MemoryPool*	GetPool(int32 poolIndex) const;		// nullptr after Shutdown
+		void		FreeBlock(MemoryHeader* header);		// pooled block whose pool is gone
+
+		// telemetry
+		MemoryStats	GetStats() const;
+		void		DumpStats() const;
+
+	private:
+		void	Track(ThreadCache* cache, int32 allocSize, eMemTag tag, int64 sign);
+
 	private:
 		std::vector<MemoryPool*>		m_pools;
-		MemoryPool*						m_poolTable[MAX_ALLOC_SIZE + 1];
+		uint8							m_poolIndexTable[MAX_ALLOC_SIZE + 1];
+		HugePageArena					m_arena;
+
+		MemoryCounters					m_sharedCounters;		// threads without a cache (exiting)
+		Atomic<int64>					m_bigLiveBlocks = 0;
+		Atomic<int64>					m_bigLiveBytes = 0;
+		Atomic<int64>					m_bigPeakBytes = 0;
+		Atomic<int64>					m_bigTotalAllocs = 0;
 	};
 
 
 
-	template<typename Type, typename... Args>
+	template<typename Type, eMemTag Tag = eMemTag::NONE, typename... Args>
 	Type* xnew(Args&&... args)
 	{
-		Type* memory = static_cast<Type*>(PoolAllocator::Alloc(sizeof(Type)));
+		Type* memory = static_cast<Type*>(PoolAllocator::Alloc(sizeof(Type), Tag));
 		new(memory)Type(std::forward<Args>(args)...); // placement new
 		return memory;
 	}
@@ -43,10 +67,10 @@ namespace jam::utils::memory
 		PoolAllocator::Release(obj);
 	}
 
-	template<typename Type, typename... Args>
+	// object + control block in one pool block (allocate_shared), no custom deleter
+	template<typename Type, eMemTag Tag = eMemTag::NONE, typename... Args>
 	std::shared_ptr<Type> MakeShared(Args&&... args)
 	{
-		return std::shared_ptr<Type>{ xnew<Type>(std::forward<Args>(args)...), xdelete<Type> };
+		return std::allocate_shared<Type>(StlAllocator<Type, Tag>(), std::forward<Args>(args)...);
 	}
 }
-
@@ -1,46 +1,106 @@
 #include "pch.h"
 #include "MemoryPool.h"
+#include "HugePageArena.h"
 
 
 namespace jam::utils::memory
 {
-	MemoryPool::MemoryPool(int32 allocSize) : m_allocSize(allocSize)
+	MemoryPool::MemoryPool(int32 allocSize, HugePageArena* arena) : m_arena(arena), m_allocSize(allocSize)
 	{
-		::InitializeSListHead(&m_header);
 	}
 
 	MemoryPool::~MemoryPool()
 	{
-		while (MemoryHeader* memory = static_cast<MemoryHeader*>(::InterlockedPopEntrySList(&m_header)))
-			::_aligned_free(memory);
+		MemoryHeader* chain = m_depot.PopAll();
+		while (chain)
+		{
+			MemoryHeader* nextChain = chain->batchNext;
+			while (chain)
+			{
+				MemoryHeader* memory = chain;
+				chain = chain->next;
+				if (m_arena == nullptr || m_arena->Contains(memory) == false)
+					BaseAllocator::AlignedRelease(memory);
+			}
+			chain = nextChain;
+		}
 	}
 
 	void MemoryPool::Push(MemoryHeader* ptr)
 	{
 		ptr->allocSize = 0;
-
-		::InterlockedPushEntrySList(&m_header, static_cast<PSLIST_ENTRY>(ptr));
-
-		m_useCount.fetch_sub(1);
-		m_reserveCount.fetch_add(1);
+		PushBatch(ptr, ptr, 1);
 	}
 
 	MemoryHeader* MemoryPool::Pop()
 	{
-		MemoryHeader* memory = static_cast<MemoryHeader*>(::InterlockedPopEntrySList(&m_header));
+		int32 count = 0;
+		MemoryHeader* memory = PopBatch(OUT count);
 
 		if (memory == nullptr)
 		{
-			memory = reinterpret_cast<MemoryHeader*>(::_aligned_malloc(m_allocSize, SLIST_ALIGNMENT));
+			memory = AllocBlock();
+			AddUseCount(1);
 		}
 		else
 		{
 			ASSERT_CRASH(memory->allocSize == 0);
-			m_reserveCount.fetch_sub(1);
-		}
 
-		m_useCount.fetch_add(1);
+			// hand the rest of the chain back to the depot
+			if (MemoryHeader* rest = memory->next)
+			{
+				memory->next = nullptr;
+				rest->batchCount = static_cast<uint16>(count - 1);
+				m_depot.Push(rest);
+				m_reserveCount.fetch_add(count - 1);
+				m_useCount.fetch_sub(count - 1);
+			}
+		}
 
 		return memory;
 	}
+
+	void MemoryPool::PushBatch(MemoryHeader* first, MemoryHeader* last, int32 count)
+	{
+		last->next = nullptr;
+		first->batchCount = static_cast<uint16>(count);
+		m_depot.Push(first);
+
+		m_useCount.fetch_sub(count);
+		m_reserveCount.fetch_add(count);
+	}
+
+	MemoryHeader* MemoryPool::PopBatch(OUT int32& count)
+	{
+		count = 0;
+
+		MemoryHeader* chain = m_depot.Pop();
+		if (chain == nullptr)
+			return nullptr;
+
+		count = chain->batchCount;
+		m_reserveCount.fetch_sub(count);
+		AddUseCount(count);
+
+		return chain;
+	}
+
+	MemoryHeader* MemoryPool::AllocBlock()
+	{
+		void* memory = m_arena ? m_arena->Alloc(m_allocSize, MEMORY_ALIGNMENT) : nullptr;
+		if (memory == nullptr)
+			memory = BaseAllocator::AlignedAlloc(m_allocSize, MEMORY_ALIGNMENT);
+
+		return new(memory)MemoryHeader(0);
+	}
+
+	void MemoryPool::AddUseCount(int32 delta)
+	{
+		const int32 useCount = m_useCount.fetch_add(delta) + delta;
+
+		int32 peak = m_peakUseCount.load(std::memory_order_relaxed);
+		while (useCount > peak && !m_peakUseCount.compare_exchange_weak(peak, useCount, std::memory_order_relaxed))
+		{
+		}
+	}
 }
@@ -1,4 +1,6 @@
 #pragma once
+#include "LockFreeStack.h"
+#include "MemoryStats.h"
 
 namespace jam::utils::memory
 {
@@ -6,17 +8,16 @@ namespace jam::utils::memory
 		MemoryHeader
 	------------------*/
 
-	inline constexpr int32 SLIST_ALIGNMENT = 16;
+	inline constexpr int32 MEMORY_ALIGNMENT = 16;
 
-	DECLSPEC_ALIGN(SLIST_ALIGNMENT)
-	struct MemoryHeader : public SLIST_ENTRY
+	struct alignas(MEMORY_ALIGNMENT) MemoryHeader
 	{
 		// [MemoryHeader][Data]
-		MemoryHeader(int32 size) : allocSize(size) {}
+		MemoryHeader(int32 size, uint16 owner = 0, eMemTag memTag = eMemTag::NONE) : allocSize(size), ownerId(owner), tag(memTag) {}
 
-		static void* AttachHeader(MemoryHeader* header, int32 size)
+		static void* AttachHeader(MemoryHeader* header, int32 size, uint16 owner = 0, eMemTag tag = eMemTag::NONE)
 		{
-			new(header)MemoryHeader(size); // placement new
+			new(header)MemoryHeader(size, owner, tag); // placement new
 			return reinterpret_cast<void*>(++header);
 		}
 
@@ -26,7 +27,12 @@ namespace jam::utils::memory
 			return header;
 		}
 
-		int32 allocSize;
+		MemoryHeader*	next = nullptr;			// magazine / remote-free / batch chain
+		MemoryHeader*	batchNext = nullptr;	// pool depot (stack of chains)
+		int32			allocSize;
+		uint16			ownerId = 0;			// ThreadCache id (0 = none)
+		uint16			batchCount = 0;			// chain length, valid on chain head only
+		eMemTag			tag = eMemTag::NONE;
 	};
 
 
@@ -35,22 +41,38 @@ namespace jam::utils::memory
 		MemoryPool
 	------------------*/
 
+	class HugePageArena;
 
-	DECLSPEC_ALIGN(SLIST_ALIGNMENT)
-	class MemoryPool
+	class alignas(MEMORY_ALIGNMENT) MemoryPool
 	{
+		using Depot = LockFreeStack<MemoryHeader, &MemoryHeader::batchNext>;
+
 	public:
-		MemoryPool(int32 allocSize);
+		MemoryPool(int32 allocSize, HugePageArena* arena = nullptr);
 		~MemoryPool();
 
 		void					Push(MemoryHeader* ptr);
 		MemoryHeader*			Pop();
 
+		// ThreadCache refill/drain unit: chain linked through MemoryHeader::next
+		void					PushBatch(MemoryHeader* first, MemoryHeader* last, int32 count);
+		MemoryHeader*			PopBatch(OUT int32& count);
+
+		int32					GetAllocSize() const { return m_allocSize; }
+		int32					GetUseCount() const { return m_useCount.load(std::memory_order_relaxed); }
+		int32					GetReserveCount() const { return m_reserveCount.load(std::memory_order_relaxed); }
+		int32					GetPeakUseCount() const { return m_peakUseCount.load(std::memory_order_relaxed); }
+
 	private:
-		SLIST_HEADER			m_header;
+		MemoryHeader*			AllocBlock();
+		void					AddUseCount(int32 delta);
+
+	private:
+		Depot					m_depot;
+		HugePageArena*			m_arena = nullptr;		// blocks carved from here are never freed one by one
 		int32					m_allocSize = 0;
 		Atomic<int32>			m_useCount = 0;
 		Atomic<int32>			m_reserveCount = 0;
+		Atomic<int32>			m_peakUseCount = 0;
 	};
 }
-
@@ -0,0 +1,93 @@
+#pragma once
+
+namespace jam::utils::memory
+{
+	inline constexpr int32 POOL_COUNT = (1024 / 32) + (1024 / 128) + (2048 / 256);
+	inline constexpr int32 MAX_ALLOC_SIZE = 4096;
+
+	// subsystem tag carried in MemoryHeader (xnew<T, eMemTag::JOB>(...))
+	enum class eMemTag : uint8
+	{
+		NONE,
+		NET_SEND_BUFFER,
+		ECS_STORE,
+		JOB,
+		FIBER,				// scheduler fiber records; stacks are OS memory, not counted
+		COUNT
+	};
+
+	inline constexpr int32 MEM_TAG_COUNT = static_cast<int32>(eMemTag::COUNT);
+
+	inline const char* MemTagName(eMemTag tag)
+	{
+		switch (tag)
+		{
+		case eMemTag::NONE:				return "none";
+		case eMemTag::NET_SEND_BUFFER:	return "net.sendbuf";
+		case eMemTag::ECS_STORE:		return "ecs.store";
+		case eMemTag::JOB:				return "job";
+		case eMemTag::FIBER:			return "fiber";
+		default:						return "?";
+		}
+	}
+
+	/*-------------------
+		MemoryCounters
+	-------------------*/
+
+	// Live-allocation counters. Each ThreadCache owns one set and is its only writer,
+	// so updates are a relaxed load + store (no lock prefix); readers sum every set.
+	// Frees may land on a different set than the matching alloc, so a single set can go negative.
+	struct MemoryCounters
+	{
+		Atomic<int64>	classBlocks[POOL_COUNT] = {};
+		Atomic<int64>	classBytes[POOL_COUNT] = {};		// requested bytes incl. header
+		Atomic<int64>	tagBlocks[MEM_TAG_COUNT] = {};
+		Atomic<int64>	tagBytes[MEM_TAG_COUNT] = {};
+
+		static void Add(Atomic<int64>& counter, int64 delta)
+		{
+			counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+		}
+	};
+
+	/*-------------------
+		MemoryStats
+	-------------------*/
+
+	struct SizeClassStats
+	{
+		int32	blockSize = 0;
+		int64	liveBlocks = 0;			// handed out to callers
+		int64	cachedBlocks = 0;		// parked in thread caches
+		int64	reservedBlocks = 0;		// in the pool depot
+		int64	peakBlocks = 0;			// high-water mark of live + cached
+		int64	wasteBytes = 0;			// live * blockSize - requested
+	};
+
+	struct TagStats
+	{
+		int64	liveBlocks = 0;
+		int64	liveBytes = 0;
+	};
+
+	struct MemoryStats
+	{
+		SizeClassStats	classes[POOL_COUNT];
+		TagStats		tags[MEM_TAG_COUNT];
+
+		int64			bigLiveBlocks = 0;		// allocations > MAX_ALLOC_SIZE
+		int64			bigLiveBytes = 0;
+		int64			bigPeakBytes = 0;
+		int64			bigTotalAllocs = 0;
+
+		// handed out right now: pooled blocks at their class size plus big allocations
+		int64			LiveBytes() const
+		{
+			int64 bytes = bigLiveBytes;
+			for (const SizeClassStats& cls : classes)
+				bytes += cls.liveBlocks * cls.blockSize;
+			return bytes;
+		}
+	};
+}
@@ -0,0 +1,134 @@
+#pragma once
+#include "ObjectPool.h"
+
+namespace jam::utils::thrd
+{
+	/*---------------
+		MpscQueue
+	----------------*/
+
+	// Vyukov intrusive MPSC queue: any thread pushes with a single atomic exchange, exactly one
+	// consumer pops. Nodes come from ObjectPool, so an empty queue is three pointers (plus padding
+	// between the producer and consumer ends) instead of a block-based queue with its tokens.
+	// A pop can miss an element whose producer is between its exchange and its link; callers keep
+	// their own count and simply look again.
+	template<typename T>
+	class MpscQueue
+	{
+		struct NodeBase
+		{
+			Atomic<NodeBase*>	next = nullptr;
+		};
+
+		struct Node : NodeBase
+		{
+			T					value;
+
+			template<typename... Args>
+			explicit Node(Args&&... args) : value(std::forward<Args>(args)...) {}
+		};
+
+		using NodePool = memory::ObjectPool<Node>;
+
+	public:
+		MpscQueue() : m_tail(&m_stub), m_head(&m_stub) {}
+		~MpscQueue()
+		{
+			T discard;
+			while (TryPop(discard)) {}
+		}
+
+		MpscQueue(const MpscQueue&) = delete;
+		MpscQueue& operator=(const MpscQueue&) = delete;
+
+		// any thread
+		template<typename... Args>
+		void Push(Args&&... args)
+		{
+			Link(NodePool::Pop(std::forward<Args>(args)...));
+		}
+
+		// consumer only
+		bool TryPop(OUT T& out)
+		{
+			Node* node = PopNode();
+			if (node == nullptr)
+				return false;
+
+			out = std::move(node->value);
+			NodePool::Push(node);
+			return true;
+		}
+
+		template<typename OutputIt>
+		uint64 TryPopBulk(OUT OutputIt out, uint64 count)
+		{
+			uint64 n = 0;
+			for (; n < count; ++n)
+			{
+				Node* node = PopNode();
+				if (node == nullptr)
+					break;
+
+				*out++ = std::move(node->value);
+				NodePool::Push(node);
+			}
+			return n;
+		}
+
+		// consumer side, O(1). a push that has not linked yet reads as empty
+		bool IsEmpty() const
+		{
+			return m_head == &m_stub && m_stub.next.load(std::memory_order_acquire) == nullptr;
+		}
+
+	private:
+		void Link(NodeBase* node)
+		{
+			node->next.store(nullptr, std::memory_order_relaxed);
+			NodeBase* prev = m_tail.exchange(node, std::memory_order_acq_rel);
+			prev->next.store(node, std::memory_order_release);
+		}
+
+		Node* PopNode()
+		{
+			NodeBase* head = m_head;
+			NodeBase* next = head->next.load(std::memory_order_acquire);
+
+			// skip the stub
+			if (head == &m_stub)
+			{
+				if (next == nullptr)
+					return nullptr;
+				m_head = next;
+				head = next;
+				next = next->next.load(std::memory_order_acquire);
+			}
+
+			if (next != nullptr)
+			{
+				m_head = next;
+				return static_cast<Node*>(head);
+			}
+
+			// head is the last linked node: a producer is mid-push, or the queue holds just head
+			if (head != m_tail.load(std::memory_order_acquire))
+				return nullptr;
+
+			// re-insert the stub behind head so head can be handed out
+			Link(&m_stub);
+			next = head->next.load(std::memory_order_acquire);
+			if (next != nullptr)
+			{
+				m_head = next;
+				return static_cast<Node*>(head);
+			}
+			return nullptr;
+		}
+
+	private:
+		alignas(64) Atomic<NodeBase*>	m_tail;		// producers
+		alignas(64) NodeBase*			m_head;		// consumer
+		NodeBase						m_stub;
+	};
+}
@@ -11,12 +11,7 @@ namespace jam::utils::memory
 		template<typename... Args>
 		static Type* Pop(Args&&... args)
 		{
-#ifdef _STOMP
-			MemoryHeader* ptr = reinterpret_cast<MemoryHeader*>(StompAllocator::Alloc(s_allocSize));
-			Type* memory = static_cast<Type*>(MemoryHeader::AttachHeader(ptr, s_allocSize));
-#else
-			Type* memory = static_cast<Type*>(MemoryHeader::AttachHeader(s_pool.Pop(), s_allocSize));
-#endif		
+			Type* memory = static_cast<Type*>(Alloc());
 			new(memory)Type(forward<Args>(args)...); // placement new
 			return memory;
 		}
@@ -24,18 +19,31 @@ namespace jam::utils::memory
 		static void Push(Type* obj)
 		{
 			obj->~Type();
+			Free(obj);
+		}
+
+		// object + control block in one block of this type's pool (see ObjectPoolAllocator)
+		template<typename... Args>
+		static std::shared_ptr<Type> MakeShared(Args&&... args);
+
+		// raw storage for one Type, no construction
+		static void* Alloc()
+		{
 #ifdef _STOMP
-			StompAllocator::Release(MemoryHeader::DetachHeader(obj));
+			MemoryHeader* ptr = reinterpret_cast<MemoryHeader*>(StompAllocator::Alloc(s_allocSize));
+			return MemoryHeader::AttachHeader(ptr, s_allocSize);
 #else
-			s_pool.Push(MemoryHeader::DetachHeader(obj));
+			return MemoryHeader::AttachHeader(s_pool.Pop(), s_allocSize);
 #endif
 		}
 
-		template<typename... Args>
-		static std::shared_ptr<Type> MakeShared(Args&&... args)
+		static void Free(void* ptr)
 		{
-			std::shared_ptr<Type> ptr = { Pop(std::forward<Args>(args)...), Push };
-			return ptr;
+#ifdef _STOMP
+			StompAllocator::Release(MemoryHeader::DetachHeader(ptr));
+#else
+			s_pool.Push(MemoryHeader::DetachHeader(ptr));
+#endif
 		}
 
 	private:
@@ -48,4 +56,44 @@ namespace jam::utils::memory
 
 	template<typename Type>
 	MemoryPool ObjectPool<Type>::s_pool{ s_allocSize };
+
+
+	/*-------------------------
+		ObjectPoolAllocator
+	--------------------------*/
+
+	// allocate_shared rebinds this to its control block type, which then gets a
+	// fixed-size ObjectPool of its own: one Pop per MakeShared, no global heap.
+	template<typename T>
+	class ObjectPoolAllocator
+	{
+	public:
+		using value_type = T;
+
+		ObjectPoolAllocator() = default;
+
+		template<typename Other>
+		ObjectPoolAllocator(const ObjectPoolAllocator<Other>&) {}
+
+		T* allocate(size_t count)
+		{
+			ASSERT_CRASH(count == 1);
+			return static_cast<T*>(ObjectPool<T>::Alloc());
+		}
+
+		void deallocate(T* ptr, size_t count)
+		{
+			ObjectPool<T>::Free(ptr);
+		}
+
+		template<typename Other>
+		bool operator==(const ObjectPoolAllocator<Other>&) const { return true; }
+	};
+
+	template<typename Type>
+	template<typename... Args>
+	std::shared_ptr<Type> ObjectPool<Type>::MakeShared(Args&&... args)
+	{
+		return std::allocate_shared<Type>(ObjectPoolAllocator<Type>(), std::forward<Args>(args)...);
+	}
 }
@@ -0,0 +1,108 @@
+#pragma once
+#include "ObjectPool.h"
+
+namespace jam::utils::memory
+{
+	enum class eRefCountPolicy : uint8
+	{
+		SHARED,				// atomic count, may cross threads
+		SINGLE_THREAD		// plain count, object never leaves its owner thread/shard
+	};
+
+	/*----------------
+		RefCounted
+	-----------------*/
+
+	// Intrusive count for the hottest per-packet types: no separate control block,
+	// and with SINGLE_THREAD no lock-prefixed instructions at all.
+	// Objects are created with MakeRef and go back to ObjectPool<Derived> at zero.
+	template<typename Derived, eRefCountPolicy Policy = eRefCountPolicy::SHARED>
+	class RefCounted
+	{
+		using Counter = std::conditional_t<Policy == eRefCountPolicy::SHARED, Atomic<int32>, int32>;
+
+	public:
+		void AddRef()
+		{
+			if constexpr (Policy == eRefCountPolicy::SHARED)
+				m_refCount.fetch_add(1, std::memory_order_relaxed);
+			else
+				++m_refCount;
+		}
+
+		void ReleaseRef()
+		{
+			if constexpr (Policy == eRefCountPolicy::SHARED)
+			{
+				if (m_refCount.fetch_sub(1, std::memory_order_acq_rel) != 1)
+					return;
+			}
+			else
+			{
+				if (--m_refCount != 0)
+					return;
+			}
+
+			ObjectPool<Derived>::Push(static_cast<Derived*>(this));
+		}
+
+		int32		GetRefCount() const { return m_refCount; }
+
+	protected:
+		RefCounted() = default;
+		RefCounted(const RefCounted&) {}					// a copy is a new object: count starts at 0
+		RefCounted& operator=(const RefCounted&) { return *this; }
+		~RefCounted() = default;
+
+	private:
+		Counter		m_refCount{ 0 };
+	};
+
+	/*-------------
+		RefPtr
+	--------------*/
+
+	template<typename T>
+	class RefPtr
+	{
+	public:
+		RefPtr() = default;
+		RefPtr(std::nullptr_t) {}
+		explicit RefPtr(T* ptr) : m_ptr(ptr) { if (m_ptr) m_ptr->AddRef(); }
+
+		RefPtr(const RefPtr& other) : RefPtr(other.m_ptr) {}
+		RefPtr(RefPtr&& other) noexcept : m_ptr(std::exchange(other.m_ptr, nullptr)) {}
+		~RefPtr() { if (m_ptr) m_ptr->ReleaseRef(); }
+
+		RefPtr& operator=(const RefPtr& other)
+		{
+			RefPtr(other).Swap(*this);
+			return *this;
+		}
+
+		RefPtr& operator=(RefPtr&& other) noexcept
+		{
+			RefPtr(std::move(other)).Swap(*this);
+			return *this;
+		}
+
+		T*			operator->() const { return m_ptr; }
+		T&			operator*() const { return *m_ptr; }
+		T*			Get() const { return m_ptr; }
+		explicit	operator bool() const { return m_ptr != nullptr; }
+
+		bool		operator==(const RefPtr& other) const { return m_ptr == other.m_ptr; }
+
+		void		Reset() { RefPtr().Swap(*this); }
+		void		Swap(RefPtr& other) noexcept { std::swap(m_ptr, other.m_ptr); }
+
+	private:
+		T*			m_ptr = nullptr;
+	};
+
+	template<typename Type, typename... Args>
+	RefPtr<Type> MakeRef(Args&&... args)
+	{
+		return RefPtr<Type>(ObjectPool<Type>::Pop(std::forward<Args>(args)...));
+	}
+}
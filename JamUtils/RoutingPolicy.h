@@ -17,6 +17,21 @@ namespace jam::utils::exec
 		x ^= x >> 33; return x;
 	}
 
+	// Lamping & Veach jump consistent hash: buckets n -> n+1 moves only the keys that land in the new
+	// bucket, n -> n-1 only those of the last one. key should already be mixed.
+	inline uint32 JumpHash(uint64 key, uint32 buckets)
+	{
+		int64 b = -1;
+		int64 j = 0;
+		while (j < static_cast<int64>(buckets))
+		{
+			b = j;
+			key = key * 2862933555777941757ULL + 1;
+			j = static_cast<int64>(static_cast<double>(b + 1) * (static_cast<double>(1ll << 31) / static_cast<double>((key >> 33) + 1)));
+		}
+		return static_cast<uint32>(b);
+	}
+
 	// based on current time
 	// todo
 	inline RouteSeed RandomSeed()
@@ -46,10 +61,10 @@ namespace jam::utils::exec
 	public:
 		explicit RoutingPolicy(RouteSeed s) : m_seed(s) {}
 
-		// PerSession ⺻
+		// PerSession 기본
 		RouteKey KeyForSession(uint64 session_id) const { return RouteKey(Mix64(session_id ^ m_seed.k0)); }
 
-		// ׷켺 ۾ ̵忡 
+		// 그룹성 작업 오버라이드에 사용
 		GroupHomeKey KeyForGroup(uint64 group_id) const { return GroupHomeKey(Mix64(group_id ^ m_seed.k1)); }
 
 	private:
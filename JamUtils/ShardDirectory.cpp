@@ -7,6 +7,7 @@ namespace jam::utils::exec
 	ShardDirectory::ShardDirectory(const ShardDirectoryConfig& cfg, std::weak_ptr<GlobalExecutor> owner)
 		: m_config(cfg), m_owner(std::move(owner))
 	{
+		Publish(std::make_unique<ShardTable>());
 	}
 
 	ShardDirectory::~ShardDirectory()
@@ -16,27 +17,34 @@ namespace jam::utils::exec
 
 	void ShardDirectory::Init(const std::vector<Sptr<ShardExecutor>>& shards)
 	{
+		auto table = std::make_unique<ShardTable>();
+
 		if (m_config.ownership == eShardOwnership::OWN)
 		{
-			m_shards.reserve(m_config.numShards);
+			table->shards.reserve(m_config.numShards);
 			for (uint32 i = 0; i < m_config.numShards; ++i)
 			{
 				ShardExecutorConfig c = m_config.shardCfg;
 				c.index = static_cast<int32>(i);
 
 				auto shard = std::make_shared<ShardExecutor>(c, m_owner);
-				m_shards.emplace_back(std::move(shard));
+				table->shards.emplace_back(std::move(shard));
 			}
 		}
 		else if (m_config.ownership == eShardOwnership::ADOPT)
 		{
-			m_shards = shards;
+			table->shards = shards;
 		}
+
+		LockGuard guard(m_writeLock);
+		for (uint64 i = 0; i < table->Size(); ++i)
+			table->slots.push_back(SlotFor(i));
+		Publish(std::move(table));
 	}
 
 	void ShardDirectory::Start()
 	{
-		for (auto& s : m_shards)
+		for (auto& s : Table().shards)
 			if (s) s->Start();
 
 
@@ -45,69 +53,119 @@ namespace jam::utils::exec
 
 	void ShardDirectory::StopAll()
 	{
-		for (auto& s : m_shards)
+		const ShardTable& table = Table();
+		for (auto& s : table.shards)
 			if (s) s->BeginDrain();
-		for (auto& s : m_shards)
+		for (auto& s : table.shards)
 			if (s) s->Stop();
 	}
 
 	void ShardDirectory::JoinAll()
 	{
-		for (auto& s : m_shards)
+		for (auto& s : Table().shards)
 			if (s) s->Join();
 	}
 
 	void ShardDirectory::AttachSlots()
 	{
-		const uint64 n = static_cast<uint64>(m_shards.size());
-		m_slots.resize(n);
-
-		for (uint64 i = 0; i < n; ++i)
+		const ShardTable& table = Table();
+		for (uint64 i = 0; i < table.Size(); ++i)
 		{
-			m_slots[i].shardId = static_cast<uint32>(i);
-			if (m_shards[i])
-				m_shards[i]->AttachSlot(&m_slots[i]);
+			if (table.shards[i])
+				table.shards[i]->AttachSlot(table.slots[i]);
 		}
 	}
 
 	uint64 ShardDirectory::Size() const
 	{
-		return static_cast<uint64>(m_shards.size());
+		return Table().Size();
 	}
 
 	uint64 ShardDirectory::PickShard(uint64 key) const
 	{
-		const uint64 n = Size();
-		if (n == 0) return 0;
-		return Mix64(key) % n;		// return shard index
+		return Table().Pick(key);		// return shard index
 	}
 
 	Sptr<ShardExecutor> ShardDirectory::ShardAt(uint64 i) const
 	{
-		if (i >= Size()) return {};
-		return m_shards[i];
+		return Table().At(i);
+	}
+
+	Sptr<ShardExecutor> ShardDirectory::CreateShard() const
+	{
+		ShardExecutorConfig c = m_config.shardCfg;
+		c.index = static_cast<int32>(Size());
+		return std::make_shared<ShardExecutor>(c, m_owner);
+	}
+
+	void ShardDirectory::AppendShard(Sptr<ShardExecutor> shard)
+	{
+		LockGuard guard(m_writeLock);
+
+		auto table = std::make_unique<ShardTable>(Table());
+		ASSERT_CRASH(shard->GetIndex() == static_cast<int32>(table->Size()));
+
+		ShardSlot* slot = SlotFor(table->Size());
+		shard->AttachSlot(slot);
+
+		table->shards.push_back(std::move(shard));
+		table->slots.push_back(slot);
+		Publish(std::move(table));
+	}
+
+	Sptr<ShardExecutor> ShardDirectory::DetachLastShard()
+	{
+		LockGuard guard(m_writeLock);
+
+		auto table = std::make_unique<ShardTable>(Table());
+		if (table->shards.empty())
+			return nullptr;
+
+		Sptr<ShardExecutor> last = std::move(table->shards.back());
+		table->shards.pop_back();
+		table->slots.pop_back();
+		Publish(std::move(table));
+
+		// endpoints still holding the slot see DRAINING and re-resolve through the new table
+		if (last)
+			last->BeginDrain();
+		return last;
+	}
+
+	ShardSlot* ShardDirectory::SlotFor(uint64 index)
+	{
+		while (m_slots.size() <= index)
+		{
+			m_slots.emplace_back();
+			m_slots.back().shardId = static_cast<uint32>(m_slots.size() - 1);
+		}
+		return &m_slots[index];
+	}
+
+	void ShardDirectory::Publish(Uptr<ShardTable> table)
+	{
+		m_table.store(table.get(), std::memory_order_release);
+		m_tables.push_back(std::move(table));
 	}
 
 	ShardEndpoint ShardDirectory::EndpointFor(uint64 key) const
 	{
-		const uint64 idx = PickShard(key);
-		auto s = ShardAt(idx);
-		return {std::move(s)};
+		const ShardTable& table = Table();
+		return { table.At(table.Pick(key)) };
 	}
 
 	ShardEndpoint ShardDirectory::EndpointFor(uint64 key, eMailboxChannel channel) const
 	{
-		const uint64 n = Size();
-		if (n == 0)
+		const ShardTable& table = Table();
+		if (table.Size() == 0)
 			return { Sptr<ShardExecutor>{} };
 
-		const uint64 idx = PickShard(key);
+		const uint64 idx = table.Pick(key);
 
-		if (idx < static_cast<uint64>(m_slots.size()))
-			return { const_cast<ShardSlot*>(&m_slots[idx]), channel };
+		if (idx < static_cast<uint64>(table.slots.size()))
+			return { table.slots[idx], channel };
 
-		auto s = ShardAt(idx);
-		return {std::move(s)};
+		return { table.At(idx) };
 	}
 
 
@@ -15,8 +15,21 @@ namespace jam::utils::exec
 	struct ShardDirectoryConfig
 	{
 		eShardOwnership			ownership = eShardOwnership::OWN;
-		uint32					numShards = 0;          // Own 忡 
-		ShardExecutorConfig		shardCfg;             //   (Own )
+		uint32					numShards = 0;          // Own 모드에서만 사용
+		ShardExecutorConfig		shardCfg;             // 공통 설정 (Own 모드)
+	};
+
+
+	// One published shard layout. Immutable once published: AddShard/RemoveShard build a new table and
+	// swap the pointer, so readers (routing, endpoints) never lock.
+	struct ShardTable
+	{
+		std::vector<Sptr<ShardExecutor>>	shards;
+		std::vector<ShardSlot*>				slots;		// same index, storage owned by the directory
+
+		uint64					Size() const { return static_cast<uint64>(shards.size()); }
+		uint64					Pick(uint64 key) const { return shards.empty() ? 0 : JumpHash(Mix64(key), static_cast<uint32>(shards.size())); }
+		Sptr<ShardExecutor>		At(uint64 i) const { return i < Size() ? shards[i] : nullptr; }
 	};
 
 
@@ -29,29 +42,43 @@ namespace jam::utils::exec
 
         void Init(const std::vector<Sptr<ShardExecutor>>& shards);
 
-        void Start();      //  +(ownership==Own  ǹ)
-        void StopAll();    // Own   
-        void JoinAll();    // Own  
+        void Start();      // 샤드 생성+시작(ownership==Own일 때만 의미)
+        void StopAll();    // Own일 때만 샤드 정지
+        void JoinAll();    // Own일 때만 조인
 
         // Slot binding
         void AttachSlots();     
 
-        //  / ȸ
+        // 라우팅 / 조회 (lock-free: one acquire load of the current table)
+        const ShardTable&       Table() const { return *m_table.load(std::memory_order_acquire); }
         uint64                  Size() const;
         uint64                  PickShard(uint64 key) const;
         Sptr<ShardExecutor>     ShardAt(uint64 i) const;
-        std::vector<Sptr<ShardExecutor>>& Shards() { return m_shards; }
+        std::vector<Sptr<ShardExecutor>> Shards() const { return Table().shards; }
 
-        // Ʈ ߱
+        // 엔드포인트 발급
         ShardEndpoint           EndpointFor(uint64 key) const;
         ShardEndpoint           EndpointFor(uint64 key, eMailboxChannel channel) const;
         ShardEndpoint           EndpointFor(RouteKey rk, eMailboxChannel channel) const;
         ShardEndpoint           EndpointFor(GroupHomeKey gk, eMailboxChannel channel) const;
 
+        // resize (GlobalExecutor::AddShard / RemoveShard). writers serialize on a mutex
+        Sptr<ShardExecutor>     CreateShard() const;                   // next index, not started or published
+        void                    AppendShard(Sptr<ShardExecutor> shard); // attach its slot and publish
+        Sptr<ShardExecutor>     DetachLastShard();                      // publish without it; its slot drains
+
+    private:
+        ShardSlot*              SlotFor(uint64 index);
+        void                    Publish(Uptr<ShardTable> table);
+
     private:
         ShardDirectoryConfig                m_config{};
         std::weak_ptr<GlobalExecutor>       m_owner;
-        std::vector<Sptr<ShardExecutor>>    m_shards;   // Own/Adopt  
-        std::vector<ShardSlot>              m_slots;    
+
+        Atomic<const ShardTable*>           m_table{ nullptr };
+        // every table ever published: a reader may still hold an old one, and resizes are rare
+        std::vector<Uptr<ShardTable>>       m_tables;
+        std::deque<ShardSlot>               m_slots;    // slot i is reused by whichever shard holds index i
+        Mutex                               m_writeLock;
 	};
 }
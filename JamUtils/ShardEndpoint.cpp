@@ -24,12 +24,18 @@ namespace jam::utils::exec
 
 	ShardEndpoint::ePostResult ShardEndpoint::Post(job::Job job) const
 	{
-		if (!m_slot) 
-			return ePostResult::UNVAILABLE;
+		// executor mode: the shard's own queue (the mesh ring when posted from another shard)
+		if (!m_slot)
+		{
+			if (!m_target)
+				return ePostResult::UNVAILABLE;
+			m_target->Submit(std::move(job));
+			return ePostResult::OK;
+		}
 
 		auto& qs = m_slot->ch[E2U(m_channel)];
 
-		// / üũ
+		// 세대/상태 체크
 		uint32 g = qs.gen.load(std::memory_order_acquire);
 		if (g != m_gen) 
 			return ePostResult::STALE;
@@ -42,9 +48,7 @@ namespace jam::utils::exec
 		if (!q) 
 			return ePostResult::UNVAILABLE;
 
-		// ConcurrentQueue  ū ȭ   Executor  TLS ū ۸  ʹٸ
-		// ⼭  q->enqueue(...)  Mailbox::Post(...)  
-		// ( Mailbox::Post ū  η ְ, TLS ȭ ʿ  ߰)
-		return q->Post(std::move(job)) ? ePostResult::OK : ePostResult::UNVAILABLE;
+		// shard ingress mailbox: the endpoint's channel selects the lane
+		return q->Post(std::move(job), m_channel) ? ePostResult::OK : ePostResult::UNVAILABLE;
 	}
 }
@@ -33,8 +33,8 @@ namespace jam::utils::exec
 	private:
 		Sptr<ShardExecutor>		m_target;
 
-		ShardSlot*				m_slot = nullptr; // 
+		ShardSlot*				m_slot = nullptr; // 비소유
 		eMailboxChannel			m_channel = eMailboxChannel::NORMAL;
-		uint32					m_gen = 0;       //   gen 
+		uint32					m_gen = 0;       // 생성 시점 gen 스냅샷
 	};
 }
@@ -5,16 +5,45 @@
 #include "GlobalExecutor.h"
 #include "WinFiberBackend.h"
 #include "ShardDirectory.h"
+#include "ShardTLS.h"
 
 namespace jam::utils::exec
 {
+	namespace
+	{
+		Atomic<uint64> s_nextShardUid{ 1 };
+	}
+
+	static constexpr int32 MAX_STOP_DRAIN_ROUNDS = 64;
+
+	// one source shard -> one destination shard
+	struct ShardExecutor::MeshLink
+	{
+		thrd::SpscRing<job::Job>	ring;
+		Atomic<uint64>				spillDone{ 0 };		// destination: spilled jobs run so far
+
+		explicit MeshLink(uint32 capacity) : ring(capacity) {}
+
+		// destination thread: runs what the source pushed before position
+		void DrainUpTo(uint64 position)
+		{
+			job::Job j;
+			while (ring.GetPopped() < position && ring.TryPop(j))
+				j.Execute();
+		}
+	};
+
 	ShardExecutor::ShardExecutor(const ShardExecutorConfig& config, Wptr<GlobalExecutor> owner)
-			: m_config(config), m_owner(std::move(owner))
+			: m_config(config), m_owner(std::move(owner)), m_uid(s_nextShardUid.fetch_add(1, std::memory_order_relaxed))
 	{
 		m_scheduler			= std::make_unique<thrd::FiberScheduler>(m_backend);
 		m_shardsCtok		= std::make_unique<moodycamel::ConsumerToken>(m_shardsQ);
 		m_readyCtrlCtok		= std::make_unique<moodycamel::ConsumerToken>(m_readyCtrlQ);
 		m_readyNormalCtok	= std::make_unique<moodycamel::ConsumerToken>(m_readyNormalQ);
+
+		m_tuning.batchBudget.store(m_config.batchBudget, std::memory_order_relaxed);
+		m_tuning.idleSleepMs.store(m_config.idleSleepMs, std::memory_order_relaxed);
+		m_tuning.assistThreshold.store(m_config.assistThreshold, std::memory_order_relaxed);
 	}
 
 	ShardExecutor::~ShardExecutor()
@@ -33,9 +62,12 @@ namespace jam::utils::exec
 				if (m_pinEnabled)
 					utils::sys::PinCurrentThreadTo(m_pinSlot);
 
+				ShardTLS::Bind(&m_local, std::this_thread::get_id(), this);
 				m_scheduler->AttachToCurrentThread();
 				Loop();
+				DrainShardJobs();
 				m_scheduler->DetachFromThread();
+				ShardTLS::Unbind();
 			});
 	}
 
@@ -43,7 +75,7 @@ namespace jam::utils::exec
 	{
 		if (!m_running.exchange(false))
 			return;
-		// 
+		// 깨우기
 		{
 			auto& tok = TlsTokenFor(m_shardsQ);
 			m_shardsQ.enqueue(tok, job::Job([] {}));
@@ -65,7 +97,7 @@ namespace jam::utils::exec
 				auto& qs = m_shardSlot->ch[i];
 				qs.state.store(E2U(eShardState::CLOSED), std::memory_order_release);
 				qs.q.store(nullptr, std::memory_order_release);
-				qs.gen.fetch_add(1, std::memory_order_acq_rel);  //  
+				qs.gen.fetch_add(1, std::memory_order_acq_rel);  // 폐기 세대
 			}
 		}
 	}
@@ -81,48 +113,143 @@ namespace jam::utils::exec
 	}
 
 	void ShardExecutor::Submit(job::Job job)
+	{
+		ShardExecutor* self = ShardTLS::GetExecutor();
+		if (self == this)
+		{
+			m_localJobs.Push(std::move(job));
+			return;
+		}
+
+		if (self != nullptr && m_config.meshRingCapacity != 0)
+		{
+			self->MeshSend(*this, std::move(job));
+			return;
+		}
+
+		EnqueueShared(std::move(job));
+	}
+
+	void ShardExecutor::EnqueueShared(job::Job&& job)
 	{
 		auto& tok = TlsTokenFor(m_shardsQ);
 		m_shardsQ.enqueue(tok, std::move(job));
 	}
 
-	std::shared_ptr<Mailbox> ShardExecutor::CreateMailbox(eMailboxChannel channel)
+	void ShardExecutor::MeshSend(ShardExecutor& dst, job::Job&& job)
 	{
-		auto id = m_nextMailboxId.fetch_add(1, std::memory_order_relaxed);
-		auto mb = std::make_shared<Mailbox>(id, weak_from_this(), channel);
+		const uint64 index = static_cast<uint64>(dst.GetIndex());
+		if (m_meshOut.size() <= index)
+			m_meshOut.resize(index + 1);
+
+		MeshOut& out = m_meshOut[index];
+		if (out.targetUid != dst.m_uid)
 		{
-			WRITE_LOCK
-			m_mailboxes.emplace(id, mb);
+			out.targetUid = dst.m_uid;
+			out.spillSent = 0;
+			out.link = memory::MakeShared<MeshLink>(dst.m_config.meshRingCapacity);
+			dst.m_meshJoinQ.enqueue(out.link);
 		}
 
-		// ä ingress Mailbox Խ
-		if (m_shardSlot)
+		// back on the ring only once every spilled job has run, so none is overtaken
+		MeshLink& link = *out.link;
+		if (out.spillSent == link.spillDone.load(std::memory_order_acquire) && link.ring.TryPush(std::move(job)))
+			return;
+
+		// full: the shared queue. the spilled job first runs what the ring holds ahead of it
+		++out.spillSent;
+		dst.EnqueueShared(job::Job([mesh = out.link, upTo = link.ring.GetPushed(), j = std::move(job)]() mutable
+			{
+				mesh->DrainUpTo(upTo);
+				j.Execute();
+				mesh->spillDone.store(mesh->spillDone.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+			}));
+	}
+
+	bool ShardExecutor::PollMesh(int32 budgetPerRing)
+	{
+		Sptr<MeshLink> joined;
+		while (m_meshJoinQ.try_dequeue(joined))
+			m_meshIn.push_back(std::move(joined));
+
+		m_meshPending = false;
+		if (m_meshIn.empty())
+			return false;
+
+		// the starting source rotates, so a busy one cannot keep the others behind
+		bool didWork = false;
+		const uint64 count = m_meshIn.size();
+		for (uint64 k = 0; k < count; ++k)
 		{
-			auto& qs = m_shardSlot->ch[E2U(channel)];
+			MeshLink& link = *m_meshIn[(m_meshCursor + k) % count];
+			job::Job j;
+			for (int32 i = 0; i < budgetPerRing && link.ring.TryPop(j); ++i)
+			{
+				didWork = true;
+				j.Execute();
+			}
+			m_meshPending |= !link.ring.IsEmpty();
+		}
+		m_meshCursor = (m_meshCursor + 1) % count;
+		return didWork;
+	}
+
+	void ShardExecutor::AttachSlot(ShardSlot* slot)
+	{
+		m_shardSlot = slot;
+		if (!m_shardSlot)
+			return;
+
+		if (!m_ingress)
+			m_ingress = CreateMailbox();
+
+		// 채널 ingress Mailbox 게시 : one mailbox, the channel picks the lane
+		for (uint8 i = 0; i < E2U(eMailboxChannel::COUNT); ++i)
+		{
+			auto& qs = m_shardSlot->ch[i];
 			qs.state.store(E2U(eShardState::CLOSED), std::memory_order_release);
-			qs.q.store(mb.get(), std::memory_order_release);
-			qs.gen.fetch_add(1, std::memory_order_acq_rel);      //  
+			qs.q.store(m_ingress.get(), std::memory_order_release);
+			qs.gen.fetch_add(1, std::memory_order_acq_rel);      // 새 세대
 			qs.state.store(E2U(eShardState::OPEN), std::memory_order_release);
 		}
+	}
 
-
+	std::shared_ptr<Mailbox> ShardExecutor::CreateMailbox(uint64 routeKey)
+	{
+		const uint32 id = m_mailboxes.Acquire();
+		auto mb = memory::MakeShared<Mailbox>(id, weak_from_this(), routeKey);
+		m_mailboxes.Publish(id, mb);
 		return mb;
 	}
 
 	void ShardExecutor::RemoveMailbox(uint32 id)
 	{
-		WRITE_LOCK
-		m_mailboxes.erase(id);
+		m_mailboxes.Remove(id);
 	}
 
-	void ShardExecutor::NotifyReady(Mailbox* mb)
+	void ShardExecutor::NotifyReady(Mailbox* mb, eMailboxChannel lane)
 	{
-		// Mailbox ó ä  ready ť 
-		auto& q = (mb->GetMailboxChannel() == eMailboxChannel::CTRL) ? m_readyCtrlQ : m_readyNormalQ;
+		// Mailbox가 처음 채워졌을 때 ready 큐에 등록
+		mb->MarkReady(Clock::Instance().NowNs());
+		mb->AddReadyRef();
+		auto& q = (lane == eMailboxChannel::CTRL) ? m_readyCtrlQ : m_readyNormalQ;
 		auto& tok = TlsTokenFor(q);
 		q.enqueue(tok, mb);
 	}
 
+	void ShardExecutor::NotifyLocalReady(Mailbox* mb, eMailboxChannel lane)
+	{
+		// same wait metric as the shared lists: AutoTuner / OverloadController see same-shard backlog too
+		mb->MarkLocalReady(Clock::Instance().NowNs());
+		m_localReady[E2U(lane)].Push(mb);
+	}
+
+	void ShardExecutor::WatchEscalation(uint32 mailboxId, uint64 due_ns)
+	{
+		auto& tok = TlsTokenFor(m_escalateQ);
+		m_escalateQ.enqueue(tok, EscalationWatch{ due_ns, mailboxId });
+	}
+
 	void ShardExecutor::PinCoreSlot(const utils::sys::CoreSlot& slot)
 	{
 		m_pinSlot = slot;
@@ -149,10 +276,12 @@ namespace jam::utils::exec
 		m_scheduler->CancelById(id, code);
 	}
 
-	void ShardExecutor::OnGroupLocalJoin(uint64 group_id, std::shared_ptr<Mailbox> mailbox)
+	void ShardExecutor::OnGroupLocalJoin(uint64 group_id, std::shared_ptr<Mailbox> mailbox, uint64 homeKey)
 	{
 		auto& gl = m_groupLocal[group_id];
 		gl.members.emplace_back(mailbox);
+		if (homeKey != 0)
+			gl.homeKey = homeKey;
 	}
 
 	void ShardExecutor::OnGroupLocalLeave(uint64 group_id, std::shared_ptr<Mailbox> mailbox)
@@ -161,7 +290,7 @@ namespace jam::utils::exec
 		if (it == m_groupLocal.end()) return;
 
 		auto& v = it->second.members;
-		//  ƴϹǷ    ( ٲٷ lock()ؼ )
+		// 약한참조가 아니므로 직접 비교해 제거 (약한참조로 바꾸려면 lock()해서 비교)
 		for (size_t i = 0; i < v.size(); )
 		{
 			if (v[i].expired() || v[i].lock() == mailbox) 
@@ -177,9 +306,11 @@ namespace jam::utils::exec
 		if (v.empty()) m_groupLocal.erase(it);
 	}
 
-	void ShardExecutor::OnGroupHomeMark(uint64 group_id, uint32 shardIdx, int32 delta)
+	void ShardExecutor::OnGroupHomeMark(uint64 group_id, uint32 shardIdx, int32 delta, uint64 homeKey)
 	{
 		auto& gh = m_groupHome[group_id];
+		if (homeKey != 0)
+			gh.homeKey = homeKey;
 		if (gh.shard_refcnt.size() <= shardIdx)
 			gh.shard_refcnt.resize(shardIdx + 1, 0);
 
@@ -187,24 +318,24 @@ namespace jam::utils::exec
 		if (newv < 0) newv = 0;
 		gh.shard_refcnt[shardIdx] = (uint32)newv;
 
-		// (ɼ)  0̸ gh   
+		// (옵션) 모두 0이면 gh를 지울 수도 있음
 		// bool all0 = std::all_of(gh.shard_refcnt.begin(), gh.shard_refcnt.end(), [](uint32 x){return x==0;});
 		// if (all0) m_groupHome.erase(group_id);
 	}
 
 	void ShardExecutor::OnGroupMulticastHome(uint64 group_id, job::Job j)
 	{
-		// 1) Ȩ    
+		// 1) 홈 샤드 로컬 멤버에게 배달
 		DeliverToLocal(group_id, j);
 
-		// 2)   forward
+		// 2) 원격 샤드 forward
 		auto it = m_groupHome.find(group_id);
 		if (it == m_groupHome.end()) return;
 
 		const auto& refcnt = it->second.shard_refcnt;
 		if (refcnt.empty()) return;
 
-		// owner(GlobalExecutor)    Sptr 
+		// owner(GlobalExecutor) 통해 원격 샤드 Sptr 얻기
 		auto owner = m_owner.lock();
 		if (!owner) return;
 
@@ -213,10 +344,10 @@ namespace jam::utils::exec
 			if (s == (uint32)m_config.index) continue;
 			if (refcnt[s] == 0) continue;
 
-			auto remote = owner->GetShard(s); // GlobalExecutor  API ־ 
+			auto remote = owner->GetShard(s); // GlobalExecutor에 이 API가 있어야 함
 			if (!remote) continue;
 
-			//   Ʈ  Post
+			// 실행자 기반 엔드포인트로 직접 Post
 			ShardEndpoint ep(remote);
 			ep.Post(job::Job([remote, group_id, j] {
 					remote->OnGroupMulticastRemote(group_id, j);
@@ -238,13 +369,13 @@ namespace jam::utils::exec
 		size_t i = 0;
 		while (i < members.size())
 		{
-			if (auto q = members[i].lock())
+			auto q = members[i].lock();
+			// 세션 Mailbox로 최종 배달(복사비 줄이려면 capturable payload로)
+			if (q && q->Post(job::Job(j)))
 			{
-				//  Mailbox  ( ̷ capturable payload)
-				q->Post(j);
 				++i;
 			}
-			else
+			else	// gone or removed from the registry
 			{
 				members[i] = members.back();
 				members.pop_back();
@@ -256,21 +387,20 @@ namespace jam::utils::exec
 	{
 		auto& L = m_local;
 
-		// 1) Systems run in fixed order
-		for (auto* fn : L.systems) 
-		{
-			fn(L, now_ns, dt_ns);
-		}
+		// 1) Systems: declared-independent ones in parallel on IO workers, the rest in order
+		auto owner = m_owner.lock();
+		L.systems.Run(L, now_ns, dt_ns, owner.get());
 
-		// 2)    ۾ ϰ ݿ
-		if (!L.defers.empty()) 
-		{
-			for (auto& f : L.defers) f(L.world);
-			L.defers.clear();
-		}
+		// 2) 프레임 말미 지연 작업 일괄 반영
+		L.commands.Apply(L.world);
 
-		// 3)
-		L.events.update();
+		// 3) events, fixed type order
+		L.events.Drain();
+
+		// single writer: the shard thread
+		m_metrics.ticks.store(m_metrics.ticks.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		if (dt_ns != 0 && Clock::Instance().NowNs() - now_ns > dt_ns)
+			m_metrics.tickOverruns.store(m_metrics.tickOverruns.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
 	}
 
 
@@ -283,25 +413,259 @@ namespace jam::utils::exec
 			m_shardSlot->ch[i].state.store(E2U(eShardState::DRAINING), std::memory_order_release);
 	}
 
+	/*---- resize : hand-over to the shard that now owns a key ----*/
+
+	// built on the source thread, applied by the destination in one shard job
+	struct ShardExecutor::Handoff
+	{
+		xvector<EntityParcel>								entities;
+		xvector<Sptr<Mailbox>>								mailboxes;
+		xvector<std::pair<uint64, GroupHome>>				groupHomes;		// group id, table
+		xvector<std::tuple<uint64, uint64, Sptr<Mailbox>>>	groupJoins;		// group id, home key, member
+	};
+
+	void ShardExecutor::Rebalance(const ShardTable& table)
+	{
+		auto& L = m_local;
+		const uint64 self = static_cast<uint64>(m_config.index);
+
+		// settle deferred work first: nothing recorded for a leaving entity may apply here later
+		L.commands.Apply(L.world);
+		L.events.Drain();
+
+		std::vector<Sptr<Handoff>> out(table.Size());
+		auto handoffFor = [&](uint64 dest) -> Handoff&
+			{
+				if (!out[dest])
+					out[dest] = memory::MakeShared<Handoff>();
+				return *out[dest];
+			};
+		auto leaves = [&](uint64 key, OUT uint64& dest)
+			{
+				dest = table.Pick(key);
+				return dest != self && table.At(dest) != nullptr;
+			};
+
+		// 1) entities carrying a RouteKey
+		uint64 movedEntities = 0;
+		if (!L.migrator.IsEmpty())
+		{
+			std::vector<std::pair<entt::entity, uint64>> leaving;
+			for (auto [e, key] : L.world.view<RouteKey>().each())
+			{
+				uint64 dest = 0;
+				if (leaves(key.value(), dest) && !L.migrator.IsPinned(L.world, e))
+					leaving.emplace_back(e, dest);
+			}
+
+			for (auto [e, dest] : leaving)
+			{
+				handoffFor(dest).entities.push_back(L.migrator.Pack(L.world, e));
+				L.world.destroy(e);
+			}
+			movedEntities = leaving.size();
+		}
+
+		// 2) keyed mailboxes: the queue object moves, so posts and queued jobs keep their order
+		std::vector<std::pair<uint32, uint64>> leavingBoxes;
+		m_mailboxes.ForEach([&](Mailbox* mb)
+			{
+				uint64 dest = 0;
+				if (mb->GetRouteKey() != 0 && leaves(mb->GetRouteKey(), dest))
+					leavingBoxes.emplace_back(mb->GetId(), dest);
+			});
+
+		uint64 movedMailboxes = 0;
+		for (auto [id, dest] : leavingBoxes)
+		{
+			Sptr<Mailbox> mb = m_mailboxes.Detach(id);
+			if (mb == nullptr)
+				continue;		// removed meanwhile
+
+			mb->BeginTransit();
+			handoffFor(dest).mailboxes.push_back(std::move(mb));
+			++movedMailboxes;
+		}
+
+		// their same-shard jobs went with them (BeginTransit); drop the local ready entries
+		if (movedMailboxes > 0)
+		{
+			for (auto& ready : m_localReady)
+				ready.EraseIf([this](Mailbox* mb) { return !mb->IsOwnedBy(this); });
+		}
+
+		// 3) group state: local memberships follow their mailbox, home tables follow their key
+		struct Remark { uint64 groupId; uint64 homeKey; uint64 to; };
+		std::vector<Remark> remarks;
+
+		for (auto it = m_groupLocal.begin(); it != m_groupLocal.end(); )
+		{
+			auto& members = it->second.members;
+			for (size_t i = 0; i < members.size(); )
+			{
+				auto mb = members[i].lock();
+				uint64 dest = 0;
+				if (mb && !mb->IsOwnedBy(this) && mb->GetRouteKey() != 0 && leaves(mb->GetRouteKey(), dest))
+				{
+					handoffFor(dest).groupJoins.emplace_back(it->first, it->second.homeKey, std::move(mb));
+					if (it->second.homeKey != 0)
+						remarks.push_back(Remark{ it->first, it->second.homeKey, dest });
+
+					members[i] = members.back();
+					members.pop_back();
+				}
+				else
+				{
+					++i;
+				}
+			}
+
+			if (members.empty())
+				it = m_groupLocal.erase(it);
+			else
+				++it;
+		}
+
+		for (auto it = m_groupHome.begin(); it != m_groupHome.end(); )
+		{
+			uint64 dest = 0;
+			if (it->second.homeKey != 0 && leaves(it->second.homeKey, dest))
+			{
+				handoffFor(dest).groupHomes.emplace_back(it->first, std::move(it->second));
+				it = m_groupHome.erase(it);
+			}
+			else
+			{
+				++it;
+			}
+		}
+
+		for (uint64 i = 0; i < out.size(); ++i)
+		{
+			if (!out[i])
+				continue;
+
+			auto dest = table.At(i);
+			dest->Submit(job::Job([dest, h = out[i]] { dest->AcceptHandoff(*h); }));
+		}
+
+		// member counts move from this shard to the destination. after the hand-offs: a home table
+		// that moved is in place by then (one producer, FIFO)
+		for (const Remark& r : remarks)
+		{
+			auto home = table.At(table.Pick(r.homeKey));
+			if (!home)
+				continue;
+
+			home->Submit(job::Job([home, r, self]
+				{
+					home->OnGroupHomeMark(r.groupId, static_cast<uint32>(self), -1, r.homeKey);
+					home->OnGroupHomeMark(r.groupId, static_cast<uint32>(r.to), +1, r.homeKey);
+				}));
+		}
+
+		if (movedEntities + movedMailboxes > 0)
+			LOG_INFO("rebalance: shard {} handed off {} entities, {} mailboxes", self, movedEntities, movedMailboxes);
+	}
+
+	void ShardExecutor::AcceptHandoff(Handoff& handoff)
+	{
+		auto& L = m_local;
+
+		for (EntityParcel& parcel : handoff.entities)
+		{
+			const entt::entity e = L.world.create();
+			parcel.Apply(L.world, e);
+			L.migrator.Adopt(L.world, e);
+		}
+
+		for (auto& [groupId, moved] : handoff.groupHomes)
+		{
+			GroupHome& gh = m_groupHome[groupId];
+			gh.homeKey = moved.homeKey;
+			gh.seq = (std::max)(gh.seq, moved.seq);
+			if (gh.shard_refcnt.size() < moved.shard_refcnt.size())
+				gh.shard_refcnt.resize(moved.shard_refcnt.size(), 0);
+			for (size_t i = 0; i < moved.shard_refcnt.size(); ++i)
+				gh.shard_refcnt[i] += moved.shard_refcnt[i];
+		}
+
+		// mailboxes after their entities: the first job that runs here already finds them
+		for (Sptr<Mailbox>& mb : handoff.mailboxes)
+		{
+			const uint32 id = m_mailboxes.Acquire();
+			m_mailboxes.Publish(id, mb);
+			mb->EndTransit(this, id);
+
+			// posts during the transit did not notify anyone
+			if (!mb->IsEmpty())
+				NotifyReady(mb.get(), mb->ReadyLane());
+			if (const uint64 at = mb->GetEscalateAt(); at != 0)
+				WatchEscalation(id, at);
+
+			// its session went away on the way
+			if (mb->IsClosed())
+				m_mailboxes.Remove(id);
+		}
+
+		for (auto& [groupId, homeKey, mb] : handoff.groupJoins)
+			OnGroupLocalJoin(groupId, std::move(mb), homeKey);
+	}
+
+	bool ShardExecutor::ForwardIfMoved(Mailbox* mb)
+	{
+		if (mb->IsOwnedBy(this))
+			return false;
+
+		// handed over: the entry follows the mailbox. in transit it is dropped, the new owner
+		// notifies on arrival
+		if (auto owner = mb->GetOwner(); owner && !mb->IsEmpty())
+			owner->NotifyReady(mb, mb->ReadyLane());
+
+		mb->ReleaseReadyRef();
+		return true;
+	}
+
+	bool ShardExecutor::IsDrained() const
+	{
+		return m_shardsQ.size_approx() == 0
+			&& !m_localBusy.load(std::memory_order_relaxed)
+			&& m_readyCtrlQ.size_approx() == 0
+			&& m_readyNormalQ.size_approx() == 0
+			&& (!m_ingress || m_ingress->IsEmpty());
+	}
+
 	void ShardExecutor::AssistDrainOnce(int32 maxMailboxes, int32 budgetPerMailbox)
 	{
 		int processedLists = 0;
 		while (processedLists < maxMailboxes)
 		{
+			// shared ready lists only: the local ones belong to the shard thread
 			Mailbox* mb = nullptr;
-			if (!TryDequeueReady(mb) || mb == nullptr)
+			if (!m_readyCtrlQ.try_dequeue(mb) && !m_readyNormalQ.try_dequeue(mb))
 				break;
+			if (mb == nullptr)
+				break;
+
+			if (ForwardIfMoved(mb))
+			{
+				++processedLists;
+				continue;
+			}
 
 			if (mb->TryBeginConsume())
 			{
-				ProcessMailbox(mb, budgetPerMailbox);
+				ProcessMailbox(mb, budgetPerMailbox, false, mb->GetReadySince());
 				mb->EndConsume();
 			}
 
-			//  ִٸ ٽ ready ־ ó
+			// 아직 남아있다면 다시 ready에 넣어 재처리
 			if (!mb->IsEmpty())
-				NotifyReady(mb);
+				NotifyReady(mb, mb->ReadyLane());
+			else
+				mb->ClearEscalation();
 
+			mb->ReleaseReadyRef();
 			++processedLists;
 		}
 
@@ -313,11 +677,15 @@ namespace jam::utils::exec
 
 	void ShardExecutor::Loop()
 	{
+		Clock& clock = Clock::Instance();
+
 		while (m_running.load())
 		{
 			bool didWork = false;
+			EscalateDue(clock.UpdateLoopNow());
+			m_mailboxes.Reclaim();
 
-			//  ü ۾
+			// 샤드 자체 작업
 			for (int i = 0; i < 32; ++i)	// why 32 ?
 			{
 				job::Job j([] {});
@@ -327,13 +695,60 @@ namespace jam::utils::exec
 				j.Execute();
 			}
 
-			// غ Mailbox ó
+			// other shards' rings to this one
+			didWork |= PollMesh(32);
+
+			// same budget for jobs this shard submitted to itself
+			for (int i = 0; i < 32; ++i)
+			{
+				job::Job j([] {});
+				if (!m_localJobs.TryPop(j))
+					break;
+				didWork = true;
+				j.Execute();
+			}
+
+			// 준비된 Mailbox 처리
 			didWork |= ProcessReadyOnce();
 
-			m_scheduler->Poll(m_config.batchBudget, Clock::Instance().NowNs());
+			m_localBusy.store(m_meshPending || !m_localJobs.IsEmpty() || !m_localReady[0].IsEmpty() || !m_localReady[1].IsEmpty(), std::memory_order_relaxed);
+
+			const int32 budget = m_tuning.batchBudget.load(std::memory_order_relaxed);
+			m_scheduler->Poll(budget, clock.UpdateLoopNow());
 
 			if (!didWork)
-				std::this_thread::sleep_for(std::chrono::milliseconds(m_config.idleSleepMs));
+			{
+				const uint64 sleepFrom = clock.NowNs();
+				std::this_thread::sleep_for(std::chrono::milliseconds(m_tuning.idleSleepMs.load(std::memory_order_relaxed)));
+				m_metrics.idleNs.fetch_add(clock.NowNs() - sleepFrom, std::memory_order_relaxed);
+			}
+		}
+	}
+
+	void ShardExecutor::DrainShardJobs()
+	{
+		// stopped: jobs submitted to this shard (scatter pieces, hand-overs) still run, so whoever
+		// waits on one does not wait forever. Mailbox work stays with its mailbox. Bounded: a job
+		// that keeps resubmitting itself must not hold the thread past Stop.
+		bool didWork = true;
+		for (int32 round = 0; didWork && round < MAX_STOP_DRAIN_ROUNDS; ++round)
+		{
+			didWork = false;
+
+			job::Job j([] {});
+			while (m_shardsQ.try_dequeue(*m_shardsCtok, j))
+			{
+				didWork = true;
+				j.Execute();
+			}
+
+			didWork |= PollMesh(INT32_MAX);
+
+			while (m_localJobs.TryPop(j))
+			{
+				didWork = true;
+				j.Execute();
+			}
 		}
 	}
 
@@ -342,61 +757,126 @@ namespace jam::utils::exec
 		bool didWork = false;
 
 		Mailbox* mb = nullptr;
-		if (!TryDequeueReady(mb) || mb == nullptr)
+		bool local = false;
+		if (!TryDequeueReady(mb, local) || mb == nullptr)
 			return false;
 
-		// ÿ 1 Һ 
+		if (local)
+			return ProcessLocalReady(mb);
+
+		if (ForwardIfMoved(mb))
+			return true;
+
+		// 동시에 1 소비자 보장
 		if (mb->TryBeginConsume())
 		{
-			ProcessMailbox(mb, m_config.batchBudget);
+			ProcessMailbox(mb, m_tuning.batchBudget.load(std::memory_order_relaxed), true, mb->GetReadySince());
 			mb->EndConsume();
 			didWork = true;
 
-			//   
+			// 아직 남아있으면 재등록 (leftover same-shard jobs keep their own local entry)
 			if (!mb->IsEmpty())
 			{
-				NotifyReady(mb);
+				NotifyReady(mb, mb->ReadyLane());
+			}
+			else if (!mb->HasLocalWork())
+			{
+				// drained: pending watches find nothing to escalate (a job posted just now keeps
+				// its delivery, only loses the escalation)
+				mb->ClearEscalation();
 			}
 
-			// Ӱġ üũ
+			// 임계치 체크
 			RequestAssistIfNeeded(mb);
 		}
 		else
 		{
-			NotifyReady(mb);
+			NotifyReady(mb, mb->ReadyLane());
 		}
 
+		// this entry is done; re-notifies above took their own ref
+		mb->ReleaseReadyRef();
 		return didWork;
 	}
 
-	void ShardExecutor::ProcessMailbox(Mailbox* mb, int32 budget)
+	bool ShardExecutor::ProcessLocalReady(Mailbox* mb)
 	{
-		// bulk pop ġ ó
+		// a local entry is never forwarded: Rebalance drops the entries of mailboxes it hands over
+		bool didWork = false;
+		if (mb->TryBeginConsume())
+		{
+			ProcessMailbox(mb, m_tuning.batchBudget.load(std::memory_order_relaxed), true, mb->GetLocalReadySince());
+			mb->EndConsume();
+			didWork = true;
+
+			if (mb->IsEmpty() && !mb->HasLocalWork())
+				mb->ClearEscalation();
+		}
+
+		// budget left some, or an assist drain holds the mailbox: go round again
+		if (mb->HasLocalWork())
+		{
+			const eMailboxChannel lane = mb->LocalReadyLane();
+			if (mb->TryMarkLocalReady(lane))
+				NotifyLocalReady(mb, lane);
+		}
+		return didWork;
+	}
+
+	void ShardExecutor::ProcessMailbox(Mailbox* mb, int32 budget, bool owned, uint64 readySince_ns)
+	{
+		// bulk pop으로 배치 처리
 		static thread_local std::vector<job::Job> batch;
 		batch.clear();
 		batch.reserve(budget);
 
-		uint64 n = mb->TryPopBulk(std::back_inserter(batch), static_cast<uint64>(budget));
+		const uint64 now_ns = Clock::Instance().NowNs();
+		if (readySince_ns != 0 && now_ns > readySince_ns)
+			m_metrics.readyWait.Record(now_ns - readySince_ns);
+
+		uint64 n = mb->TryPopBulk(std::back_inserter(batch), static_cast<uint64>(budget), owned);
+
+		// late best-effort jobs are dropped, so stale work does not delay fresh work
+		uint64 expired = 0;
 
 		for (uint64 i = 0; i < n; ++i)
+		{
+			if (batch[i].IsExpired(now_ns))
+			{
+				++expired;
+				continue;
+			}
 			batch[i].Execute();
+		}
 
-		// bulk   ܰ  Һ
+		// bulk에서 덜 뽑혔으면 단건으로 마저 소비
 		for (int32 i = static_cast<int32>(n); i < budget; ++i)
 		{
 			job::Job j([] {});
-			if (!mb->TryPop(j)) break;
+			if (!mb->TryPop(j, owned)) break;
+			if (j.IsExpired(now_ns))
+			{
+				++expired;
+				continue;
+			}
 			j.Execute();
 		}
+
+		if (expired > 0)
+		{
+			mb->AddExpired(expired);
+			m_expiredJobs.fetch_add(expired, std::memory_order_relaxed);
+		}
 	}
 
 	void ShardExecutor::RequestAssistIfNeeded(Mailbox* mb)
 	{
-		if (mb->GetSizeApprox() >= m_config.assistThreshold)
+		if (mb->GetSizeApprox() >= m_tuning.assistThreshold.load(std::memory_order_relaxed))
 		{
 			bool expected = false;
 			if (m_assistRequested.compare_exchange_strong(expected, true, std::memory_order_acq_rel))
 			{
+				m_metrics.assistRequests.fetch_add(1, std::memory_order_relaxed);
 				if (auto owner = m_owner.lock())
 					owner->RequestAssist(static_cast<uint32>(m_config.index));
 			}
@@ -404,16 +884,58 @@ namespace jam::utils::exec
 	}
 
 
-	bool ShardExecutor::TryDequeueReady(OUT Mailbox*& mailbox)
+	void ShardExecutor::EscalateDue(uint64 now_ns)
 	{
-		// 1) Ctrl 
-		if (m_readyCtrlQ.try_dequeue(*m_readyCtrlCtok, mailbox))
-			return true;
+		const auto later = [](const EscalationWatch& a, const EscalationWatch& b) { return a.due_ns > b.due_ns; };
 
-		// 2) Normal
-		if (m_readyNormalQ.try_dequeue(*m_readyNormalCtok, mailbox))
-			return true;
+		EscalationWatch w;
+		while (m_escalateQ.try_dequeue(w))
+		{
+			m_escalateHeap.push_back(w);
+			std::push_heap(m_escalateHeap.begin(), m_escalateHeap.end(), later);
+		}
+
+		while (!m_escalateHeap.empty() && m_escalateHeap.front().due_ns <= now_ns)
+		{
+			std::pop_heap(m_escalateHeap.begin(), m_escalateHeap.end(), later);
+			w = m_escalateHeap.back();
+			m_escalateHeap.pop_back();
 
+			// shard thread: valid until our next Reclaim
+			Mailbox* mb = m_mailboxes.Find(w.mailboxId);
+
+			// stale watch (drained, removed, or already escalated) -> nothing to do
+			if (mb == nullptr || !mb->TakeEscalation(now_ns) || (mb->IsEmpty() && !mb->HasLocalWork()))
+				continue;
+
+			// ahead of the normal backlog; its NORMAL ready entry stays and finds less (or nothing) later
+			mb->AddReadyRef();
+			auto& tok = TlsTokenFor(m_readyCtrlQ);
+			m_readyCtrlQ.enqueue(tok, mb);
+			m_escalations.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+	bool ShardExecutor::TryDequeueReady(OUT Mailbox*& mailbox, OUT bool& local)
+	{
+		// per lane the local list first: it costs nothing to look at
+		for (eMailboxChannel lane : { eMailboxChannel::CTRL, eMailboxChannel::NORMAL })
+		{
+			if (m_localReady[E2U(lane)].TryPop(mailbox))
+			{
+				mailbox->ClearLocalReady(lane);
+				local = true;
+				return true;
+			}
+
+			auto& q = (lane == eMailboxChannel::CTRL) ? m_readyCtrlQ : m_readyNormalQ;
+			auto& ctok = (lane == eMailboxChannel::CTRL) ? *m_readyCtrlCtok : *m_readyNormalCtok;
+			if (q.try_dequeue(ctok, mailbox))
+			{
+				local = false;
+				return true;
+			}
+		}
 		return false;
 	}
 }
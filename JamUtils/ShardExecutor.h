@@ -5,24 +5,33 @@
 #include "NumaTopology.h"
 #include "ShardSlot.h"
 #include "ConcurrentQueueToken.h"
+#include "SystemScheduler.h"
+#include "CommandBuffer.h"
+#include "EventBus.h"
+#include "AutoTuner.h"
+#include "MailboxRegistry.h"
+#include "EntityMigrator.h"
+#include "SpscRing.h"
 
 
 namespace jam::utils::exec
 {
 	class GlobalExecutor; // fwd
+	struct ShardTable;
 
 
 	struct ShardLocal
 	{
 		entt::registry		world;
-		entt::dispatcher	events;	// for optimization hot-pass
+		EventBusSlot		events;		// typed per-shard event rings, drained after commands
 
 		// std::unordered_map<GroupId, std::vector<entt::entity>> groupIndex;
 
-		std::vector<std::function<void(entt::registry&)>> defers; // ݿ :    ۾
+		CommandBuffer		commands;	//지연 반영용 : 프레임 끝에 실행할 작업
 
-		using SystemFn = void(*)(ShardLocal&, uint64 now_ns, uint64 dt_ns);	//system runner
-		std::vector<SystemFn> systems;
+		SystemScheduler		systems;
+
+		EntityMigrator		migrator;	// components that follow a keyed entity to another shard
 	};
 
 
@@ -30,27 +39,36 @@ namespace jam::utils::exec
 	struct ShardExecutorConfig
 	{
 		int32		index = 0;
-		int32		batchBudget = 32;    // Mailbox 1ȸ ó
-		int32		idleSleepMs = 1;     //  
-		uint64		assistThreshold = 512; // Mailbox  Ӱġ
+		// initial values; live ones are in ShardTuning (GlobalExecutorConfig::autoTune)
+		int32		batchBudget = 32;    // Mailbox당 1회 처리량
+		int32		idleSleepMs = 1;     // 유휴 슬립
+		uint64		assistThreshold = 512; // Mailbox 길이 임계치
 
 		uint16		numaNode = 0xFFFF;	// opt
+
+		// jobs per (source shard -> this shard) ring, created on first use; 0: shard-to-shard
+		// submits share m_shardsQ with everyone else
+		uint32		meshRingCapacity = 256;
+
+		EventBusConfig	eventBus = {};		// ring sizes of the shard's event bus
 	};
 
 
 	struct GroupLocal
 	{
-		//  忡 á پִ ǵ Mailbox (Normal  )
+		// 이 샤드에 “로컬”로 붙어있는 세션들의 Mailbox (Normal 배송 대상)
 		std::vector<std::weak_ptr<Mailbox>> members;
+		uint64 homeKey = 0;		// GroupHomeKey, to re-mark the home when members move (0: unknown)
 	};
 
 	struct GroupHome
 	{
-		//  忡  ִ:  ε refcount (0̸ )
+		// 어떤 샤드에 멤버가 있는지: 샤드 인덱스별 refcount (0이면 없음)
 		std::vector<uint32> shard_refcnt;
-		// (ɼ) //׷ ť
+		// (옵션) 시퀀싱/백프레셔/그룹 큐
 		// std::shared_ptr<Mailbox> qNorm, qCtrl;
 		uint64 seq = 0;
+		uint64 homeKey = 0;		// GroupHomeKey: the table follows it on a resize (0: unknown, stays)
 	};
 
 
@@ -64,21 +82,41 @@ namespace jam::utils::exec
 		void                        Stop();
 		void                        Join();
 
-		void						AttachSlot(ShardSlot* slot) { m_shardSlot = slot; }
+		// publishes the shard's ingress mailbox (both lanes) in the directory slot
+		void						AttachSlot(ShardSlot* slot);
 
-		//  ο  (ɼ:   ۾)
+		// 샤드 내부용 주입 (옵션: 샤드 레벨 작업). from this shard's own thread: local queue, no atomics;
+		// from another shard's thread: that shard's SPSC ring to this one (FIFO per source either way)
 		void                        Submit(job::Job job);
 
-		// Mailbox 
-		std::shared_ptr<Mailbox>    CreateMailbox(eMailboxChannel channel = eMailboxChannel::NORMAL);
+		// Mailbox 관리 (any thread; a removed mailbox drains, then the shard thread recycles it)
+		// routeKey != 0: the mailbox follows its key to another shard on a resize
+		std::shared_ptr<Mailbox>    CreateMailbox(uint64 routeKey = 0);
 		void                        RemoveMailbox(uint32 id);
+		uint32                      GetMailboxCount() const { return m_mailboxes.GetLiveCount(); }
 
 		void BeginDrain();
-		// Global ȣϴ  Drain
+
+		// resize (GlobalExecutor::AddShard / RemoveShard), on this shard's thread: every keyed mailbox,
+		// entity and group table whose key no longer picks this shard in table is handed over, in order
+		void                        Rebalance(const ShardTable& table);
+		bool                        IsDrained() const;		// nothing queued: safe to stop after Rebalance
+		bool                        IsRunning() const { return m_running.load(std::memory_order_acquire); }
+		// Global이 호출하는 보조 Drain
 		void                        AssistDrainOnce(int32 maxMailboxes, int32 budgetPerMailbox);
 
-		// Mailbox 01   ȣ
-		void                        NotifyReady(Mailbox* mb);
+		// Mailbox가 0→1 전이 시 호출
+		void                        NotifyReady(Mailbox* mb, eMailboxChannel lane);
+		// same-shard post (Mailbox::Post on this shard's thread): plain local ready list
+		void                        NotifyLocalReady(Mailbox* mb, eMailboxChannel lane);
+		// NORMAL mailbox holding an escalating job: serviced from the CTRL lane once due_ns passes
+		void                        WatchEscalation(uint32 mailboxId, uint64 due_ns);
+
+		ShardTuning&                Tuning() { return m_tuning; }
+		ShardMetrics&               Metrics() { return m_metrics; }
+
+		uint64                      GetExpiredCount() const { return m_expiredJobs.load(std::memory_order_relaxed); }
+		uint64                      GetEscalatedCount() const { return m_escalations.load(std::memory_order_relaxed); }
 
 		int32                       GetIndex() const { return m_config.index; }
 
@@ -95,15 +133,15 @@ namespace jam::utils::exec
 
 
 		// Routing
-		// Ʒ ڵ鷯  忡 Ǵ Job  ȣ
-		void OnGroupLocalJoin(uint64 group_id, std::shared_ptr<Mailbox> mailbox);
+		// 아래 핸들러들은 “샤드 스레드에서” 실행되는 Job 으로 호출
+		void OnGroupLocalJoin(uint64 group_id, std::shared_ptr<Mailbox> mailbox, uint64 homeKey = 0);
 		void OnGroupLocalLeave(uint64 group_id, std::shared_ptr<Mailbox> mailbox);
-		void OnGroupHomeMark(uint64 group_id, uint32 shardIdx, int32 delta); // +1 or -1
+		void OnGroupHomeMark(uint64 group_id, uint32 shardIdx, int32 delta, uint64 homeKey = 0); // +1 or -1
 
-		void OnGroupMulticastHome(uint64 group_id, job::Job j);     // Ȩ 忡 
-		void OnGroupMulticastRemote(uint64 group_id, job::Job j);   //  忡 
+		void OnGroupMulticastHome(uint64 group_id, job::Job j);     // 홈 샤드에서 실행
+		void OnGroupMulticastRemote(uint64 group_id, job::Job j);   // 원격 샤드에서 실행
 
-		// ƿ:   
+		// 유틸: 로컬 멤버에게 배달
 		void DeliverToLocal(uint64 group_id, job::Job j);
 
 
@@ -115,42 +153,92 @@ namespace jam::utils::exec
 
 	private:
 		void                        Loop();
+		void                        DrainShardJobs();		// after Loop: shard jobs still queued run
 		bool                        ProcessReadyOnce();
-		void                        ProcessMailbox(Mailbox* mb, int32 budget);
+		bool                        ProcessLocalReady(Mailbox* mb);
+		// owned: this shard's thread, which also drains the mailbox's same-shard lanes
+		// readySince_ns: stamp of the ready entry being serviced (0: no wait sample)
+		void                        ProcessMailbox(Mailbox* mb, int32 budget, bool owned, uint64 readySince_ns);
 		void                        RequestAssistIfNeeded(Mailbox* mb);
 
-		bool						TryDequeueReady(OUT Mailbox*& mailbox);
+		bool						TryDequeueReady(OUT Mailbox*& mailbox, OUT bool& local);
+
+		// shard mesh
+		struct MeshLink;
+		void						EnqueueShared(job::Job&& job);
+		void						MeshSend(ShardExecutor& dst, job::Job&& job);		// this shard's thread
+		bool						PollMesh(int32 budgetPerRing);
+		void						EscalateDue(uint64 now_ns);
+
+		// resize
+		struct Handoff;
+		void						AcceptHandoff(Handoff& handoff);
+		bool						ForwardIfMoved(Mailbox* mb);
+
+		struct EscalationWatch
+		{
+			uint64		due_ns = 0;
+			uint32		mailboxId = 0;
+		};
 
 	private:
 		ShardExecutorConfig                                 m_config{};
-		std::weak_ptr<GlobalExecutor>                       m_owner;         // Assist û 
+		std::weak_ptr<GlobalExecutor>                       m_owner;         // Assist 요청 위해
 
 		Atomic<bool>                                        m_running{ false };
 		std::thread                                         m_thread;
 
-		// per-shard FiberScheduler (ť )
+		// per-shard FiberScheduler (큐와 독립)
 		thrd::WinFiberBackend								m_backend;
 		Uptr<thrd::FiberScheduler>                          m_scheduler;
 		void*                                               m_mainFiber = nullptr;
 
 
 		ShardSlot*											m_shardSlot = nullptr;
+		std::shared_ptr<Mailbox>							m_ingress;		// ShardEndpoint slot-mode posts
 
-		// shard ť (MPSC )
+		// shard 큐 (MPSC 패턴)
 		moodycamel::ConcurrentQueue<job::Job>               m_shardsQ;
 		Uptr<moodycamel::ConsumerToken>						m_shardsCtok;
-		// ready Mailbox  (MPSC, Mailbox 01   push)
+		// ready Mailbox 목록 (MPSC, Mailbox가 0→1 전이 시 push)
 		moodycamel::ConcurrentQueue<Mailbox*>               m_readyCtrlQ;
 		moodycamel::ConcurrentQueue<Mailbox*>				m_readyNormalQ;
 		Uptr<moodycamel::ConsumerToken>						m_readyCtrlCtok;
 		Uptr<moodycamel::ConsumerToken>						m_readyNormalCtok;
 
-		// Mailbox  ()
-		USE_LOCK
-		xmap<uint32, std::shared_ptr<Mailbox>>              m_mailboxes;
-		Atomic<uint32>                                      m_nextMailboxId{ 1 };
-
-		// Assist  û 
+		// same-shard fast path: only this shard's thread touches these
+		thrd::LocalQueue<job::Job>							m_localJobs;
+		thrd::LocalQueue<Mailbox*>							m_localReady[E2U(eMailboxChannel::COUNT)];
+		Atomic<bool>										m_localBusy{ false };		// published once per loop, for IsDrained
+
+		// shard mesh: outgoing rings by destination index (this thread), incoming ones polled round-robin
+		struct MeshOut
+		{
+			uint64				targetUid = 0;		// index reuse after RemoveShard/AddShard gets a new ring
+			Sptr<MeshLink>		link;
+			uint64				spillSent = 0;
+		};
+		const uint64										m_uid;
+		xvector<MeshOut>									m_meshOut;
+		xvector<Sptr<MeshLink>>								m_meshIn;
+		moodycamel::ConcurrentQueue<Sptr<MeshLink>>			m_meshJoinQ;		// rings a source just created
+		uint64												m_meshCursor = 0;
+		bool												m_meshPending = false;
+
+		// escalation watches: posted by any thread, kept in a min-heap by the shard thread
+		moodycamel::ConcurrentQueue<EscalationWatch>		m_escalateQ;
+		std::vector<EscalationWatch>						m_escalateHeap;
+		Atomic<uint64>										m_expiredJobs{ 0 };
+		Atomic<uint64>										m_escalations{ 0 };
+
+		// knobs and what the auto-tuner measures
+		ShardTuning											m_tuning;
+		ShardMetrics										m_metrics;
+
+		// Mailbox 관리 (수명)
+		MailboxRegistry										m_mailboxes;
+
+		// Assist 과도 요청 억제
 		Atomic<bool>                                        m_assistRequested{ false };
 
 		// Shard Pinning
@@ -158,9 +246,9 @@ namespace jam::utils::exec
 		utils::sys::CoreSlot								m_pinSlot = {};
 
 
-		// - ׷ (    )
+		// 샤드-로컬 그룹 상태(내 샤드의 로컬 멤버 목록)
 		std::unordered_map<uint64, GroupLocal>				m_groupLocal;
-		// Ȩ ( Ȩ ׷ /Ÿ)
+		// 홈 역할(내가 홈인 그룹들의 분포/메타)
 		std::unordered_map<uint64, GroupHome>				m_groupHome;
 
 		ShardLocal											m_local;
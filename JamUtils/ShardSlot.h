@@ -21,15 +21,15 @@ namespace jam::utils::exec
 
     struct QueueSlot
 	{
-        std::atomic<Mailbox*>   q{ nullptr };                       //  Խõ ť( nullptr)
-        std::atomic<uint32>     gen{ 0 };                              //  ī(ABA/ü )
-        std::atomic<uint8>      state{ E2U(eShardState::CLOSED) };         //  
+        std::atomic<Mailbox*>   q{ nullptr };                       // 현재 게시된 큐(없으면 nullptr)
+        std::atomic<uint32>     gen{ 0 };                              // 세대 카운터(ABA/교체 감지)
+        std::atomic<uint8>      state{ E2U(eShardState::CLOSED) };         // 운영 상태
     };
 
     struct ShardSlot
 	{
-        QueueSlot               ch[E2U(eMailboxChannel::COUNT)]; // äκ  (Normal/Ctrl)
+        QueueSlot               ch[E2U(eMailboxChannel::COUNT)]; // 채널별 슬롯 (Normal/Ctrl)
         uint32                  shardId = 0;
-        // ʿ padding/metrics ߰
+        // 필요시 padding/metrics 추가
     };
 }
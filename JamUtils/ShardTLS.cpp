@@ -7,14 +7,15 @@ namespace jam::utils::exec
 	thread_local ShardTLS::ThreadData ShardTLS::tl_threadData;
 
 
-	void ShardTLS::Bind(ShardLocal* L, std::thread::id tid)
+	void ShardTLS::Bind(ShardLocal* L, std::thread::id tid, ShardExecutor* executor)
 	{
 		if (!L)
 			throw std::invalid_argument("ShardLocal cannot be null");
-		if (!tl_threadData.bound)
+		if (tl_threadData.bound)
 			throw std::runtime_error("Thread already bound to a shard");
 
 		tl_threadData.local = L;
+		tl_threadData.executor = executor;
 		tl_threadData.expectedThreadId = tid;
 		tl_threadData.bound = true;
 
@@ -22,6 +23,7 @@ namespace jam::utils::exec
 		{
 			tl_threadData.bound = false;
 			tl_threadData.local = nullptr;
+			tl_threadData.executor = nullptr;
 			throw std::runtime_error("Thread ID mismatch during binding");
 		}
 	}
@@ -29,6 +31,7 @@ namespace jam::utils::exec
 	void ShardTLS::Unbind()
 	{
 		tl_threadData.local = nullptr;
+		tl_threadData.executor = nullptr;
 		tl_threadData.expectedThreadId = std::thread::id{};
 		tl_threadData.bound = false;
 	}
@@ -10,12 +10,15 @@ namespace jam::utils::exec
 	{
 	public:
 
-		static void				Bind(ShardLocal* L, std::thread::id tid);
+		static void				Bind(ShardLocal* L, std::thread::id tid, ShardExecutor* executor = nullptr);
 		static void				Unbind();
 
 		static ShardLocal*		GetCurrent();
 		static ShardLocal&		GetCurrentChecked();
 
+		// hot path (same-shard post detection): the shard running this thread, no thread-id check
+		static ShardExecutor*	GetExecutor() { return tl_threadData.executor; }
+
 		static bool				IsShardThread();
 
 		static std::thread::id	GetBoundThreadId();
@@ -29,6 +32,7 @@ namespace jam::utils::exec
 		struct ThreadData
 		{
 			ShardLocal*			local = nullptr;
+			ShardExecutor*		executor = nullptr;
 			std::thread::id		expectedThreadId{};
 			bool				bound = false;
 		};
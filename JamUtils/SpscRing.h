@@ -0,0 +1,73 @@
+#pragma once
+
+namespace jam::utils::thrd
+{
+	/*--------------
+		SpscRing
+	---------------*/
+
+	// Bounded single-producer / single-consumer ring. Each side owns one index and keeps a cached
+	// copy of the other's, so a push or pop touches a shared cache line only when the cache says
+	// full / empty. Capacity is rounded up to a power of two; slots are constructed up front.
+	template<typename T>
+	class SpscRing
+	{
+	public:
+		explicit SpscRing(uint32 capacity)
+		{
+			uint64 size = 1;
+			while (size < capacity)
+				size <<= 1;
+			m_mask = size - 1;
+			m_slots.resize(size);
+		}
+
+		SpscRing(const SpscRing&) = delete;
+		SpscRing& operator=(const SpscRing&) = delete;
+
+		// producer only; v is left untouched when full
+		bool TryPush(T&& v)
+		{
+			const uint64 tail = m_tail.load(std::memory_order_relaxed);
+			if (tail - m_cachedHead > m_mask)
+			{
+				m_cachedHead = m_head.load(std::memory_order_acquire);
+				if (tail - m_cachedHead > m_mask)
+					return false;
+			}
+
+			m_slots[tail & m_mask] = std::move(v);
+			m_tail.store(tail + 1, std::memory_order_release);
+			return true;
+		}
+
+		// consumer only
+		bool TryPop(OUT T& out)
+		{
+			const uint64 head = m_head.load(std::memory_order_relaxed);
+			if (head == m_cachedTail)
+			{
+				m_cachedTail = m_tail.load(std::memory_order_acquire);
+				if (head == m_cachedTail)
+					return false;
+			}
+
+			out = std::move(m_slots[head & m_mask]);
+			m_head.store(head + 1, std::memory_order_release);
+			return true;
+		}
+
+		// positions count every element ever pushed / popped
+		uint64		GetPushed() const { return m_tail.load(std::memory_order_acquire); }
+		uint64		GetPopped() const { return m_head.load(std::memory_order_acquire); }
+		bool		IsEmpty() const { return GetPopped() == GetPushed(); }
+
+	private:
+		alignas(64) Atomic<uint64>	m_tail{ 0 };		// producer
+		uint64						m_cachedHead = 0;
+		alignas(64) Atomic<uint64>	m_head{ 0 };		// consumer
+		uint64						m_cachedTail = 0;
+		alignas(64) uint64			m_mask = 0;
+		xvector<T>					m_slots;
+	};
+}
@@ -0,0 +1,137 @@
+#include "pch.h"
+#include "SystemScheduler.h"
+#include "GlobalExecutor.h"
+
+namespace jam::utils::exec
+{
+	namespace
+	{
+		// one parallel section; shared with helper jobs that may start after it is over
+		struct ParallelRegion
+		{
+			Atomic<uint32>				next = 0;
+			Atomic<uint32>				done = 0;
+			uint32						count = 0;
+			void						(*invoke)(void*, uint32) = nullptr;
+			void*						ctx = nullptr;
+
+			void Work()
+			{
+				uint32 index;
+				while ((index = next.fetch_add(1, std::memory_order_relaxed)) < count)
+				{
+					invoke(ctx, index);
+					done.fetch_add(1, std::memory_order_release);
+				}
+			}
+		};
+	}
+
+	SystemDesc& SystemScheduler::Add(SystemFn fn, const char* name)
+	{
+		m_dirty = true;
+
+		SystemDesc& desc = m_systems.emplace_back();
+		desc.fn = fn;
+		desc.name = name;
+		return desc;
+	}
+
+	bool SystemScheduler::Conflicts(const SystemDesc& a, const SystemDesc& b)
+	{
+		if (a.exclusive || b.exclusive)
+			return true;
+
+		auto intersects = [](const std::vector<entt::id_type>& x, const std::vector<entt::id_type>& y)
+			{
+				for (entt::id_type id : x)
+					if (std::find(y.begin(), y.end(), id) != y.end())
+						return true;
+				return false;
+			};
+
+		return intersects(a.writes, b.writes) || intersects(a.writes, b.reads) || intersects(a.reads, b.writes);
+	}
+
+	void SystemScheduler::Build()
+	{
+		// level = 1 + deepest earlier system it conflicts with
+		std::vector<uint32> level(m_systems.size(), 0);
+		uint32 maxLevel = 0;
+
+		for (size_t j = 0; j < m_systems.size(); ++j)
+		{
+			for (size_t i = 0; i < j; ++i)
+			{
+				if (Conflicts(m_systems[i], m_systems[j]))
+					level[j] = (std::max)(level[j], level[i] + 1);
+			}
+			maxLevel = (std::max)(maxLevel, level[j]);
+		}
+
+		m_levels.assign(m_systems.empty() ? 0 : maxLevel + 1, {});
+		for (size_t j = 0; j < m_systems.size(); ++j)
+			m_levels[level[j]].push_back(static_cast<uint32>(j));
+
+		m_dirty = false;
+	}
+
+	void SystemScheduler::Run(ShardLocal& L, uint64 now_ns, uint64 dt_ns, GlobalExecutor* helpers)
+	{
+		if (m_dirty)
+			Build();
+
+		m_helpers = helpers;
+
+		for (const std::vector<uint32>& systems : m_levels)
+		{
+			if (systems.size() == 1)
+			{
+				m_systems[systems[0]].fn(L, now_ns, dt_ns);
+				continue;
+			}
+
+			struct Ctx
+			{
+				SystemScheduler*			self;
+				const std::vector<uint32>*	systems;
+				ShardLocal*					L;
+				uint64						now_ns;
+				uint64						dt_ns;
+			} ctx{ this, &systems, &L, now_ns, dt_ns };
+
+			RunParallel(static_cast<uint32>(systems.size()), [](void* p, uint32 index)
+				{
+					Ctx& c = *static_cast<Ctx*>(p);
+					c.self->m_systems[(*c.systems)[index]].fn(*c.L, c.now_ns, c.dt_ns);
+				}, &ctx);
+		}
+
+		m_helpers = nullptr;
+	}
+
+	void SystemScheduler::RunParallel(uint32 count, InvokeFn invoke, void* ctx)
+	{
+		const uint32 helperCount = m_helpers ? (std::min)(count - 1, m_helpers->GetIoWorkerCount()) : 0;
+		if (helperCount == 0)
+		{
+			for (uint32 i = 0; i < count; ++i)
+				invoke(ctx, i);
+			return;
+		}
+
+		auto region = memory::MakeShared<ParallelRegion>();
+		region->count = count;
+		region->invoke = invoke;
+		region->ctx = ctx;
+
+		for (uint32 i = 0; i < helperCount; ++i)
+			m_helpers->Post(job::Job([region]() { region->Work(); }));
+
+		// the caller works too, so a busy IO pool only costs parallelism, never progress
+		region->Work();
+
+		while (region->done.load(std::memory_order_acquire) < count)
+			std::this_thread::yield();
+	}
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+namespace jam::utils::exec
+{
+	struct ShardLocal;
+	class GlobalExecutor;
+
+	using SystemFn = void(*)(ShardLocal&, uint64 now_ns, uint64 dt_ns);	//system runner
+
+	/*----------------
+		SystemDesc
+	-----------------*/
+
+	// A registered system and what it touches, as entt::type_hash ids.
+	// Components, and any other shared resource (the event bus, a ctx store), are declared the same way.
+	// A system that declares nothing is exclusive: it runs alone, in registration order.
+	struct SystemDesc
+	{
+		SystemFn					fn = nullptr;
+		const char*					name = "";
+		std::vector<entt::id_type>	reads;
+		std::vector<entt::id_type>	writes;
+		bool						exclusive = true;
+
+		template<typename... C>
+		SystemDesc& Reads()
+		{
+			(reads.push_back(entt::type_hash<C>::value()), ...);
+			exclusive = false;
+			return *this;
+		}
+
+		template<typename... C>
+		SystemDesc& Writes()
+		{
+			(writes.push_back(entt::type_hash<C>::value()), ...);
+			exclusive = false;
+			return *this;
+		}
+	};
+
+	/*---------------------
+		SystemScheduler
+	----------------------*/
+
+	// Builds a DAG from the declared access sets: a system depends on every earlier system it
+	// conflicts with (write/write, read/write). Each DAG level runs in parallel on the shard thread
+	// plus IO workers of the GlobalExecutor. No structural registry changes are allowed in a
+	// non-exclusive system (entt only tolerates concurrent access to distinct pools).
+	class SystemScheduler
+	{
+	public:
+		SystemDesc&				Add(SystemFn fn, const char* name);
+		void					Run(ShardLocal& L, uint64 now_ns, uint64 dt_ns, GlobalExecutor* helpers);
+
+		// splits [0, count) into grain-sized chunks: fn(begin, end), from inside a running system
+		template<typename F>
+		void					ParallelFor(size_t count, size_t grain, F&& fn);
+
+		size_t					Size() const { return m_systems.size(); }
+		uint32					GetLevelCount() const { return static_cast<uint32>(m_levels.size()); }
+
+	private:
+		using InvokeFn = void(*)(void* ctx, uint32 index);
+
+		void					Build();
+		static bool				Conflicts(const SystemDesc& a, const SystemDesc& b);
+		void					RunParallel(uint32 count, InvokeFn invoke, void* ctx);
+
+	private:
+		std::vector<SystemDesc>				m_systems;
+		std::vector<std::vector<uint32>>	m_levels;			// system indices per DAG level
+		bool								m_dirty = true;
+
+		GlobalExecutor*						m_helpers = nullptr;	// only during Run
+	};
+
+	template<typename F>
+	void SystemScheduler::ParallelFor(size_t count, size_t grain, F&& fn)
+	{
+		if (count == 0)
+			return;
+
+		grain = (std::max)(grain, size_t(1));
+
+		struct Ctx
+		{
+			std::remove_reference_t<F>*	fn;
+			size_t						count;
+			size_t						grain;
+		} ctx{ &fn, count, grain };
+
+		const uint32 chunks = static_cast<uint32>((count + grain - 1) / grain);
+		RunParallel(chunks, [](void* p, uint32 index)
+			{
+				Ctx& c = *static_cast<Ctx*>(p);
+				const size_t begin = static_cast<size_t>(index) * c.grain;
+				(*c.fn)(begin, (std::min)(begin + c.grain, c.count));
+			}, &ctx);
+	}
+}
@@ -0,0 +1,234 @@
+#include "pch.h"
+#include "ThreadCache.h"
+
+namespace jam::utils::memory
+{
+	thread_local ThreadCache*			ThreadCache::tl_cache = nullptr;
+	thread_local bool					ThreadCache::tl_exiting = false;
+	thread_local ThreadCache::Holder	ThreadCache::tl_holder;
+
+	// ownerId -> cache. Slots are written once (under s_registryLock) and never cleared,
+	// so a block's owner can be looked up without locking.
+	static ThreadCache*					s_caches[MAX_THREAD_CACHES] = {};
+	static uint16						s_nextId = 1;		// 0 = no owner
+	static std::vector<ThreadCache*>	s_parked;
+	static Mutex						s_registryLock;
+
+
+	static void FreeChain(MemoryHeader* chain)
+	{
+		while (chain)
+		{
+			MemoryHeader* memory = chain;
+			chain = chain->next;
+			MemoryManager::Instance().FreeBlock(memory);
+		}
+	}
+
+
+	ThreadCache::Holder::~Holder()
+	{
+		tl_exiting = true;
+		if (tl_cache)
+		{
+			Abandon(tl_cache);
+			tl_cache = nullptr;
+		}
+	}
+
+	ThreadCache* ThreadCache::Current()
+	{
+		if (tl_cache == nullptr && tl_exiting == false)
+		{
+			tl_cache = Acquire();
+			(void)&tl_holder;	// odr-use so the destructor runs at thread exit
+		}
+		return tl_cache;
+	}
+
+	void ThreadCache::ReleaseAll()
+	{
+		if (tl_cache)
+			tl_cache->Flush();
+
+		LockGuard guard(s_registryLock);
+		for (ThreadCache* cache : s_parked)
+			cache->Flush();
+	}
+
+	void ThreadCache::ForEach(const std::function<void(const ThreadCache&)>& fn)
+	{
+		LockGuard guard(s_registryLock);
+		for (uint16 id = 1; id < s_nextId; id++)
+			fn(*s_caches[id]);
+	}
+
+	MemoryHeader* ThreadCache::Alloc(int32 poolIndex)
+	{
+		Magazine& mag = m_magazines[poolIndex];
+		if (mag.head == nullptr)
+			Refill(poolIndex);
+
+		MemoryHeader* header = mag.head;
+		mag.head = header->next;
+		mag.count--;
+
+		header->next = nullptr;
+		ASSERT_CRASH(header->allocSize == 0);
+		return header;
+	}
+
+	void ThreadCache::Release(MemoryHeader* header, int32 poolIndex)
+	{
+		header->allocSize = 0;
+
+		const uint16 owner = header->ownerId;
+		if (owner != 0 && owner != m_id)
+		{
+			PushRemote(header, poolIndex);
+			return;
+		}
+
+		Magazine& mag = m_magazines[poolIndex];
+		header->next = mag.head;
+		mag.head = header;
+
+		if (++mag.count > MAGAZINE_CAPACITY)
+			Drain(poolIndex, MAGAZINE_BATCH);
+	}
+
+	void ThreadCache::Refill(int32 poolIndex)
+	{
+		// remote frees first: they are already ours and cost no pool traffic
+		CollectRemote(poolIndex);
+
+		Magazine& mag = m_magazines[poolIndex];
+		if (mag.head)
+			return;
+
+		MemoryPool* pool = MemoryManager::Instance().GetPool(poolIndex);
+
+		int32 count = 0;
+		if (MemoryHeader* chain = pool->PopBatch(OUT count))
+		{
+			mag.head = chain;
+			mag.count = count;
+			return;
+		}
+
+		mag.head = pool->Pop();
+		mag.head->next = nullptr;
+		mag.count = 1;
+	}
+
+	void ThreadCache::Drain(int32 poolIndex, int32 count)
+	{
+		Magazine& mag = m_magazines[poolIndex];
+		if (count <= 0 || mag.head == nullptr)
+			return;
+
+		MemoryHeader* first = mag.head;
+		MemoryHeader* last = first;
+		for (int32 i = 1; i < count; i++)
+			last = last->next;
+
+		mag.head = last->next;
+		mag.count -= count;
+
+		if (MemoryPool* pool = MemoryManager::Instance().GetPool(poolIndex))
+		{
+			pool->PushBatch(first, last, count);
+		}
+		else
+		{
+			// pools are gone (after Shutdown)
+			last->next = nullptr;
+			FreeChain(first);
+		}
+	}
+
+	void ThreadCache::CollectRemote(int32 poolIndex)
+	{
+		MemoryHeader* chain = m_remoteFree[poolIndex].exchange(nullptr, std::memory_order_acquire);
+		if (chain == nullptr)
+			return;
+
+		int32 count = 1;
+		MemoryHeader* last = chain;
+		while (last->next)
+		{
+			last = last->next;
+			count++;
+		}
+
+		Magazine& mag = m_magazines[poolIndex];
+		last->next = mag.head;
+		mag.head = chain;
+		mag.count += count;
+
+		while (mag.count > MAGAZINE_CAPACITY)
+			Drain(poolIndex, MAGAZINE_BATCH);
+	}
+
+	void ThreadCache::Flush()
+	{
+		for (int32 i = 0; i < POOL_COUNT; i++)
+		{
+			CollectRemote(i);
+			while (m_magazines[i].count > 0)
+				Drain(i, (std::min)(m_magazines[i].count, MAGAZINE_BATCH));
+		}
+	}
+
+	void ThreadCache::PushRemote(MemoryHeader* header, int32 poolIndex)
+	{
+		ThreadCache* owner = s_caches[header->ownerId];
+		if (owner == nullptr || owner->m_active.load(std::memory_order_acquire) == false)
+		{
+			// nobody will collect it soon: straight back to the pool
+			if (MemoryPool* pool = MemoryManager::Instance().GetPool(poolIndex))
+				pool->Push(header);
+			else
+				MemoryManager::Instance().FreeBlock(header);
+			return;
+		}
+
+		Atomic<MemoryHeader*>& list = owner->m_remoteFree[poolIndex];
+		MemoryHeader* head = list.load(std::memory_order_relaxed);
+		do
+		{
+			header->next = head;
+		} while (list.compare_exchange_weak(head, header, std::memory_order_release, std::memory_order_relaxed) == false);
+	}
+
+	ThreadCache* ThreadCache::Acquire()
+	{
+		LockGuard guard(s_registryLock);
+
+		ThreadCache* cache = nullptr;
+		if (s_parked.empty() == false)
+		{
+			cache = s_parked.back();
+			s_parked.pop_back();
+		}
+		else
+		{
+			ASSERT_CRASH(s_nextId < MAX_THREAD_CACHES);
+			cache = new ThreadCache(s_nextId);
+			s_caches[s_nextId++] = cache;
+		}
+
+		cache->m_active.store(true, std::memory_order_release);
+		return cache;
+	}
+
+	void ThreadCache::Abandon(ThreadCache* cache)
+	{
+		// stop remote pushes first, then hand everything back to the pools
+		cache->m_active.store(false, std::memory_order_release);
+		cache->Flush();
+
+		LockGuard guard(s_registryLock);
+		s_parked.push_back(cache);
+	}
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include "MemoryManager.h"
+#include "MemoryPool.h"
+
+namespace jam::utils::memory
+{
+	inline constexpr int32 MAGAZINE_BATCH = 32;						// refill / drain unit
+	inline constexpr int32 MAGAZINE_CAPACITY = MAGAZINE_BATCH * 2;
+	inline constexpr int32 MAX_THREAD_CACHES = 1024;				// MemoryHeader::ownerId range
+
+	/*-----------------
+		Magazine
+	------------------*/
+
+	struct Magazine
+	{
+		MemoryHeader*	head = nullptr;		// linked through MemoryHeader::next
+		int32			count = 0;
+	};
+
+	/*-----------------
+		ThreadCache
+	------------------*/
+
+	// Per-thread front end of MemoryManager.
+	// - Alloc/Release hit only the local magazine of the size class.
+	// - Magazines refill from / drain to MemoryPool in MAGAZINE_BATCH chains (one CAS each).
+	// - A block freed by a thread other than its owner goes to the owner's remote-free list,
+	//   which the owner collects in bulk (one exchange) before touching the pool.
+	// Caches outlive their threads: on thread exit a cache is flushed and parked,
+	// and the next new thread adopts it (including any remote frees that arrived late).
+	class ThreadCache
+	{
+	public:
+		static ThreadCache*		Current();		// nullptr while the thread is exiting
+		static void				ReleaseAll();
+		static void				ForEach(const std::function<void(const ThreadCache&)>& fn);
+
+		MemoryHeader*			Alloc(int32 poolIndex);
+		void					Release(MemoryHeader* header, int32 poolIndex);
+
+		uint16					GetId() const { return m_id; }
+		MemoryCounters&			GetCounters() { return m_counters; }
+		const MemoryCounters&	GetCounters() const { return m_counters; }
+
+	private:
+		explicit ThreadCache(uint16 id) : m_id(id) {}
+
+		void					Refill(int32 poolIndex);
+		void					Drain(int32 poolIndex, int32 count);
+		void					CollectRemote(int32 poolIndex);
+		void					Flush();
+
+		static void				PushRemote(MemoryHeader* header, int32 poolIndex);
+		static ThreadCache*		Acquire();
+		static void				Abandon(ThreadCache* cache);
+
+		struct Holder
+		{
+			~Holder();
+		};
+
+	private:
+		uint16					m_id = 0;
+		Atomic<bool>			m_active{ false };
+		Magazine				m_magazines[POOL_COUNT];
+		Atomic<MemoryHeader*>	m_remoteFree[POOL_COUNT] = {};
+		MemoryCounters			m_counters;
+
+		static thread_local ThreadCache*	tl_cache;
+		static thread_local bool			tl_exiting;
+		static thread_local Holder			tl_holder;
+	};
+}
@@ -22,11 +22,11 @@
 //		{
 //			DoBaseJob();
 //
-//			DoJobs(); // JobQueue Fiber 
+//			DoJobs(); // JobQueue에서 Fiber 등록
 //
 //			while (auto fiberOpt = m_scheduler->NextFiber())
 //			{
-//				fiberOpt.value()->SwitchTo(); // Fiber 
+//				fiberOpt.value()->SwitchTo(); // Fiber 실행
 //			}
 //
 //			AdjustSleepInterval();